@@ -0,0 +1,75 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include "../Engine/Particles/ParticleSystem.hpp"
+#include "../Engine/System/Random.hpp"
+
+/// @brief Time spent on each part of the frame, summed over all frames
+struct BenchmarkResult
+{
+    double updateMilliseconds;
+    double buildMilliseconds;
+    double worstFrameMilliseconds;
+    size_t particleCount;
+};
+
+static BenchmarkResult runBenchmark(size_t particleCount, size_t frameCount, float frameTime)
+{
+    // every particle lives for a second, so the emitter settles at the requested amount of particles
+    // no sprite, so the benchmark does not depend on loaded assets and measures the plain square path
+    Engine::ParticleSettings settings{
+        .sprite = "",
+        .animation = "",
+        .maxParticles = particleCount,
+        .rate = (float)particleCount,
+        .minLifetime = 1.f,
+        .maxLifetime = 1.f,
+        .minSpeed = 40.f,
+        .maxSpeed = 120.f,
+        .direction = -90.f,
+        .spread = 60.f,
+        .gravity = sf::Vector2f(0.f, 200.f),
+        .drag = 0.5f,
+        .startSize = 6.f,
+        .endSize = 1.f,
+        .startColor = sf::Color(255, 200, 50),
+        .endColor = sf::Color(255, 50, 0, 0)};
+    Engine::ParticleSystem particles(settings);
+    sf::FloatRect area(sf::Vector2f(400.f, 300.f), sf::Vector2f(50.f, 10.f));
+    std::vector<sf::IntRect> frames{sf::IntRect(sf::Vector2i(0, 0), sf::Vector2i(8, 8)), sf::IntRect(sf::Vector2i(8, 0), sf::Vector2i(8, 8))};
+    sf::VertexArray vertices;
+    particles.setEmitting(true);
+    particles.burst(particleCount, area);
+    BenchmarkResult result{};
+    for (size_t i = 0; i < frameCount; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        particles.update(frameTime, area);
+        auto updated = std::chrono::steady_clock::now();
+        particles.buildVertices(vertices, frames);
+        auto built = std::chrono::steady_clock::now();
+        result.updateMilliseconds += std::chrono::duration<double, std::milli>(updated - start).count();
+        result.buildMilliseconds += std::chrono::duration<double, std::milli>(built - updated).count();
+        result.worstFrameMilliseconds = std::max(result.worstFrameMilliseconds, std::chrono::duration<double, std::milli>(built - start).count());
+    }
+    result.particleCount = particles.getCount();
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    size_t particleCount = argc > 1 ? std::stoul(argv[1]) : 50000;
+    size_t frameCount = argc > 2 ? std::stoul(argv[2]) : 1440;
+    float frameTime = 1.f / 144.f;
+    std::cout << "Simulating " << particleCount << " particles for " << frameCount << " frames" << std::endl;
+
+    Engine::Random::getInstance().seed(0);
+    BenchmarkResult result = runBenchmark(particleCount, frameCount, frameTime);
+    double average = (result.updateMilliseconds + result.buildMilliseconds) / (double)frameCount;
+    std::cout << "Average update: " << result.updateMilliseconds / (double)frameCount << " ms" << std::endl;
+    std::cout << "Average vertex build: " << result.buildMilliseconds / (double)frameCount << " ms" << std::endl;
+    std::cout << "Worst frame: " << result.worstFrameMilliseconds << " ms" << std::endl;
+    std::cout << "Particles at the end: " << result.particleCount << std::endl;
+    std::cout << "Frame budget used: " << average / (frameTime * 1000.0) * 100.0 << "%" << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include "../Engine/Physics/PhysicsWorld.hpp"
+
+/// @brief Result of a single benchmark run
+struct BenchmarkResult
+{
+    double totalMilliseconds;
+    double worstStepMilliseconds;
+    size_t awakeBodies;
+    size_t contacts;
+    /// @brief Hash of the final body positions, equal hashes mean both runs produced exactly the same simulation
+    uint64_t checksum;
+};
+
+/// @brief Fill the world with a floor, two walls and a grid of falling bodies of all shape types
+static void createScene(Engine::PhysicsWorld &world, size_t bodyCount)
+{
+    constexpr size_t columns = 50;
+    constexpr float spacing = 24.f;
+    float width = columns * spacing + 200.f;
+    world.setGravity(sf::Vector2f(0.f, 500.f));
+    world.createBody(Engine::BodyDefinition{.type = Engine::BodyType::Static, .shape = Engine::PhysicsShape::createBox(sf::Vector2f(width / 2.f, 20.f)), .position = sf::Vector2f(width / 2.f, 0.f)});
+    world.createBody(Engine::BodyDefinition{.type = Engine::BodyType::Static, .shape = Engine::PhysicsShape::createBox(sf::Vector2f(20.f, 4000.f)), .position = sf::Vector2f(0.f, -4000.f)});
+    world.createBody(Engine::BodyDefinition{.type = Engine::BodyType::Static, .shape = Engine::PhysicsShape::createBox(sf::Vector2f(20.f, 4000.f)), .position = sf::Vector2f(width, -4000.f)});
+
+    Engine::PhysicsShape triangle = Engine::PhysicsShape::createPolygon({{-9.f, 8.f}, {9.f, 8.f}, {0.f, -9.f}}).value();
+    for (size_t i = 0; i < bodyCount; i++)
+    {
+        sf::Vector2f position(100.f + (float)(i % columns) * spacing + (float)((i / columns) % 2) * spacing * 0.5f, -40.f - (float)(i / columns) * spacing);
+        Engine::BodyDefinition definition{.position = position, .friction = 0.4f, .restitution = 0.1f};
+        switch (i % 3)
+        {
+        case 0:
+            definition.shape = Engine::PhysicsShape::createCircle(9.f);
+            break;
+        case 1:
+            definition.shape = Engine::PhysicsShape::createBox(sf::Vector2f(9.f, 9.f));
+            break;
+        default:
+            definition.shape = triangle;
+            break;
+        }
+        world.createBody(definition);
+    }
+}
+
+static BenchmarkResult runBenchmark(size_t bodyCount, size_t stepCount)
+{
+    Engine::PhysicsWorld world;
+    createScene(world, bodyCount);
+    BenchmarkResult result{};
+    for (size_t i = 0; i < stepCount; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        world.runStep();
+        double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result.totalMilliseconds += time;
+        result.worstStepMilliseconds = std::max(result.worstStepMilliseconds, time);
+    }
+    result.awakeBodies = world.getAwakeBodyCount();
+    result.contacts = world.getContactCount();
+    // FNV-1a over raw position bits, any difference in rounding shows up in the hash
+    result.checksum = 14695981039346656037ull;
+    for (uint32_t id = 0; id < world.getBodyCount(); id++)
+    {
+        sf::Vector2f position = world.getPosition(id);
+        uint32_t bits[2];
+        std::memcpy(bits, &position.x, sizeof(float));
+        std::memcpy(bits + 1, &position.y, sizeof(float));
+        for (uint32_t b : bits)
+        {
+            result.checksum = (result.checksum ^ b) * 1099511628211ull;
+        }
+    }
+    return result;
+}
+
+/// @brief Compare checksum with the one stored in the file by an earlier run, or store it if there is no such file.
+/// Unlike the repeated run this also catches differences caused by state shared within the process and lets builds with different flags be compared
+/// @return False if stored checksum is different
+static bool checkStoredChecksum(std::string const &path, uint64_t checksum)
+{
+    if (std::ifstream in(path); in.is_open())
+    {
+        uint64_t stored = 0;
+        in >> std::hex >> stored;
+        if (stored != checksum)
+        {
+            std::cout << "Simulation is not deterministic, earlier run stored checksum " << std::hex << stored << std::dec << std::endl;
+            return false;
+        }
+        std::cout << "Checksum matched the one stored in '" << path << "'" << std::endl;
+        return true;
+    }
+    std::ofstream out(path);
+    out << std::hex << checksum << std::endl;
+    std::cout << "Checksum stored in '" << path << "', run again to check determinism" << std::endl;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    size_t bodyCount = argc > 1 ? std::stoul(argv[1]) : 3000;
+    size_t stepCount = argc > 2 ? std::stoul(argv[2]) : 600;
+    std::cout << "Simulating " << bodyCount << " bodies for " << stepCount << " steps" << std::endl;
+
+    BenchmarkResult result = runBenchmark(bodyCount, stepCount);
+    BenchmarkResult repeat = runBenchmark(bodyCount, stepCount);
+    std::cout << "Average step: " << result.totalMilliseconds / (double)stepCount << " ms" << std::endl;
+    std::cout << "Worst step: " << result.worstStepMilliseconds << " ms" << std::endl;
+    std::cout << "Awake bodies at the end: " << result.awakeBodies << std::endl;
+    std::cout << "Contacts at the end: " << result.contacts << std::endl;
+    std::cout << "Checksum: " << std::hex << result.checksum << std::dec << std::endl;
+    if (repeat.checksum != result.checksum)
+    {
+        std::cout << "Simulation is not deterministic, second run produced checksum " << std::hex << repeat.checksum << std::dec << std::endl;
+        return 1;
+    }
+    std::cout << "Second run matched the first one" << std::endl;
+    if (argc > 3 && !checkStoredChecksum(argv[3], result.checksum))
+    {
+        return 1;
+    }
+    return 0;
+}
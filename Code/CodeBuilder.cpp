@@ -1,5 +1,7 @@
 #include "CodeBuilder.hpp"
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include "../Engine/Execution/Instructions.hpp"
 #include "Error.hpp"
 Code::CodeBuilder::CodeBuilder()
@@ -82,6 +84,8 @@ bool Code::CodeBuilder::addTypeDeclarationLocation(std::string const &name, Debu
 
 void Code::CodeBlock::insert(std::vector<uint8_t> const &bytes)
 {
+    // every instruction is inserted with a single call, jumps only add their reserved distance afterwards
+    m_instructionStarts.push_back(m_bytes.size());
     m_bytes.insert(m_bytes.end(), bytes.begin(), bytes.end());
 }
 
@@ -149,3 +153,127 @@ void Code::CodeBlock::addLabelDestination(std::string const &labelname, size_t j
     }
     m_jumpLabelDestinations[labelname].push_back(CodeJumpInfo{.byteCodeDestination = jumpAddressBytesPosition, .column = codeColumn, .row = codeRow});
 }
+
+/// @brief Read operand of an instruction written by `parseToBytes`
+template <typename T>
+static T readOperand(std::vector<uint8_t> const &bytes, size_t pos)
+{
+    uint64_t res = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        res = (res << 8) | bytes[pos + i];
+    }
+    return std::bit_cast<T>(res);
+}
+
+void Code::CodeBlock::markLastVariableUses()
+{
+    using Engine::Instructions;
+    size_t count = m_instructionStarts.size();
+    // only declared variables are tracked, variables referenced by raw ids past them are always loaded normally
+    size_t variableCount = m_variables.size();
+    if (variableCount == 0 || count == 0)
+    {
+        return;
+    }
+    auto getTrackedVariable = [&](size_t i, Instructions op) -> std::optional<size_t>
+    {
+        size_t start = m_instructionStarts[i];
+        if ((Instructions)m_bytes[start] != op)
+        {
+            return {};
+        }
+        if (size_t id = readOperand<size_t>(m_bytes, start + 1); id < variableCount)
+        {
+            return id;
+        }
+        return {};
+    };
+
+    std::vector<std::vector<size_t>> successors(count);
+    std::vector<std::vector<size_t>> predecessors(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t start = m_instructionStarts[i];
+        Instructions op = (Instructions)m_bytes[start];
+        if (op == Instructions::JumpBy || op == Instructions::JumpByIf)
+        {
+            // distance is counted from the operand, jumps to the very end of the code leave the function
+            size_t target = start + 1 + readOperand<Engine::JumpDistanceType>(m_bytes, start + 1);
+            if (auto it = std::lower_bound(m_instructionStarts.begin(), m_instructionStarts.end(), target); it != m_instructionStarts.end() && *it == target)
+            {
+                successors[i].push_back(it - m_instructionStarts.begin());
+            }
+        }
+        bool fallsThrough = op != Instructions::JumpBy && op != Instructions::Return && op != Instructions::ExitFunction;
+        if (fallsThrough && i + 1 < count)
+        {
+            successors[i].push_back(i + 1);
+        }
+        for (size_t next : successors[i])
+        {
+            predecessors[next].push_back(i);
+        }
+    }
+
+    // backwards liveness, only instructions whose successors changed are visited again
+    std::vector<std::vector<bool>> liveIn(count, std::vector<bool>(variableCount, false));
+    std::vector<size_t> worklist(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        worklist[i] = i;
+    }
+    std::vector<bool> queued(count, true);
+    std::vector<bool> live(variableCount);
+    while (!worklist.empty())
+    {
+        size_t i = worklist.back();
+        worklist.pop_back();
+        queued[i] = false;
+        std::fill(live.begin(), live.end(), false);
+        for (size_t next : successors[i])
+        {
+            for (size_t v = 0; v < variableCount; v++)
+            {
+                live[v] = live[v] || liveIn[next][v];
+            }
+        }
+        if (std::optional<size_t> id = getTrackedVariable(i, Instructions::GetLocal); id.has_value())
+        {
+            live[id.value()] = true;
+        }
+        else if (std::optional<size_t> id = getTrackedVariable(i, Instructions::SetLocal); id.has_value())
+        {
+            live[id.value()] = false;
+        }
+        if (live == liveIn[i])
+        {
+            continue;
+        }
+        liveIn[i] = live;
+        for (size_t prev : predecessors[i])
+        {
+            if (!queued[prev])
+            {
+                queued[prev] = true;
+                worklist.push_back(prev);
+            }
+        }
+    }
+
+    // move has the same operand as the load, so no offsets or jump distances change
+    for (size_t i = 0; i < count; i++)
+    {
+        std::optional<size_t> id = getTrackedVariable(i, Instructions::GetLocal);
+        if (!id.has_value())
+        {
+            continue;
+        }
+        bool readLater = std::any_of(successors[i].begin(), successors[i].end(), [&](size_t next)
+                                     { return liveIn[next][id.value()]; });
+        if (!readLater)
+        {
+            m_bytes[m_instructionStarts[i]] = (uint8_t)Instructions::MoveLocal;
+        }
+    }
+}
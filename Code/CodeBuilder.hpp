@@ -63,11 +63,24 @@ namespace Code
 
         void addLabelDestination(std::string const &labelname, size_t jumpAddressBytesPosition, size_t codeColumn, size_t codeRow);
 
+        /// @brief Replace loads of local variables that are never read again with moves, which let the store that consumes the value take over
+        /// the reference held by the variable instead of retaining the value again. Must be called after `applyLabels`
+        void markLastVariableUses();
+
+        /// @brief Reserve a new field slot cache for an instruction of this block
+        /// @return Index of the cache
+        size_t addFieldSlotCache() { return m_fieldSlotCacheCount++; }
+
+        size_t getFieldSlotCacheCount() const { return m_fieldSlotCacheCount; }
+
     private:
         std::map<std::string, std::vector<CodeJumpInfo>> m_jumpLabelDestinations;
         std::map<std::string, size_t> m_jumpLabelLocations;
         std::vector<uint8_t> m_bytes;
         std::vector<std::string> m_variables;
+        /// @brief Position of the first byte of every inserted instruction, used to walk the bytecode without knowing operand sizes
+        std::vector<size_t> m_instructionStarts;
+        size_t m_fieldSlotCacheCount = 0;
     };
 
     class CodeBuilder
@@ -2,6 +2,7 @@
 #include "Error.hpp"
 #include "../Engine/TypeManager.hpp"
 #include "../Engine/Content/ContentManager.hpp"
+#include <algorithm>
 Code::Fusion::FusionCodeGenerator::FusionCodeGenerator(std::vector<std::unique_ptr<Token>> tokens, std::string const &filename)
     : m_tokens(std::move(tokens)), m_it(m_tokens.begin()), m_filename(filename)
 {
@@ -10,12 +11,16 @@ Code::Fusion::FusionCodeGenerator::FusionCodeGenerator(std::vector<std::unique_p
 void Code::Fusion::FusionCodeGenerator::generate()
 {
     consumeEndOfStatement();
-    while (isKeyword(Keyword::Type) || isKeyword(Keyword::Function))
+    while (isKeyword(Keyword::Type) || isKeyword(Keyword::Struct) || isKeyword(Keyword::Function))
     {
         if (isKeyword(Keyword::Type))
         {
             parseTypeDeclaration();
         }
+        else if (isKeyword(Keyword::Struct))
+        {
+            parseStructDeclaration();
+        }
         else if (isKeyword(Keyword::Function))
         {
             auto f = parseFunctionDeclaration("Scene");
@@ -79,6 +84,7 @@ void Code::Fusion::FusionCodeGenerator::parseTypeDeclaration()
         if (isKeyword(Keyword::Const))
         {
             isConst = true;
+            advance();
         }
         IdToken const *fieldTok = getTokenOrError<IdToken>("Expected field name");
         advance();
@@ -131,9 +137,56 @@ void Code::Fusion::FusionCodeGenerator::parseTypeDeclaration()
                                                       methods, {},
                                                       m_builder.popStringBlock());
     }
-    catch (Engine::TypeError e)
+    catch (Engine::TypeError const &e)
     {
-        throw Errors::ParsingError(name->getRow(), name->getColumn(), "Type with name '" + name->getId() + "' already exists");
+        throw Errors::ParsingError(name->getRow(), name->getColumn(), e.what());
+    }
+}
+
+void Code::Fusion::FusionCodeGenerator::parseStructDeclaration()
+{
+    using namespace Engine::Runnable;
+    consumeKeyword(Keyword::Struct, "Expected 'struct'");
+    IdToken const *name = getTokenOrError<IdToken>("expected struct name");
+    if (!m_builder.addTypeDeclarationLocation(name->getId(), Debug::DebugInfoSourceData{.row = name->getRow(), .column = name->getColumn()}))
+    {
+        error("Type with name '" + name->getId() + "' already exists");
+    }
+    advance();
+    consumeSeparator(Separator::BlockOpen, "expected '{'");
+    consumeEndOfStatement();
+    std::vector<std::string> fieldNames;
+    std::vector<CodeConstantValue> defaults;
+    m_builder.createStringBlock();
+    while (isOfType<IdToken>())
+    {
+        IdToken const *fieldTok = getTokenOrError<IdToken>("Expected field name");
+        if (std::find(fieldNames.begin(), fieldNames.end(), fieldTok->getId()) != fieldNames.end())
+        {
+            error("Field with name '" + fieldTok->getId() + "' already exists in struct '" + name->getId() + "'");
+        }
+        advance();
+        consumeSeparator(Separator::Equals, "Expected '='");
+        defaults.push_back(parseConstant("Expected value"));
+        fieldNames.push_back(fieldTok->getId());
+        advance();
+        consumeEndOfStatement();
+    }
+    consumeSeparator(Separator::BlockClose, "expected '}'");
+
+    // same logic as with types, struct declared by the same file is assumed to be a recompilation
+    if (std::optional<std::string> filename = Engine::TypeManager::getInstance().getTypeDeclarationFileName(name->getId()); filename.has_value() && filename.value() == m_filename)
+    {
+        m_builder.popStringBlock();
+        return;
+    }
+    try
+    {
+        Engine::TypeManager::getInstance().createStructType(name->getId(), m_filename, fieldNames, defaults, m_builder.popStringBlock());
+    }
+    catch (Engine::TypeError const &e)
+    {
+        throw Errors::ParsingError(name->getRow(), name->getColumn(), e.what());
     }
 }
 
@@ -286,9 +339,11 @@ std::pair<std::string, Engine::Runnable::RunnableFunction> Code::Fusion::FusionC
 
     consumeSeparator(Separator::BlockClose, "expected '}'");
     m_builder.getCurrentBlock().applyLabels();
+    m_builder.getCurrentBlock().markLastVariableUses();
     std::vector<uint8_t> temp = m_builder.getCurrentBlock().getBytes();
+    size_t fieldSlotCacheCount = m_builder.getCurrentBlock().getFieldSlotCacheCount();
     m_builder.popBlock();
-    return std::make_pair(name->getId(), Engine::Runnable::RunnableFunction{.argumentCount = argumentNames.size(), .bytes = std::move(temp)});
+    return std::make_pair(name->getId(), Engine::Runnable::RunnableFunction{.argumentCount = argumentNames.size(), .bytes = std::move(temp), .fieldSlotCaches = std::vector<Engine::Runnable::FieldSlotCache>(fieldSlotCacheCount)});
 }
 
 void Code::Fusion::FusionCodeGenerator::parseInstruction(FusionInstruction instruction, Debug::FunctionDebugInfo &debugInfo)
@@ -352,6 +407,19 @@ void Code::Fusion::FusionCodeGenerator::parseInstruction(FusionInstruction instr
             }
         }
         break;
+        case InstructionArgumentType::StructType:
+        {
+            if (Engine::TypeManager::getInstance().doesStructTypeWithNameExist(getTokenOrError<IdToken>("Expected struct name")->getId()))
+            {
+                std::vector<uint8_t> b = parseToBytes(m_builder.getOrAddStringId(getTokenOrError<IdToken>("Expected struct name")->getId()));
+                bytes.insert(bytes.end(), b.begin(), b.end());
+            }
+            else
+            {
+                error("Unknown struct '" + getTokenOrError<IdToken>("Expected struct name")->getId() + "'");
+            }
+        }
+        break;
         case InstructionArgumentType::FunctionName:
         {
             size_t id = m_builder.getOrAddStringId(getTokenOrError<IdToken>("Expected function name")->getId());
@@ -410,6 +478,12 @@ void Code::Fusion::FusionCodeGenerator::parseInstruction(FusionInstruction instr
         optionallyConsumeSeparator(Separator::Comma);
     }
     consumeEndOfStatementOrError("expected new line or ';'");
+    // field instructions carry index of their own slot cache after the written arguments
+    if (data->instruction == Engine::Instructions::GetField || data->instruction == Engine::Instructions::SetField || data->instruction == Engine::Instructions::HasField)
+    {
+        std::vector<uint8_t> b = parseToBytes(m_builder.getCurrentBlock().addFieldSlotCache());
+        bytes.insert(bytes.end(), b.begin(), b.end());
+    }
     debugInfo.addByteRangeFromPrevious(bytes.size(), row, column);
     m_builder.getCurrentBlock().insert(bytes);
 }
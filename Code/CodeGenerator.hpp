@@ -50,6 +50,9 @@ namespace Code::Fusion
 
         void parseTypeDeclaration();
 
+        /// @brief Parse struct declaration and register it in the type manager
+        void parseStructDeclaration();
+
         /// @brief Parse function declaration and return name and byte info info
         /// @param typeId Id of the type that the function belongs to. Used only for generating debug info. -1 if it belongs to "scene" type
         /// @return Tuple containing function name and runnable info
@@ -49,6 +49,19 @@ namespace Code
         GetSize,
         SetSize,
         AreOverlapping,
+        GetOverlapping,
+        GetOverlappingOfType,
+        QueryRect,
+        Raycast,
+        RaycastOfType,
+        SegmentCast,
+        ObjectsAtPoint,
+        SetVelocity,
+        GetVelocity,
+        SetAcceleration,
+        GetAcceleration,
+        SetDrag,
+        GetDrag,
         CreateLabel,
         ToString,
         ToInt,
@@ -63,6 +76,9 @@ namespace Code
         CreateArray,
         GetItem,
         SetItem,
+        AppendInPlace,
+        ExtendInPlace,
+        CreateStruct,
     };
 
     enum class Keyword
@@ -72,6 +88,7 @@ namespace Code
         Type,
         Of,
         Const,
+        Struct,
     };
 
     enum class Separator
@@ -90,7 +107,8 @@ namespace Code
         {"func", Keyword::Function},
         {"type", Keyword::Type},
         {"of", Keyword::Of},
-        {"const", Keyword::Const}};
+        {"const", Keyword::Const},
+        {"struct", Keyword::Struct}};
 
     static const std::unordered_map<std::string, FusionInstruction> FusionInstructions = {
         {"create_instance", FusionInstruction::CreateInstance},
@@ -132,6 +150,19 @@ namespace Code
         {"get_size", FusionInstruction::GetSize},
         {"set_size", FusionInstruction::SetSize},
         {"are_overlapping", FusionInstruction::AreOverlapping},
+        {"get_overlapping", FusionInstruction::GetOverlapping},
+        {"get_overlapping_of_type", FusionInstruction::GetOverlappingOfType},
+        {"query_rect", FusionInstruction::QueryRect},
+        {"raycast", FusionInstruction::Raycast},
+        {"raycast_of_type", FusionInstruction::RaycastOfType},
+        {"segment_cast", FusionInstruction::SegmentCast},
+        {"objects_at_point", FusionInstruction::ObjectsAtPoint},
+        {"set_velocity", FusionInstruction::SetVelocity},
+        {"get_velocity", FusionInstruction::GetVelocity},
+        {"set_acceleration", FusionInstruction::SetAcceleration},
+        {"get_acceleration", FusionInstruction::GetAcceleration},
+        {"set_drag", FusionInstruction::SetDrag},
+        {"get_drag", FusionInstruction::GetDrag},
         {"end", FusionInstruction::End},
         {"create_label", FusionInstruction::CreateLabel},
         {"to_string", FusionInstruction::ToString},
@@ -147,6 +178,9 @@ namespace Code
         {"create_array", FusionInstruction::CreateArray},
         {"get_item", FusionInstruction::GetItem},
         {"set_item", FusionInstruction::SetItem},
+        {"append_in_place", FusionInstruction::AppendInPlace},
+        {"extend_in_place", FusionInstruction::ExtendInPlace},
+        {"create_struct", FusionInstruction::CreateStruct},
     };
 
     std::string getFusionInstructionText(FusionInstruction instruction);
@@ -184,6 +218,7 @@ namespace Code
         Float,
         String,
         ObjectType,
+        StructType,
         FunctionName,
         MethodName,
         VariableName,
@@ -232,6 +267,19 @@ namespace Code
         {FusionInstruction::GetSize, FusionInstructionData{.instruction = Engine::Instructions::GetSize, .argumentTypes = {}}},
         {FusionInstruction::SetSize, FusionInstructionData{.instruction = Engine::Instructions::SetSize, .argumentTypes = {}}},
         {FusionInstruction::AreOverlapping, FusionInstructionData{.instruction = Engine::Instructions::AreOverlapping, .argumentTypes = {}}},
+        {FusionInstruction::GetOverlapping, FusionInstructionData{.instruction = Engine::Instructions::GetOverlapping, .argumentTypes = {}}},
+        {FusionInstruction::GetOverlappingOfType, FusionInstructionData{.instruction = Engine::Instructions::GetOverlappingOfType, .argumentTypes = {InstructionArgumentType::ObjectType}}},
+        {FusionInstruction::QueryRect, FusionInstructionData{.instruction = Engine::Instructions::QueryRect, .argumentTypes = {}}},
+        {FusionInstruction::Raycast, FusionInstructionData{.instruction = Engine::Instructions::Raycast, .argumentTypes = {}}},
+        {FusionInstruction::RaycastOfType, FusionInstructionData{.instruction = Engine::Instructions::RaycastOfType, .argumentTypes = {InstructionArgumentType::ObjectType}}},
+        {FusionInstruction::SegmentCast, FusionInstructionData{.instruction = Engine::Instructions::SegmentCast, .argumentTypes = {}}},
+        {FusionInstruction::ObjectsAtPoint, FusionInstructionData{.instruction = Engine::Instructions::ObjectsAtPoint, .argumentTypes = {}}},
+        {FusionInstruction::SetVelocity, FusionInstructionData{.instruction = Engine::Instructions::SetVelocity, .argumentTypes = {}}},
+        {FusionInstruction::GetVelocity, FusionInstructionData{.instruction = Engine::Instructions::GetVelocity, .argumentTypes = {}}},
+        {FusionInstruction::SetAcceleration, FusionInstructionData{.instruction = Engine::Instructions::SetAcceleration, .argumentTypes = {}}},
+        {FusionInstruction::GetAcceleration, FusionInstructionData{.instruction = Engine::Instructions::GetAcceleration, .argumentTypes = {}}},
+        {FusionInstruction::SetDrag, FusionInstructionData{.instruction = Engine::Instructions::SetDrag, .argumentTypes = {}}},
+        {FusionInstruction::GetDrag, FusionInstructionData{.instruction = Engine::Instructions::GetDrag, .argumentTypes = {}}},
         {FusionInstruction::Not, FusionInstructionData{.instruction = Engine::Instructions::Not, .argumentTypes = {}}},
         {FusionInstruction::ToString, FusionInstructionData{.instruction = Engine::Instructions::ToString, .argumentTypes = {}}},
         {FusionInstruction::ToInt, FusionInstructionData{.instruction = Engine::Instructions::ToInt, .argumentTypes = {}}},
@@ -246,5 +294,8 @@ namespace Code
         {FusionInstruction::CreateArray, FusionInstructionData{.instruction = Engine::Instructions::CreateArray, .argumentTypes = {InstructionArgumentType::Int}}},
         {FusionInstruction::GetItem, FusionInstructionData{.instruction = Engine::Instructions::GetItem, .argumentTypes = {}}},
         {FusionInstruction::SetItem, FusionInstructionData{.instruction = Engine::Instructions::SetItem, .argumentTypes = {}}},
+        {FusionInstruction::AppendInPlace, FusionInstructionData{.instruction = Engine::Instructions::AppendInPlace, .argumentTypes = {}}},
+        {FusionInstruction::ExtendInPlace, FusionInstructionData{.instruction = Engine::Instructions::ExtendInPlace, .argumentTypes = {}}},
+        {FusionInstruction::CreateStruct, FusionInstructionData{.instruction = Engine::Instructions::CreateStruct, .argumentTypes = {InstructionArgumentType::StructType}}},
     };
 }
\ No newline at end of file
@@ -12,6 +12,8 @@ std::string Code::KeywordToken::toString() const
         return "Keyword(Type)";
     case Keyword::Of:
         return "Keyword(Of)";
+    case Keyword::Struct:
+        return "Keyword(Struct)";
     default:
         return "UNKNOWN";
     }
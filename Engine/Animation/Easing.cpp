@@ -0,0 +1,106 @@
+#include "Easing.hpp"
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+std::optional<Engine::Easing> Engine::getEasingByName(std::string const &name)
+{
+    static constexpr std::array<std::pair<char const *, Easing>, 16> Names{{
+        {"linear", Easing::Linear},
+        {"quad_in", Easing::QuadIn},
+        {"quad_out", Easing::QuadOut},
+        {"quad_in_out", Easing::QuadInOut},
+        {"cubic_in", Easing::CubicIn},
+        {"cubic_out", Easing::CubicOut},
+        {"cubic_in_out", Easing::CubicInOut},
+        {"sine_in", Easing::SineIn},
+        {"sine_out", Easing::SineOut},
+        {"sine_in_out", Easing::SineInOut},
+        {"expo_in", Easing::ExpoIn},
+        {"expo_out", Easing::ExpoOut},
+        {"back_in", Easing::BackIn},
+        {"back_out", Easing::BackOut},
+        {"elastic_out", Easing::ElasticOut},
+        {"bounce_out", Easing::BounceOut},
+    }};
+    for (auto const &[easingName, easing] : Names)
+    {
+        if (name == easingName)
+        {
+            return easing;
+        }
+    }
+    return {};
+}
+
+/// @brief Bounce curve that ends at 1, made of parabolas that get smaller towards the end
+static float bounceOut(float t)
+{
+    constexpr float strength = 7.5625f;
+    constexpr float width = 2.75f;
+    if (t < 1.f / width)
+    {
+        return strength * t * t;
+    }
+    if (t < 2.f / width)
+    {
+        t -= 1.5f / width;
+        return strength * t * t + 0.75f;
+    }
+    if (t < 2.5f / width)
+    {
+        t -= 2.25f / width;
+        return strength * t * t + 0.9375f;
+    }
+    t -= 2.625f / width;
+    return strength * t * t + 0.984375f;
+}
+
+float Engine::applyEasing(Easing easing, float t)
+{
+    constexpr float pi = std::numbers::pi_v<float>;
+    // amount by which back curves overshoot, same value as most animation libraries use
+    constexpr float overshoot = 1.70158f;
+    switch (easing)
+    {
+    case Easing::Linear:
+        return t;
+    case Easing::QuadIn:
+        return t * t;
+    case Easing::QuadOut:
+        return t * (2.f - t);
+    case Easing::QuadInOut:
+        return t < 0.5f ? 2.f * t * t : 1.f - 2.f * (1.f - t) * (1.f - t);
+    case Easing::CubicIn:
+        return t * t * t;
+    case Easing::CubicOut:
+        return 1.f - (1.f - t) * (1.f - t) * (1.f - t);
+    case Easing::CubicInOut:
+        return t < 0.5f ? 4.f * t * t * t : 1.f - 4.f * (1.f - t) * (1.f - t) * (1.f - t);
+    case Easing::SineIn:
+        return 1.f - std::cos(t * pi / 2.f);
+    case Easing::SineOut:
+        return std::sin(t * pi / 2.f);
+    case Easing::SineInOut:
+        return (1.f - std::cos(t * pi)) / 2.f;
+    case Easing::ExpoIn:
+        return t <= 0.f ? 0.f : std::exp2(10.f * t - 10.f);
+    case Easing::ExpoOut:
+        return t >= 1.f ? 1.f : 1.f - std::exp2(-10.f * t);
+    case Easing::BackIn:
+        return t * t * ((overshoot + 1.f) * t - overshoot);
+    case Easing::BackOut:
+        t -= 1.f;
+        return 1.f + t * t * ((overshoot + 1.f) * t + overshoot);
+    case Easing::ElasticOut:
+        if (t <= 0.f || t >= 1.f)
+        {
+            return t <= 0.f ? 0.f : 1.f;
+        }
+        return std::exp2(-10.f * t) * std::sin((t * 10.f - 0.75f) * 2.f * pi / 3.f) + 1.f;
+    case Easing::BounceOut:
+        return bounceOut(t);
+    }
+    return t;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <optional>
+
+namespace Engine
+{
+    /// @brief Curve that maps linear progress of an animation to the progress of the animated value
+    enum class Easing : uint8_t
+    {
+        Linear,
+        QuadIn,
+        QuadOut,
+        QuadInOut,
+        CubicIn,
+        CubicOut,
+        CubicInOut,
+        SineIn,
+        SineOut,
+        SineInOut,
+        ExpoIn,
+        ExpoOut,
+        BackIn,
+        BackOut,
+        ElasticOut,
+        BounceOut,
+    };
+
+    /// @brief Find easing by the name used in scripts, for example `linear`, `quad_in_out` or `bounce_out`
+    /// @return Easing or nothing if no easing uses that name
+    std::optional<Easing> getEasingByName(std::string const &name);
+
+    /// @brief Apply easing curve to the progress
+    /// @param progress Linear progress between 0 and 1
+    /// @return Eased progress, which starts at 0 and ends at 1 but can leave that range in between for curves that overshoot
+    float applyEasing(Easing easing, float progress);
+}
@@ -0,0 +1,161 @@
+#include "TweenSystem.hpp"
+#include "../System/Simd.hpp"
+#include <algorithm>
+
+Engine::TweenSystem::TweenId Engine::TweenSystem::start(TweenTarget const &target, sf::Vector2f from, sf::Vector2f to, float duration, Easing easing)
+{
+    // two tweens changing the same value would fight each other, so the newer one takes over
+    if (auto it = std::find(m_targets.begin(), m_targets.end(), target); it != m_targets.end())
+    {
+        remove((size_t)(it - m_targets.begin()));
+    }
+    uint32_t slot;
+    if (m_freeSlots.empty())
+    {
+        slot = (uint32_t)m_slots.size();
+        m_slots.emplace_back();
+    }
+    else
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    m_slots[slot].used = true;
+    m_slots[slot].index = (uint32_t)m_targets.size();
+    m_slotIndices.push_back(slot);
+    m_targets.push_back(target);
+    m_easings.push_back(easing);
+    m_elapsed.push_back(0.f);
+    m_duration.push_back(std::max(duration, 0.f));
+    m_startX.push_back(from.x);
+    m_startY.push_back(from.y);
+    m_changeX.push_back(to.x - from.x);
+    m_changeY.push_back(to.y - from.y);
+    m_progress.push_back(0.f);
+    m_discarded.push_back(0);
+    return getId(slot);
+}
+
+bool Engine::TweenSystem::stop(TweenId id)
+{
+    std::optional<size_t> index = getIndex(id);
+    if (!index.has_value())
+    {
+        return false;
+    }
+    remove(index.value());
+    return true;
+}
+
+void Engine::TweenSystem::stopObject(ObjectHandle object)
+{
+    size_t i = 0;
+    while (i < m_targets.size())
+    {
+        if (m_targets[i].object == object)
+        {
+            remove(i);
+            continue;
+        }
+        i++;
+    }
+}
+
+bool Engine::TweenSystem::isActive(TweenId id) const
+{
+    return getIndex(id).has_value();
+}
+
+uint32_t Engine::TweenSystem::getFieldIndex(std::string const &name)
+{
+    if (auto it = std::find(m_fieldNames.begin(), m_fieldNames.end(), name); it != m_fieldNames.end())
+    {
+        return (uint32_t)(it - m_fieldNames.begin());
+    }
+    m_fieldNames.push_back(name);
+    return (uint32_t)(m_fieldNames.size() - 1);
+}
+
+std::optional<size_t> Engine::TweenSystem::getIndex(TweenId id) const
+{
+    uint32_t slot = (uint32_t)id;
+    if (slot >= m_slots.size() || !m_slots[slot].used || m_slots[slot].generation != (uint32_t)(id >> 32))
+    {
+        return {};
+    }
+    return m_slots[slot].index;
+}
+
+void Engine::TweenSystem::advance(float delta)
+{
+    size_t count = m_targets.size();
+    Simd::addScalar(m_elapsed.data(), count, delta);
+    for (size_t i = 0; i < count; i++)
+    {
+        float progress = m_duration[i] > 0.f ? m_elapsed[i] / m_duration[i] : 1.f;
+        // last value is always exactly the end value, no matter what the curve returns near the end
+        m_progress[i] = progress >= 1.f ? 1.f : applyEasing(m_easings[i], progress);
+    }
+}
+
+sf::Vector2f Engine::TweenSystem::getValue(size_t index) const
+{
+    return sf::Vector2f(m_startX[index] + m_changeX[index] * m_progress[index], m_startY[index] + m_changeY[index] * m_progress[index]);
+}
+
+void Engine::TweenSystem::removeFinished(std::vector<FinishedTween> &finished)
+{
+    finished.clear();
+    size_t i = 0;
+    while (i < m_targets.size())
+    {
+        bool done = m_elapsed[i] >= m_duration[i];
+        if (!done && m_discarded[i] == 0)
+        {
+            i++;
+            continue;
+        }
+        if (done && m_discarded[i] == 0)
+        {
+            finished.push_back(FinishedTween{getId(m_slotIndices[i]), m_targets[i].object});
+        }
+        remove(i);
+    }
+}
+
+void Engine::TweenSystem::remove(size_t index)
+{
+    Slot &slot = m_slots[m_slotIndices[index]];
+    // changing generation makes every id of the tween stale
+    slot.generation++;
+    slot.used = false;
+    m_freeSlots.push_back(m_slotIndices[index]);
+    // order of tweens does not matter, so the last one fills the gap
+    size_t last = m_targets.size() - 1;
+    if (index != last)
+    {
+        m_slots[m_slotIndices[last]].index = (uint32_t)index;
+        m_slotIndices[index] = m_slotIndices[last];
+        m_targets[index] = m_targets[last];
+        m_easings[index] = m_easings[last];
+        m_elapsed[index] = m_elapsed[last];
+        m_duration[index] = m_duration[last];
+        m_startX[index] = m_startX[last];
+        m_startY[index] = m_startY[last];
+        m_changeX[index] = m_changeX[last];
+        m_changeY[index] = m_changeY[last];
+        m_progress[index] = m_progress[last];
+        m_discarded[index] = m_discarded[last];
+    }
+    m_slotIndices.pop_back();
+    m_targets.pop_back();
+    m_easings.pop_back();
+    m_elapsed.pop_back();
+    m_duration.pop_back();
+    m_startX.pop_back();
+    m_startY.pop_back();
+    m_changeX.pop_back();
+    m_changeY.pop_back();
+    m_progress.pop_back();
+    m_discarded.pop_back();
+}
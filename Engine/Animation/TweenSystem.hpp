@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <SFML/Graphics.hpp>
+#include "Easing.hpp"
+#include "../Object/ObjectHandle.hpp"
+
+namespace Engine
+{
+    /// @brief Property of an object that a tween changes
+    enum class TweenProperty : uint8_t
+    {
+        Position,
+        Size,
+        /// @brief Numeric field that holds a float
+        FloatField,
+        /// @brief Numeric field that holds an int, values are rounded when they are written
+        IntField,
+        /// @brief Font size of a label, values are rounded when they are written
+        FontSize,
+    };
+
+    /// @brief Object property that a tween changes
+    struct TweenTarget
+    {
+        ObjectHandle object;
+        TweenProperty property;
+        /// @brief Index of the field name for field properties, see `TweenSystem::getFieldName`
+        uint32_t field = 0;
+
+        bool operator==(TweenTarget const &other) const = default;
+    };
+
+    /// @brief Tween that ran its whole duration
+    struct FinishedTween
+    {
+        uint64_t id;
+        ObjectHandle object;
+    };
+
+    /// @brief Storage of every running tween of a scene. Tweens only calculate values, applying them to objects is left to the owner.
+    /// Every tween property is kept in its own array so that advancing the whole set is a single pass over tightly packed data
+    class TweenSystem
+    {
+    public:
+        /// @brief Identifier of a tween made from its slot and generation, so that ids of finished tweens never match new tweens
+        using TweenId = uint64_t;
+
+        explicit TweenSystem() = default;
+
+        /// @brief Start a tween. Tween that was already changing the same property of the same object is stopped without finishing
+        /// @param from Value at the start, single number properties only use x
+        /// @param to Value at the end
+        /// @param duration Time in seconds, tweens with no duration jump to the end on the next advance
+        TweenId start(TweenTarget const &target, sf::Vector2f from, sf::Vector2f to, float duration, Easing easing);
+
+        /// @brief Stop tween without finishing it
+        /// @return True if tween was still running
+        bool stop(TweenId id);
+
+        /// @brief Stop every tween of the object without finishing them
+        void stopObject(ObjectHandle object);
+
+        bool isActive(TweenId id) const;
+
+        size_t getCount() const { return m_targets.size(); }
+
+        /// @brief Get index used to store the field name in targets, names are stored only once
+        uint32_t getFieldIndex(std::string const &name);
+
+        std::string const &getFieldName(uint32_t index) const { return m_fieldNames[index]; }
+
+        /// @brief Move every tween forward in time and calculate their current values
+        void advance(float delta);
+
+        TweenTarget const &getTarget(size_t index) const { return m_targets[index]; }
+
+        /// @brief Get value of the tween at the index as calculated by the last advance
+        sf::Vector2f getValue(size_t index) const;
+
+        /// @brief Mark tween at the index to be removed without finishing, used for tweens whose objects no longer exist
+        void discard(size_t index) { m_discarded[index] = 1; }
+
+        /// @brief Remove tweens that reached their end or were discarded since the last advance
+        /// @param finished Receives tweens that reached their end
+        void removeFinished(std::vector<FinishedTween> &finished);
+
+    private:
+        struct Slot
+        {
+            uint32_t generation = 0;
+            /// @brief Index of the tween in the arrays, only valid while slot is used
+            uint32_t index = 0;
+            bool used = false;
+        };
+
+        TweenId getId(uint32_t slot) const { return ((TweenId)m_slots[slot].generation << 32) | slot; }
+
+        /// @brief Get index of the tween in the arrays or nothing if tween no longer exists
+        std::optional<size_t> getIndex(TweenId id) const;
+
+        /// @brief Remove tween from the arrays, last tween takes its place
+        void remove(size_t index);
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        std::vector<std::string> m_fieldNames;
+        /// @brief Slot of every tween
+        std::vector<uint32_t> m_slotIndices;
+        std::vector<TweenTarget> m_targets;
+        std::vector<Easing> m_easings;
+        std::vector<float> m_elapsed;
+        std::vector<float> m_duration;
+        std::vector<float> m_startX;
+        std::vector<float> m_startY;
+        std::vector<float> m_changeX;
+        std::vector<float> m_changeY;
+        /// @brief Eased progress calculated by the last advance
+        std::vector<float> m_progress;
+        std::vector<uint8_t> m_discarded;
+    };
+}
@@ -17,3 +17,7 @@ Engine::SoundAsset::SoundAsset(std::string const &path, float pitch, float defau
 Engine::FontAsset::FontAsset(std::string const &path) : Asset(path)
 {
 }
+
+Engine::ParticleEffectAsset::ParticleEffectAsset(std::string const &path, ParticleSettings const &settings) : Asset(path), m_settings(settings)
+{
+}
@@ -2,6 +2,7 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <map>
+#include "../Particles/ParticleSettings.hpp"
 
 namespace Engine
 {
@@ -66,4 +67,15 @@ namespace Engine
 
     private:
     };
+
+    class ParticleEffectAsset : public Asset
+    {
+    public:
+        explicit ParticleEffectAsset(std::string const &path, ParticleSettings const &settings);
+
+        ParticleSettings const &getSettings() const { return m_settings; }
+
+    private:
+        ParticleSettings m_settings;
+    };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "ContentManager.hpp"
 #include <iostream>
+#include <filesystem>
 #include "../Error.hpp"
 void Engine::ContentManager::addSpriteAsset(std::string const &name, std::unique_ptr<SpriteFramesAsset> asset)
 {
@@ -20,6 +21,11 @@ void Engine::ContentManager::addFontAsset(std::string const &name, std::unique_p
     m_fontAssets[name] = std::move(asset);
 }
 
+void Engine::ContentManager::addParticleAsset(std::string const &name, std::unique_ptr<ParticleEffectAsset> asset)
+{
+    m_particleAssets[name] = std::move(asset);
+}
+
 Engine::SpriteFramesAsset const *Engine::ContentManager::getAnimationAsset(std::string const &name) const
 {
     if (name != "null" && m_spriteFrameAssets.contains(name))
@@ -47,6 +53,15 @@ Engine::FontAsset const *Engine::ContentManager::getFontAsset(std::string const
     return nullptr;
 }
 
+Engine::ParticleEffectAsset const *Engine::ContentManager::getParticleAsset(std::string const &name) const
+{
+    if (m_particleAssets.contains(name))
+    {
+        return m_particleAssets.at(name).get();
+    }
+    return nullptr;
+}
+
 sf::Texture *Engine::ContentManager::loadTexture(std::string const &path)
 {
     if (m_textures.contains(path))
@@ -56,6 +71,9 @@ sf::Texture *Engine::ContentManager::loadTexture(std::string const &path)
     try
     {
         m_textures[path] = std::make_unique<sf::Texture>(path);
+        // pixels are stored in RGBA8 on the gpu
+        sf::Vector2u size = m_textures[path]->getSize();
+        m_memoryUsage.textures.add((size_t)size.x * size.y * 4);
         return m_textures[path].get();
     }
     catch (sf::Exception e)
@@ -73,6 +91,7 @@ sf::SoundBuffer *Engine::ContentManager::loadSoundBuffer(std::string const &path
     try
     {
         m_sounds[path] = std::make_unique<sf::SoundBuffer>(path);
+        m_memoryUsage.sounds.add(m_sounds[path]->getSampleCount() * sizeof(std::int16_t));
         return m_sounds[path].get();
     }
     catch (sf::Exception e)
@@ -90,6 +109,10 @@ sf::Font *Engine::ContentManager::loadFont(std::string const &path)
     try
     {
         m_fonts[path] = std::make_unique<sf::Font>(path);
+        // font keeps the whole file in memory, glyph pages are created lazily and are not counted
+        std::error_code err;
+        uintmax_t size = std::filesystem::file_size(path, err);
+        m_memoryUsage.fonts.add(err ? 0 : (size_t)size);
         return m_fonts[path].get();
     }
     catch (sf::Exception e)
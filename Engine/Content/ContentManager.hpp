@@ -7,6 +7,7 @@
 #include "AnimatedSprite.hpp"
 #include "Sound.hpp"
 #include "Label.hpp"
+#include "../Memory/MemoryStatistics.hpp"
 namespace Engine
 {
     class ContentManager
@@ -36,12 +37,19 @@ namespace Engine
         /// @param asset Asset data
         void addFontAsset(std::string const &name, std::unique_ptr<FontAsset> asset);
 
+        /// @brief Manually register a particle effect asset in the system
+        /// @param name Name of the asset
+        /// @param asset Asset data
+        void addParticleAsset(std::string const &name, std::unique_ptr<ParticleEffectAsset> asset);
+
         SpriteFramesAsset const *getAnimationAsset(std::string const &name) const;
 
         SoundAsset const *getSoundAsset(std::string const &name) const;
 
         FontAsset const *getFontAsset(std::string const &name) const;
 
+        ParticleEffectAsset const *getParticleAsset(std::string const &name) const;
+
         /// @brief Load texture from disk. If texture has already been loaded, pointer to existing texture is returned
         /// @param path
         /// @return
@@ -60,6 +68,9 @@ namespace Engine
 
         std::unique_ptr<Sound> createSoundFromAsset(SoundAsset const *asset);
 
+        /// @brief Get estimated amount of memory used by loaded textures, sounds and fonts
+        ContentMemoryUsage const &getMemoryUsage() const { return m_memoryUsage; }
+
     private:
         std::map<std::string, std::unique_ptr<sf::Texture>> m_textures;
         std::map<std::string, std::unique_ptr<sf::SoundBuffer>> m_sounds;
@@ -67,5 +78,7 @@ namespace Engine
         std::map<std::string, std::unique_ptr<SpriteFramesAsset>> m_spriteFrameAssets;
         std::map<std::string, std::unique_ptr<SoundAsset>> m_soundAssets;
         std::map<std::string, std::unique_ptr<FontAsset>> m_fontAssets;
+        std::map<std::string, std::unique_ptr<ParticleEffectAsset>> m_particleAssets;
+        ContentMemoryUsage m_memoryUsage;
     };
 }
\ No newline at end of file
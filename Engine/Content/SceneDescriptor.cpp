@@ -44,3 +44,25 @@ Engine::SceneDescriptionLabelObject::SceneDescriptionLabelObject(std::string con
     : SceneDescriptionObject(name, "Label", startPos, startSize, props), m_text(text), m_font(fontName)
 {
 }
+
+Engine::SceneDescriptionTilemapObject::SceneDescriptionTilemapObject(std::string const &name,
+                                                                     std::string const &tilesetName,
+                                                                     sf::Vector2i mapSize,
+                                                                     sf::Vector2f tileSize,
+                                                                     std::vector<uint16_t> const &tiles,
+                                                                     std::vector<std::pair<uint16_t, bool>> const &solidTiles,
+                                                                     sf::Vector2f startPos,
+                                                                     std::map<std::string, SceneDescriptionPropertyValue> const &props)
+    : SceneDescriptionObject(name, "Tilemap", startPos, {}, props), m_tileset(tilesetName), m_mapSize(mapSize), m_tileSize(tileSize), m_tiles(tiles), m_solidTiles(solidTiles)
+{
+}
+
+Engine::SceneDescriptionParticleEmitterObject::SceneDescriptionParticleEmitterObject(std::string const &name,
+                                                                                     std::string const &effectName,
+                                                                                     bool emitting,
+                                                                                     sf::Vector2f startPos,
+                                                                                     std::optional<sf::Vector2f> startSize,
+                                                                                     std::map<std::string, SceneDescriptionPropertyValue> const &props)
+    : SceneDescriptionObject(name, "ParticleEmitter", startPos, startSize, props), m_effect(effectName), m_emitting(emitting)
+{
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include "../Execution/Value.hpp"
+#include "../Object/UpdatePolicy.hpp"
 
 namespace Engine
 {
@@ -50,6 +51,11 @@ namespace Engine
             return m_defaultValues;
         }
 
+        /// @brief Get update policy specific to this object, if not set policy of the type is used
+        std::optional<UpdatePolicy> const &getUpdatePolicy() const { return m_updatePolicy; }
+
+        void setUpdatePolicy(UpdatePolicy const &policy) { m_updatePolicy = policy; }
+
         virtual ~SceneDescriptionObject() = default;
 
     private:
@@ -59,6 +65,7 @@ namespace Engine
         std::optional<std::string> m_spritePath;
         std::optional<sf::Vector2f> m_startSize;
         std::map<std::string, SceneDescriptionPropertyValue> m_defaultValues;
+        std::optional<UpdatePolicy> m_updatePolicy;
     };
 
     class SceneDescriptionAudioObject : public SceneDescriptionObject
@@ -94,6 +101,56 @@ namespace Engine
         std::string m_font;
     };
 
+    class SceneDescriptionTilemapObject : public SceneDescriptionObject
+    {
+    public:
+        explicit SceneDescriptionTilemapObject(std::string const &name,
+                                               std::string const &tilesetName,
+                                               sf::Vector2i mapSize,
+                                               sf::Vector2f tileSize,
+                                               std::vector<uint16_t> const &tiles,
+                                               std::vector<std::pair<uint16_t, bool>> const &solidTiles,
+                                               sf::Vector2f startPos,
+                                               std::map<std::string, SceneDescriptionPropertyValue> const &props);
+
+        std::string const &getTilesetName() const { return m_tileset; }
+        sf::Vector2i getMapSize() const { return m_mapSize; }
+        sf::Vector2f getTileSize() const { return m_tileSize; }
+
+        /// @brief Get tiles stored row by row
+        std::vector<uint16_t> const &getTiles() const { return m_tiles; }
+
+        /// @brief Get tiles which have solidity different from the default
+        std::vector<std::pair<uint16_t, bool>> const &getSolidTiles() const { return m_solidTiles; }
+
+    private:
+        std::string m_tileset;
+        sf::Vector2i m_mapSize;
+        sf::Vector2f m_tileSize;
+        std::vector<uint16_t> m_tiles;
+        std::vector<std::pair<uint16_t, bool>> m_solidTiles;
+    };
+
+    class SceneDescriptionParticleEmitterObject : public SceneDescriptionObject
+    {
+    public:
+        explicit SceneDescriptionParticleEmitterObject(std::string const &name,
+                                                       std::string const &effectName,
+                                                       bool emitting,
+                                                       sf::Vector2f startPos,
+                                                       std::optional<sf::Vector2f> startSize,
+                                                       std::map<std::string, SceneDescriptionPropertyValue> const &props);
+
+        std::string const &getEffectName() const { return m_effect; }
+
+        /// @brief Check if emitter starts spawning particles as soon as the scene is created
+        bool isEmitting() const { return m_emitting; }
+
+    private:
+        std::string m_effect;
+        bool m_emitting;
+    };
+
     class SceneDescription
     {
     public:
@@ -105,10 +162,22 @@ namespace Engine
 
         std::vector<std::unique_ptr<SceneDescriptionObject>> const &getObjects() const;
 
+        /// @brief Get update policies that override policies of the types in this scene
+        std::map<std::string, UpdatePolicy> const &getTypeUpdatePolicies() const { return m_typeUpdatePolicies; }
+
+        void setTypeUpdatePolicy(std::string const &typeName, UpdatePolicy const &policy) { m_typeUpdatePolicies[typeName] = policy; }
+
+        /// @brief Get area in which objects using region update mode are updated
+        std::optional<sf::FloatRect> const &getUpdateRegion() const { return m_updateRegion; }
+
+        void setUpdateRegion(sf::FloatRect const &region) { m_updateRegion = region; }
+
     private:
         std::vector<std::unique_ptr<SceneDescriptionObject>> m_objects;
 
         std::optional<std::string> m_title;
         std::string m_codePath;
+        std::map<std::string, UpdatePolicy> m_typeUpdatePolicies;
+        std::optional<sf::FloatRect> m_updateRegion;
     };
 } // namespace Engine
@@ -52,6 +52,7 @@ namespace Engine
         ExitFunction,
         // Return value from a function and  exit
         Return,
+        // Field instructions are followed by index of the field slot cache of the function, after the name for instructions that have one
         GetField,
         SetField,
         HasField,
@@ -61,6 +62,30 @@ namespace Engine
         GetSize,
         SetSize,
         AreOverlapping,
+        // Set velocity of the object, the object moves natively every frame without needing a script
+        SetVelocity,
+        GetVelocity,
+        // Set acceleration that is added to the velocity of the object every second
+        SetAcceleration,
+        GetAcceleration,
+        // Set fraction of velocity object loses every second
+        SetDrag,
+        GetDrag,
+        // Push array of all objects overlapping the object on top of the stack
+        GetOverlapping,
+        // Push array of all objects of given type overlapping the object on top of the stack
+        GetOverlappingOfType,
+        // Push array of all objects overlapping the rectangle with position and size on the stack
+        QueryRect,
+        // Push array of hits of the ray with origin, direction and max distance on the stack ordered from the nearest one, each hit is an array of object, point and distance.
+        // Object pushed after the max distance is left out of the hits, usually the one casting the ray
+        Raycast,
+        // Same as raycast but only objects of given type are hit
+        RaycastOfType,
+        // Push array of hits of the segment between two points on the stack ordered from the nearest one. Object pushed after the end point is left out of the hits
+        SegmentCast,
+        // Push array of all objects containing the point on top of the stack
+        ObjectsAtPoint,
         CreateLabel,
         ToString,
         ToInt,
@@ -75,5 +100,14 @@ namespace Engine
         CreateArray,
         GetItem,
         SetItem,
+        // Append value from the top of the stack to the string or array below it without creating a new object
+        AppendInPlace,
+        // Append all items of the array or string from the top of the stack to the array or string below it without creating a new object
+        ExtendInPlace,
+        // Create a new instance of the struct with given name
+        CreateStruct,
+        // Push value of a local variable that is never read again and clear the variable. Not written by hand, the compiler turns last loads of variables into moves
+        // so that storing the value in another variable or passing it as an argument takes over the reference of the variable instead of retaining it again
+        MoveLocal,
     };
 }
\ No newline at end of file
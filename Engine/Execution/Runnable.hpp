@@ -3,9 +3,16 @@
 #include <variant>
 #include <string>
 #include <map>
+#include <vector>
+#include <optional>
 #include <cstdint>
 #include "../../Code/DebugInfo.hpp"
 
+namespace Engine
+{
+    class StructType;
+}
+
 namespace Engine::Runnable
 {
     enum class CodeConstantValueType
@@ -18,10 +25,21 @@ namespace Engine::Runnable
     };
     using CodeConstantValue = std::variant<bool, int64_t, double, size_t, sf::Vector2f>;
 
+    /// @brief Struct field that a field instruction accessed last time. Instructions mostly see structs of the same type, so the slot is only looked up by name when the type changes
+    struct FieldSlotCache
+    {
+        StructType const *type = nullptr;
+        std::optional<size_t> slot;
+        /// @brief Name the slot belongs to, needed by instructions that take the name from the stack
+        std::string name;
+    };
+
     struct RunnableFunction
     {
         size_t argumentCount;
         std::vector<uint8_t> bytes;
+        /// @brief Cache for every field instruction of the function, indexed by the operand that follows the instruction
+        mutable std::vector<FieldSlotCache> fieldSlotCaches;
     };
 
     struct RunnableFunctionDebugInfo
@@ -2,8 +2,12 @@
 #include "../Object/GameObject.hpp"
 #include "../Object/MemoryObject.hpp"
 #include "../Object/ArrayObject.hpp"
+#include "../Object/TypedArrayObject.hpp"
+#include "../Object/MapObject.hpp"
+#include "../Object/StructObject.hpp"
+#include "../Scene.hpp"
 
-std::string Engine::valueToString(Value const &v)
+std::string Engine::valueToString(Value const &v, Scene const &scene)
 {
     switch (v.index())
     {
@@ -19,18 +23,24 @@ std::string Engine::valueToString(Value const &v)
         return std::string("(") + std::to_string(std::get<sf::Vector2f>(v).x) + "," + std::to_string(std::get<sf::Vector2f>(v).y) + ")";
     case ValueType::Object:
     {
-        GameObject *o = std::get<GameObject *>(v);
-        if (o->isDestroyed())
+        GameObject const *o = scene.getObject(std::get<ObjectHandle>(v));
+        if (o == nullptr)
         {
             return "Freed object";
         }
-        return std::string("Object@") + std::get<GameObject *>(v)->getName();
+        return o->toString();
     }
 
     case ValueType::String:
-        return std::get<StringObject *>(v)->toString();
+        return std::get<StringObject *>(v)->toString(scene);
     case ValueType::Array:
-        return std::get<ArrayObject *>(v)->toString();
+        return std::get<ArrayObject *>(v)->toString(scene);
+    case ValueType::TypedArray:
+        return std::get<TypedArrayObject *>(v)->toString(scene);
+    case ValueType::Map:
+        return std::get<MapObject *>(v)->toString(scene);
+    case ValueType::Struct:
+        return std::get<StructObject *>(v)->toString(scene);
     }
     return "INVALID DATA TYPE";
 }
@@ -55,38 +65,41 @@ const char *Engine::typeToString(ValueType type)
         return "String";
     case ValueType::Array:
         return "Array";
+    case ValueType::TypedArray:
+        return "TypedArray";
+    case ValueType::Map:
+        return "Map";
+    case ValueType::Struct:
+        return "Struct";
     }
     return "INVALID DATA TYPE";
 }
 
-void Engine::increaseValueRefCount(Value const &v)
+Engine::MemoryObject *Engine::getValueMemoryObject(Value const &v)
 {
-    if (v.index() == ValueType::String)
-    {
-        std::get<StringObject *>(v)->increaseRefCounter();
-    }
-    if (v.index() == ValueType::Object)
-    {
-        std::get<GameObject *>(v)->increaseRefCounter();
-    }
-    else if (v.index() == ValueType::Array)
+    switch (v.index())
     {
-        std::get<ArrayObject *>(v)->increaseRefCounter();
+    case ValueType::String:
+        return std::get<StringObject *>(v);
+    case ValueType::Array:
+        return std::get<ArrayObject *>(v);
+    case ValueType::TypedArray:
+        return std::get<TypedArrayObject *>(v);
+    case ValueType::Map:
+        return std::get<MapObject *>(v);
+    case ValueType::Struct:
+        return std::get<StructObject *>(v);
+    default:
+        return nullptr;
     }
 }
 
-void Engine::decreaseValueRefCount(Value const &v)
+void Engine::increaseManagedRefCount(Value const &v)
 {
-    if (v.index() == ValueType::String)
-    {
-        std::get<StringObject *>(v)->decreaseRefCounter();
-    }
-    if (v.index() == ValueType::Object)
-    {
-        std::get<GameObject *>(v)->decreaseRefCounter();
-    }
-    else if (v.index() == ValueType::Array)
-    {
-        std::get<ArrayObject *>(v)->decreaseRefCounter();
-    }
+    getValueMemoryObject(v)->increaseRefCounter();
+}
+
+void Engine::decreaseManagedRefCount(Value const &v)
+{
+    getValueMemoryObject(v)->decreaseRefCounter();
 }
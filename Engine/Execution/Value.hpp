@@ -3,6 +3,7 @@
 #include <string>
 #include <cstdint>
 #include <SFML/Graphics.hpp>
+#include "../Object/ObjectHandle.hpp"
 
 namespace Engine
 {
@@ -15,7 +16,10 @@ namespace Engine
         Vector,
         Object,
         String,
-        Array
+        Array,
+        TypedArray,
+        Map,
+        Struct
     };
     // Declare some types aliases to make changeing underlying types easier
     using IntType = int64_t;
@@ -23,27 +27,60 @@ namespace Engine
     using VectorType = sf::Vector2f;
     using NilType = std::monostate;
     // Predeclare classes to avoid having them included because we get circular inclusion otherwise
-    class GameObject;
+    class Scene;
+    class MemoryObject;
     class StringObject;
     class ArrayObject;
+    class TypedArrayObject;
+    class MapObject;
+    class StructObject;
 
     static const NilType NilValue = NilType();
-    /// @brief Special type containing all possible values that can be used in the engine
-    using Value = std::variant<NilType, bool, IntType, FloatType, VectorType, GameObject *, StringObject *, ArrayObject *>;
+    /// @brief Special type containing all possible values that can be used in the engine.
+    /// Game objects are stored as handles, because they can be destroyed while scripts still reference them
+    using Value = std::variant<NilType, bool, IntType, FloatType, VectorType, ObjectHandle, StringObject *, ArrayObject *, TypedArrayObject *, MapObject *, StructObject *>;
 
     /// @brief Get string representation of the given value
     /// @param v Value to convert to string
-    std::string valueToString(Value const &v);
+    /// @param scene Scene used to resolve object handles
+    std::string valueToString(Value const &v, Scene const &scene);
 
     /// @brief Get human readable string representing type name
     /// @param type Type
     const char *typeToString(ValueType type);
 
+    /// @brief Get memory managed object stored in the value
+    /// @param v Value
+    /// @return Pointer to the object or null if value is not a memory managed type
+    MemoryObject *getValueMemoryObject(Value const &v);
+
+    /// @brief Check if value holds a memory managed object. Managed types are kept at the end of the variant so that this is a single comparison
+    inline bool isManagedValue(Value const &v) { return v.index() >= ValueType::String; }
+
+    /// @brief Increase reference count of the object stored in the value, value must hold a memory managed object
+    void increaseManagedRefCount(Value const &v);
+
+    /// @brief Decrease reference count of the object stored in the value, value must hold a memory managed object
+    void decreaseManagedRefCount(Value const &v);
+
     /// @brief Increase reference count for value if value if refcounted, otherwise do nothing
     /// @param v Value
-    void increaseValueRefCount(Value const &v);
+    inline void increaseValueRefCount(Value const &v)
+    {
+        // plain values are by far the most common, so they are filtered out before making a call
+        if (isManagedValue(v))
+        {
+            increaseManagedRefCount(v);
+        }
+    }
 
     /// @brief Decrease reference count for value if value if refcounted, otherwise do nothing
     /// @param v Value
-    void decreaseValueRefCount(Value const &v);
+    inline void decreaseValueRefCount(Value const &v)
+    {
+        if (isManagedValue(v))
+        {
+            decreaseManagedRefCount(v);
+        }
+    }
 }
\ No newline at end of file
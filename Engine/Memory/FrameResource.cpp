@@ -0,0 +1,23 @@
+#include "FrameResource.hpp"
+
+void Engine::FrameResource::release()
+{
+    m_storage.release();
+    m_used = 0;
+}
+
+void *Engine::FrameResource::do_allocate(size_t bytes, size_t alignment)
+{
+    void *mem = m_storage.allocate(bytes, alignment);
+    m_used += bytes;
+    m_usage.resize(m_usage.bytes, m_usage.bytes + bytes);
+    return mem;
+}
+
+void *Engine::FrameResource::allocateObject(size_t bytes, size_t alignment)
+{
+    void *mem = m_storage.allocate(bytes, alignment);
+    m_used += bytes;
+    m_usage.add(bytes);
+    return mem;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include "MemoryStatistics.hpp"
+
+namespace Engine
+{
+    /// @brief Bump allocator for memory that lives until the end of the frame. Freeing does nothing, everything is released at once by `release`.
+    /// Every allocation is recorded, so memory that temporary objects allocate for their contents is accounted for together with the objects themselves
+    class FrameResource : public std::pmr::memory_resource
+    {
+    public:
+        /// @param buffer Memory used before going to the upstream resource
+        /// @param size Size of the buffer in bytes
+        /// @param usage Usage that receives bytes of every allocation and a count for every object allocated by `allocateObject`
+        explicit FrameResource(void *buffer, size_t size, MemoryUsage &usage, std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+            : m_storage(buffer, size, upstream), m_usage(usage) {}
+
+        /// @brief Allocate memory for a new object, unlike regular allocations this counts as a new entry of the usage
+        /// @param bytes Size of the object
+        /// @param alignment Alignment of the object
+        void *allocateObject(size_t bytes, size_t alignment);
+
+        /// @brief Get amount of bytes allocated since the last release
+        size_t getUsedBytes() const { return m_used; }
+
+        /// @brief Free everything allocated so far
+        void release();
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void *, size_t, size_t) override {}
+
+        bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override { return this == &other; }
+
+        std::pmr::monotonic_buffer_resource m_storage;
+        MemoryUsage &m_usage;
+        size_t m_used = 0;
+    };
+}
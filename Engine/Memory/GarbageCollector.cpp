@@ -0,0 +1,259 @@
+#include "GarbageCollector.hpp"
+#include <chrono>
+#include <algorithm>
+#include <bit>
+
+void Engine::GarbageCollector::addCandidate(MemoryObject *obj)
+{
+    // objects released during the sweep are going to be freed by the sweep itself
+    if (obj->m_temporary || obj->m_queuedForCollection || (m_sweeping && !obj->m_reachable))
+    {
+        return;
+    }
+    obj->m_queuedForCollection = true;
+    m_candidates.push_back(obj);
+}
+
+void Engine::GarbageCollector::markRoot(Value const &val)
+{
+    MemoryObject *obj = getValueMemoryObject(val);
+    // objects that are still referenced can become garbage during the slice if their owner is freed, so they have to be marked as well
+    if (obj == nullptr || obj->m_collector != this || obj->m_temporary || obj->m_rootReferenced)
+    {
+        return;
+    }
+    obj->m_rootReferenced = true;
+    m_markedRoots.push_back(obj);
+}
+
+size_t Engine::GarbageCollector::collect()
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t freed = 0;
+    while (!m_candidates.empty() && freed < m_sliceSize)
+    {
+        MemoryObject *obj = m_candidates.back();
+        m_candidates.pop_back();
+        if (!obj->isDead())
+        {
+            // something started referencing the object again, it will be queued again once it's no longer in use
+            obj->m_queuedForCollection = false;
+        }
+        else if (obj->m_rootReferenced)
+        {
+            m_deferredCandidates.push_back(obj);
+        }
+        else
+        {
+            // freeing the object can add new candidates to the list, which will be handled by this loop as well
+            free(obj);
+            freed++;
+        }
+    }
+    for (MemoryObject *obj : m_markedRoots)
+    {
+        obj->m_rootReferenced = false;
+    }
+    m_markedRoots.clear();
+
+    if (m_candidates.empty())
+    {
+        // cycle is done, objects that were in use will be checked again during the next cycle
+        m_candidates.swap(m_deferredCandidates);
+        m_collecting = false;
+        m_allocatedSinceCollection = 0;
+        m_statistics.collectionCount++;
+    }
+
+    uint64_t pause = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    m_statistics.lastPauseMicroseconds = pause;
+    m_statistics.maxPauseMicroseconds = std::max(m_statistics.maxPauseMicroseconds, pause);
+    m_statistics.totalPauseMicroseconds += pause;
+    return freed;
+}
+
+void Engine::GarbageCollector::markReachable(Value const &val)
+{
+    MemoryObject *root = getValueMemoryObject(val);
+    if (root == nullptr || root->m_collector != this || root->m_reachable)
+    {
+        return;
+    }
+    root->m_reachable = true;
+    // objects can be nested deep enough to overflow the native stack, so references are traced later without recursion
+    m_traceStack.push_back(root);
+}
+
+size_t Engine::GarbageCollector::sweepUnreachable()
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (!m_traceStack.empty())
+    {
+        MemoryObject const *obj = m_traceStack.back();
+        m_traceStack.pop_back();
+        obj->traceReferences(*this);
+    }
+    std::vector<MemoryObject *> unreachable;
+    for (MemoryObject *obj : m_objects)
+    {
+        if (!obj->m_reachable)
+        {
+            unreachable.push_back(obj);
+        }
+    }
+    // first break all references so that reachable objects referenced from the cycles get correct reference count
+    // and unreachable objects don't touch each other while being freed
+    m_sweeping = true;
+    for (MemoryObject *obj : unreachable)
+    {
+        obj->releaseReferences();
+    }
+    m_sweeping = false;
+    std::erase_if(m_candidates, [](MemoryObject const *obj)
+                  { return !obj->m_reachable; });
+    std::erase_if(m_deferredCandidates, [](MemoryObject const *obj)
+                  { return !obj->m_reachable; });
+    for (MemoryObject *obj : unreachable)
+    {
+        free(obj);
+    }
+    for (MemoryObject *obj : m_objects)
+    {
+        obj->m_reachable = false;
+    }
+    // temporary objects are traced since they can be the only thing referencing regular objects
+    for (MemoryObject *obj : m_temporaryObjects)
+    {
+        obj->m_reachable = false;
+    }
+
+    m_lastTraceCollection = m_statistics.collectionCount;
+    m_statistics.traceCount++;
+    m_statistics.lastTraceFreeCount = unreachable.size();
+    m_statistics.traceFreeCount += unreachable.size();
+
+    uint64_t pause = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    m_statistics.lastPauseMicroseconds = pause;
+    m_statistics.maxPauseMicroseconds = std::max(m_statistics.maxPauseMicroseconds, pause);
+    m_statistics.totalPauseMicroseconds += pause;
+    return unreachable.size();
+}
+
+void Engine::GarbageCollector::updateAccountedSize(MemoryObject *obj)
+{
+    uint32_t size = (uint32_t)obj->getAllocatedSize();
+    if (size == obj->m_accountedSize)
+    {
+        return;
+    }
+    m_statistics.liveBytes = m_statistics.liveBytes - obj->m_accountedSize + size;
+    m_usage.resize(obj->m_accountedSize, size);
+    m_kindUsage[(size_t)obj->getKind()].resize(obj->m_accountedSize, size);
+    obj->m_accountedSize = size;
+}
+
+void Engine::GarbageCollector::updateAccountedSizes()
+{
+    for (MemoryObject *obj : m_objects)
+    {
+        updateAccountedSize(obj);
+    }
+}
+
+void Engine::GarbageCollector::releaseTemporaries()
+{
+    m_statistics.lastFrameTemporaryCount = m_temporaryObjects.size();
+    // release references first so that regular objects used only by temporaries become candidates,
+    // temporary objects referencing each other are not tracked so the order doesn't matter
+    for (MemoryObject *obj : m_temporaryObjects)
+    {
+        obj->releaseReferences();
+    }
+    destroyTemporaries();
+    if (m_frameStorage.has_value() && m_frameStorage->getUsedBytes() > m_frameBuffer.size())
+    {
+        // frame didn't fit into the buffer, so grow it to avoid going to the upstream allocator every frame
+        size_t used = m_frameStorage->getUsedBytes();
+        m_frameStorage.reset();
+        m_frameBuffer = std::vector<std::byte>(std::bit_ceil(used));
+    }
+    else if (m_frameStorage.has_value())
+    {
+        m_frameStorage->release();
+    }
+    // peaks are kept to show how much the heaviest frame needed
+    m_temporaryUsage.count = 0;
+    m_temporaryUsage.bytes = 0;
+}
+
+void Engine::GarbageCollector::destroyTemporaries()
+{
+    // memory itself belongs to the frame storage, so only destructors are called
+    for (MemoryObject *obj : m_temporaryObjects)
+    {
+        obj->~MemoryObject();
+    }
+    m_temporaryObjects.clear();
+}
+
+Engine::GarbageCollector::~GarbageCollector()
+{
+    for (MemoryObject *obj : m_temporaryObjects)
+    {
+        obj->dropReferences();
+    }
+    destroyTemporaries();
+    // everything is freed at once, so objects must not touch each other while being destroyed
+    for (MemoryObject *obj : m_objects)
+    {
+        obj->dropReferences();
+    }
+    // memory of the objects is not returned one by one, owner of the object storage gives all of its blocks back at once when destroying it
+    for (MemoryObject *obj : m_objects)
+    {
+        obj->~MemoryObject();
+    }
+}
+
+void Engine::GarbageCollector::registerObject(MemoryObject *obj, size_t allocationSize)
+{
+    obj->m_collector = this;
+#ifdef SIMPLEGAMETOOL_OBJECT_IDS
+    obj->m_id = m_nextObjectId++;
+#endif
+    obj->m_heapIndex = m_objects.size();
+    obj->m_allocationSize = (uint32_t)allocationSize;
+    obj->m_accountedSize = (uint32_t)obj->getAllocatedSize();
+    m_objects.push_back(obj);
+    // nothing references the object yet, so unless something starts using it it's garbage
+    addCandidate(obj);
+
+    m_statistics.allocationCount++;
+    m_statistics.allocatedBytes += obj->m_accountedSize;
+    m_statistics.liveBytes += obj->m_accountedSize;
+    m_usage.add(obj->m_accountedSize);
+    m_kindUsage[(size_t)obj->getKind()].add(obj->m_accountedSize);
+    m_allocatedSinceCollection += obj->m_accountedSize;
+    if (m_allocatedSinceCollection >= m_allocationBudget)
+    {
+        m_collecting = true;
+    }
+}
+
+void Engine::GarbageCollector::free(MemoryObject *obj)
+{
+    // swap with the last object to avoid shifting the whole list
+    MemoryObject *last = m_objects.back();
+    m_objects[obj->m_heapIndex] = last;
+    last->m_heapIndex = obj->m_heapIndex;
+    m_objects.pop_back();
+
+    m_statistics.freeCount++;
+    m_statistics.liveBytes -= obj->m_accountedSize;
+    m_usage.remove(obj->m_accountedSize);
+    m_kindUsage[(size_t)obj->getKind()].remove(obj->m_accountedSize);
+
+    size_t size = obj->m_allocationSize;
+    obj->~MemoryObject();
+    m_storage->deallocate(obj, size, alignof(std::max_align_t));
+}
@@ -0,0 +1,235 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <array>
+#include <type_traits>
+#include "MemoryStatistics.hpp"
+#include "FrameResource.hpp"
+#include "../Object/MemoryObject.hpp"
+#include "../Execution/Value.hpp"
+
+namespace Engine
+{
+    /// @brief Owner of all memory objects created by the scene.
+    /// Objects whose reference counter reaches zero are remembered as candidates and are only freed once enough memory has been allocated since the last collection.
+    /// Freeing is split into slices of limited size which are executed at safe points(end of function, end of frame) so that a single allocation heavy frame does not cause a long pause
+    class GarbageCollector
+    {
+    public:
+        /// @brief Create a new collector
+        /// @param storage Resource that objects and their contents are allocated from. Memory of objects alive at destruction of the collector is not given back one by one,
+        /// so resource must free everything at once when its owner is destroyed and must outlive the collector
+        explicit GarbageCollector(std::pmr::memory_resource *storage) : m_storage(storage) {}
+
+        GarbageCollector(GarbageCollector const &c) = delete;
+
+        void operator=(GarbageCollector const &c) = delete;
+
+        /// @brief Create a new object managed by this collector
+        /// @tparam T Type of the object
+        /// @param ...args Arguments passed to the constructor of the object
+        /// @return Pointer to the new object
+        template <class T, typename... Args>
+        T *create(Args &&...args)
+        {
+            return createSized<T>(sizeof(T), std::forward<Args>(args)...);
+        }
+
+        /// @brief Create a new object managed by this collector with extra memory reserved right after the object.
+        /// Used by objects that store variable amount of data inline to avoid a separate allocation
+        /// @tparam T Type of the object
+        /// @param size Total amount of bytes to reserve, must be at least the size of the object
+        /// @param ...args Arguments passed to the constructor of the object
+        /// @return Pointer to the new object
+        template <class T, typename... Args>
+        T *createSized(size_t size, Args &&...args)
+        {
+            static_assert(alignof(T) <= alignof(std::max_align_t));
+            void *mem = m_storage->allocate(size, alignof(std::max_align_t));
+            T *obj;
+            try
+            {
+                obj = construct<T>(mem, m_storage, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                m_storage->deallocate(mem, size, alignof(std::max_align_t));
+                throw;
+            }
+            registerObject(obj, size);
+            return obj;
+        }
+
+        /// @brief Create a new object in the frame storage. Such objects are not tracked by reference counting and are all freed together by `releaseTemporaries`,
+        /// so they must only be referenced from operation stacks, local variables and other temporary objects. Contents of objects that accept a memory resource are placed in the frame storage as well
+        /// @tparam T Type of the object
+        /// @param ...args Arguments passed to the constructor of the object
+        /// @return Pointer to the new object
+        template <class T, typename... Args>
+        T *createTemporary(Args &&...args)
+        {
+            if (!m_frameStorage.has_value())
+            {
+                m_frameStorage.emplace(m_frameBuffer.data(), m_frameBuffer.size(), m_temporaryUsage);
+            }
+            // frame storage never reuses memory before the release, so failed construction only wastes a few bytes until the end of the frame
+            T *obj = construct<T>(m_frameStorage->allocateObject(sizeof(T), alignof(T)), &m_frameStorage.value(), std::forward<Args>(args)...);
+            obj->m_collector = this;
+#ifdef SIMPLEGAMETOOL_OBJECT_IDS
+            obj->m_id = m_nextObjectId++;
+#endif
+            obj->m_temporary = true;
+            m_temporaryObjects.push_back(obj);
+            m_statistics.temporaryAllocationCount++;
+            return obj;
+        }
+
+        /// @brief Was the object allocated in the frame storage
+        static bool isTemporary(MemoryObject const *obj) { return obj->m_temporary; }
+
+        /// @brief Free every temporary object and reset the frame storage. Must only be called when no code is running
+        void releaseTemporaries();
+
+        /// @brief Get amount of temporary objects that are currently alive
+        size_t getTemporaryObjectCount() const { return m_temporaryObjects.size(); }
+
+        /// @brief Remember object as something that might be garbage. Called when reference counter of the object reaches zero
+        /// @param obj Object to remember
+        void addCandidate(MemoryObject *obj);
+
+        /// @brief Mark object referenced by the value as being used by something that does not affect the reference counter, like operation stack.
+        /// Marked objects are never freed during the next collection slice
+        /// @param val Value to check
+        void markRoot(Value const &val);
+
+        /// @brief Is there any collection work to do at the next safe point
+        bool isCollectionNeeded() const { return m_collecting; }
+
+        /// @brief Free up to slice size amount of dead objects that are not marked as roots. Clears all root marks afterwards
+        /// @return Amount of freed objects
+        size_t collect();
+
+        /// @brief Mark object referenced by the value and everything reachable from it as alive for the current tracing pass.
+        /// Should be called for every root before calling sweepUnreachable
+        /// @param val Value to mark
+        void markReachable(Value const &val);
+
+        /// @brief Free every object that was not reached by the tracing pass. Used to free reference cycles that reference counting can never free
+        /// @return Amount of freed objects
+        size_t sweepUnreachable();
+
+        /// @brief Should a tracing pass be run at the next safe point
+        bool isTraceNeeded() const { return m_traceInterval != 0 && m_statistics.collectionCount - m_lastTraceCollection >= m_traceInterval; }
+
+        /// @brief Set how many collection cycles have to be finished before next tracing pass is run. Zero disables tracing passes
+        void setTraceInterval(size_t cycles) { m_traceInterval = cycles; }
+
+        size_t getTraceInterval() const { return m_traceInterval; }
+
+        /// @brief Set amount of bytes that need to be allocated before new collection cycle starts
+        void setAllocationBudget(size_t bytes) { m_allocationBudget = bytes; }
+
+        size_t getAllocationBudget() const { return m_allocationBudget; }
+
+        /// @brief Set max amount of objects freed during one collection slice
+        void setSliceSize(size_t size) { m_sliceSize = size; }
+
+        size_t getSliceSize() const { return m_sliceSize; }
+
+        /// @brief Get amount of objects currently owned by the collector
+        size_t getObjectCount() const { return m_objects.size(); }
+
+        /// @brief Get all regular objects currently owned by the collector
+        std::vector<MemoryObject *> const &getObjects() const { return m_objects; }
+
+        /// @brief Get all temporary objects created since the last release
+        std::vector<MemoryObject *> const &getTemporaryObjects() const { return m_temporaryObjects; }
+
+        /// @brief Was the object created by this collector. Interned strings and objects of other scenes are not owned by the collector
+        bool owns(MemoryObject const *obj) const { return obj->m_collector == this; }
+
+        GarbageCollectorStatistics const &getStatistics() const { return m_statistics; }
+
+        /// @brief Measure the object again and move the difference into the usage. Used by objects that grow or shrink
+        void updateAccountedSize(MemoryObject *obj);
+
+        /// @brief Recalculate sizes of all objects. Catches sizes that changed without the object itself being modified, like arrays whose buffer stopped being shared
+        void updateAccountedSizes();
+
+        /// @brief Get amount of objects and bytes used by all objects owned by the collector
+        MemoryUsage const &getUsage() const { return m_usage; }
+
+        /// @brief Get amount of objects and bytes used by objects of the given kind
+        MemoryUsage const &getUsage(MemoryObjectKind kind) const { return m_kindUsage[(size_t)kind]; }
+
+        /// @brief Get amount of temporary objects and frame storage bytes used during the current frame
+        MemoryUsage const &getTemporaryUsage() const { return m_temporaryUsage; }
+
+        ~GarbageCollector();
+
+    private:
+        /// @brief Construct object in the given memory. Objects that can store their contents in a memory resource receive it as the first constructor argument
+        template <class T, typename... Args>
+        static T *construct(void *mem, std::pmr::memory_resource *resource, Args &&...args)
+        {
+            if constexpr (std::is_constructible_v<T, std::pmr::memory_resource *, Args...>)
+            {
+                return new (mem) T(resource, std::forward<Args>(args)...);
+            }
+            else
+            {
+                return new (mem) T(std::forward<Args>(args)...);
+            }
+        }
+
+        void registerObject(MemoryObject *obj, size_t allocationSize);
+
+        /// @brief Remove object from the list of the objects and release memory used by it
+        void free(MemoryObject *obj);
+
+        /// @brief Destroy all temporary objects without resetting the frame storage
+        void destroyTemporaries();
+
+        /// @brief Memory used for the object storage, owned by the scene
+        std::pmr::memory_resource *m_storage;
+        /// @brief Buffer used by the frame storage, grows if a single frame needs more memory than it has
+        std::vector<std::byte> m_frameBuffer = std::vector<std::byte>(16 * 1024);
+        /// @brief Bump allocator for temporary objects and their contents, created lazily since resource can't be moved once constructed
+        std::optional<FrameResource> m_frameStorage;
+        /// @brief All temporary objects created since last release
+        std::vector<MemoryObject *> m_temporaryObjects;
+        /// @brief All objects owned by this collector
+        std::vector<MemoryObject *> m_objects;
+        /// @brief Objects that had reference counter reach zero and might be freed
+        std::vector<MemoryObject *> m_candidates;
+        /// @brief Candidates that were still referenced by roots during the current cycle and will be checked during the next one
+        std::vector<MemoryObject *> m_deferredCandidates;
+        /// @brief Objects marked as referenced by roots during the current slice
+        std::vector<MemoryObject *> m_markedRoots;
+        /// @brief How many bytes were allocated since last collection cycle
+        size_t m_allocatedSinceCollection = 0;
+        size_t m_allocationBudget = 256 * 1024;
+        size_t m_sliceSize = 512;
+        /// @brief Is there currently an unfinished collection cycle
+        bool m_collecting = false;
+        /// @brief Objects that were marked as reachable, but whose references were not traced yet
+        std::vector<MemoryObject const *> m_traceStack;
+        /// @brief Are unreachable objects being freed right now. Unreachable objects are not queued as candidates during that time
+        bool m_sweeping = false;
+        size_t m_traceInterval = 8;
+        /// @brief Value of the collection counter during the last tracing pass
+        uint64_t m_lastTraceCollection = 0;
+
+        GarbageCollectorStatistics m_statistics;
+#ifdef SIMPLEGAMETOOL_OBJECT_IDS
+        /// @brief Id given to the next created object
+        uint64_t m_nextObjectId = 1;
+#endif
+        MemoryUsage m_usage;
+        std::array<MemoryUsage, (size_t)MemoryObjectKind::Count> m_kindUsage;
+        MemoryUsage m_temporaryUsage;
+    };
+}
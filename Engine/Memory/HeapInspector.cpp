@@ -0,0 +1,281 @@
+#include "HeapInspector.hpp"
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <algorithm>
+#include "../Scene.hpp"
+#include "../Object/ArrayObject.hpp"
+
+/// @brief Pass every value stored inside the object together with the name of the place it's stored at
+static void visitObjectReferences(Engine::MemoryObject const *obj, Engine::Scene const &scene, std::function<void(std::string const &, Engine::Value const &)> const &visitor)
+{
+    switch (obj->getKind())
+    {
+    case Engine::MemoryObjectKind::Array:
+    {
+        // items past the end of the array still belong to the buffer and are kept alive by it
+        std::pmr::vector<Engine::Value> const &values = static_cast<Engine::ArrayObject const *>(obj)->getBuffer()->values;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            visitor("[" + std::to_string(i) + "]", values[i]);
+        }
+        break;
+    }
+    case Engine::MemoryObjectKind::Map:
+    {
+        Engine::MapObject const *map = static_cast<Engine::MapObject const *>(obj);
+        // both lists are built by walking the slots in the same order, so keys and values line up
+        std::vector<Engine::Value> keys = map->getKeys();
+        std::vector<Engine::Value> values = map->getValues();
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            std::string key = Engine::valueToString(keys[i], scene);
+            visitor("key " + key, keys[i]);
+            visitor("[" + key + "]", values[i]);
+        }
+        break;
+    }
+    case Engine::MemoryObjectKind::Struct:
+    {
+        Engine::StructObject const *str = static_cast<Engine::StructObject const *>(obj);
+        std::span<Engine::Value const> fields = str->getFields();
+        for (size_t i = 0; i < fields.size(); i++)
+        {
+            visitor("." + str->getType()->getFieldName(i), fields[i]);
+        }
+        break;
+    }
+    default:
+        // strings and typed arrays only store plain data
+        break;
+    }
+}
+
+static std::string getObjectPreview(Engine::MemoryObject const *obj)
+{
+    switch (obj->getKind())
+    {
+    case Engine::MemoryObjectKind::String:
+    {
+        std::string_view str = static_cast<Engine::StringObject const *>(obj)->getString();
+        return str.size() > 32 ? std::string(str.substr(0, 32)) + "..." : std::string(str);
+    }
+    case Engine::MemoryObjectKind::Array:
+        return "length " + std::to_string(static_cast<Engine::ArrayObject const *>(obj)->getLength());
+    case Engine::MemoryObjectKind::TypedArray:
+        return "length " + std::to_string(static_cast<Engine::TypedArrayObject const *>(obj)->getLength());
+    case Engine::MemoryObjectKind::Map:
+        return "count " + std::to_string(static_cast<Engine::MapObject const *>(obj)->getCount());
+    case Engine::MemoryObjectKind::Struct:
+        return static_cast<Engine::StructObject const *>(obj)->getType()->getName();
+    default:
+        return "";
+    }
+}
+
+Engine::HeapSnapshot Engine::HeapInspector::takeSnapshot() const
+{
+    GarbageCollector const &collector = m_scene.getGarbageCollector();
+    std::vector<MemoryObject const *> objects(collector.getObjects().begin(), collector.getObjects().end());
+    objects.insert(objects.end(), collector.getTemporaryObjects().begin(), collector.getTemporaryObjects().end());
+
+    HeapSnapshot snapshot;
+    snapshot.objects.reserve(objects.size());
+    std::unordered_map<MemoryObject const *, size_t> indices;
+    for (MemoryObject const *obj : objects)
+    {
+        indices[obj] = snapshot.objects.size();
+        snapshot.objects.push_back(HeapObjectSnapshot{
+            .id = obj->getId(),
+            .kind = obj->getKind(),
+            .refCount = obj->getRefCount(),
+            .foundReferences = 0,
+            .size = obj->getAllocatedSize(),
+            .temporary = GarbageCollector::isTemporary(obj),
+            .retentionPath = {},
+            .preview = getObjectPreview(obj)});
+    }
+    auto findIndex = [&indices](Value const &v) -> std::optional<size_t>
+    {
+        if (auto it = indices.find(getValueMemoryObject(v)); it != indices.end())
+        {
+            return it->second;
+        }
+        return {};
+    };
+
+    // object is reached for the first time through the shortest path since the search goes breadth first
+    struct Parent
+    {
+        std::optional<size_t> object;
+        std::string name;
+    };
+    std::vector<std::optional<Parent>> parents(objects.size());
+    std::deque<size_t> queue;
+    auto reach = [&](std::optional<size_t> parent, std::string const &name, Value const &v)
+    {
+        std::optional<size_t> id = findIndex(v);
+        if (id.has_value() && !parents[id.value()].has_value())
+        {
+            parents[id.value()] = Parent{parent, name};
+            queue.push_back(id.value());
+        }
+    };
+
+    m_scene.visitRoots([&](std::string const &name, Value const &v, bool counted)
+                       {
+                           if (std::optional<size_t> id = findIndex(v); counted && id.has_value())
+                           {
+                               snapshot.objects[id.value()].foundReferences++;
+                           }
+                           reach({}, name, v); });
+
+    // arrays sharing a buffer hold only one reference to each item
+    std::unordered_set<ArrayBuffer const *> countedBuffers;
+    for (MemoryObject const *obj : objects)
+    {
+        if (obj->getKind() == MemoryObjectKind::Array && !countedBuffers.insert(static_cast<ArrayObject const *>(obj)->getBuffer()).second)
+        {
+            continue;
+        }
+        visitObjectReferences(obj, m_scene, [&](std::string const &, Value const &v)
+                              {
+                                  if (std::optional<size_t> id = findIndex(v); id.has_value())
+                                  {
+                                      snapshot.objects[id.value()].foundReferences++;
+                                  } });
+    }
+
+    while (!queue.empty())
+    {
+        size_t current = queue.front();
+        queue.pop_front();
+        visitObjectReferences(objects[current], m_scene, [&](std::string const &name, Value const &v)
+                              { reach(current, name, v); });
+    }
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        std::vector<std::string> &path = snapshot.objects[i].retentionPath;
+        for (std::optional<size_t> current = i; current.has_value() && parents[current.value()].has_value(); current = parents[current.value()]->object)
+        {
+            path.push_back(parents[current.value()]->name);
+        }
+        std::reverse(path.begin(), path.end());
+    }
+    return snapshot;
+}
+
+nlohmann::json Engine::HeapObjectSnapshot::toJson() const
+{
+    nlohmann::json json;
+    json["id"] = id;
+    json["kind"] = memoryObjectKindToString(kind);
+    json["refCount"] = refCount;
+    json["foundReferences"] = foundReferences;
+    json["size"] = size;
+    json["temporary"] = temporary;
+    json["retentionPath"] = retentionPath;
+    json["preview"] = preview;
+    return json;
+}
+
+nlohmann::json Engine::HeapSnapshot::toJson() const
+{
+    nlohmann::json json;
+    std::array<MemoryUsage, (size_t)MemoryObjectKind::Count> byKind;
+    MemoryUsage total;
+    nlohmann::json excess = nlohmann::json::array();
+    nlohmann::json orphaned = nlohmann::json::array();
+    nlohmann::json list = nlohmann::json::array();
+    for (HeapObjectSnapshot const &obj : objects)
+    {
+        total.add(obj.size);
+        byKind[(size_t)obj.kind].add(obj.size);
+        if (obj.hasExcessReferences())
+        {
+            excess.push_back(obj.id);
+        }
+        if (obj.isOrphaned())
+        {
+            orphaned.push_back(obj.id);
+        }
+        list.push_back(obj.toJson());
+    }
+    json["objectCount"] = total.count;
+    json["totalBytes"] = total.bytes;
+    for (size_t i = 0; i < byKind.size(); i++)
+    {
+        json["byKind"][memoryObjectKindToString((MemoryObjectKind)i)] = {{"count", byKind[i].count}, {"bytes", byKind[i].bytes}};
+    }
+    json["excessReferences"] = excess;
+    json["orphaned"] = orphaned;
+    json["objects"] = list;
+    return json;
+}
+
+nlohmann::json Engine::HeapInspector::diffWithBaseline() const
+{
+    return diff(m_baseline.value_or(HeapSnapshot{}), takeSnapshot());
+}
+
+nlohmann::json Engine::HeapInspector::diff(HeapSnapshot const &before, HeapSnapshot const &after)
+{
+    std::unordered_map<uint64_t, HeapObjectSnapshot const *> previous;
+    for (HeapObjectSnapshot const &obj : before.objects)
+    {
+        previous[obj.id] = &obj;
+    }
+
+    int64_t countDelta = (int64_t)after.objects.size() - (int64_t)before.objects.size();
+    int64_t bytesDelta = 0;
+    std::array<std::pair<int64_t, int64_t>, (size_t)MemoryObjectKind::Count> byKind{};
+    for (HeapObjectSnapshot const &obj : before.objects)
+    {
+        bytesDelta -= obj.size;
+        byKind[(size_t)obj.kind].first--;
+        byKind[(size_t)obj.kind].second -= obj.size;
+    }
+    // new objects are grouped by the root that keeps them alive, since growth usually comes from a single container
+    std::map<std::string, std::pair<uint64_t, uint64_t>> byRoot;
+    nlohmann::json added = nlohmann::json::array();
+    nlohmann::json grown = nlohmann::json::array();
+    for (HeapObjectSnapshot const &obj : after.objects)
+    {
+        bytesDelta += obj.size;
+        byKind[(size_t)obj.kind].first++;
+        byKind[(size_t)obj.kind].second += obj.size;
+        auto it = previous.find(obj.id);
+        // ids can be addresses reused by new objects, which are told apart at least when they are of a different kind
+        if (it == previous.end() || it->second->kind != obj.kind)
+        {
+            std::string root = obj.isReachable() ? obj.retentionPath.front() : (obj.isOrphaned() ? "<orphaned>" : "<garbage>");
+            byRoot[root].first++;
+            byRoot[root].second += obj.size;
+            added.push_back(obj.toJson());
+        }
+        else if (obj.size > it->second->size)
+        {
+            nlohmann::json json = obj.toJson();
+            json["previousSize"] = it->second->size;
+            grown.push_back(json);
+        }
+    }
+
+    nlohmann::json json;
+    json["addedByRoot"] = nlohmann::json::object();
+    json["countDelta"] = countDelta;
+    json["bytesDelta"] = bytesDelta;
+    for (size_t i = 0; i < byKind.size(); i++)
+    {
+        json["byKind"][memoryObjectKindToString((MemoryObjectKind)i)] = {{"countDelta", byKind[i].first}, {"bytesDelta", byKind[i].second}};
+    }
+    for (auto const &[root, usage] : byRoot)
+    {
+        json["addedByRoot"][root] = {{"count", usage.first}, {"bytes", usage.second}};
+    }
+    json["added"] = added;
+    json["grown"] = grown;
+    return json;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "MemoryStatistics.hpp"
+
+namespace Engine
+{
+    class Scene;
+    class MemoryObject;
+
+    /// @brief State of a single managed object at the moment the snapshot was taken
+    struct HeapObjectSnapshot
+    {
+        /// @brief Id of the object, stays the same between snapshots. Unless built with SIMPLEGAMETOOL_OBJECT_IDS this is the address of the object, so a new object can have the id of a freed one
+        uint64_t id;
+        MemoryObjectKind kind;
+        int32_t refCount;
+        /// @brief Amount of references that count towards reference counter found in roots and other objects.
+        /// Should always be equal to the reference counter, higher counter means that something increased it without ever decreasing it
+        int32_t foundReferences;
+        size_t size;
+        bool temporary;
+        /// @brief Shortest chain of references from a root to the object, empty if object can't be reached from any root
+        std::vector<std::string> retentionPath;
+        /// @brief Short text representation of the object
+        std::string preview;
+
+        /// @brief Was the reference counter increased more times than there are references to the object
+        bool hasExcessReferences() const { return !temporary && refCount > foundReferences; }
+
+        /// @brief Can the object be reached from any root
+        bool isReachable() const { return !retentionPath.empty(); }
+
+        /// @brief Is the object kept alive by its reference counter even though no root can reach it, which means it's either in a cycle or has leaked references.
+        /// Unreachable objects without references are just garbage waiting for the next collection
+        bool isOrphaned() const { return !temporary && refCount > 0 && retentionPath.empty(); }
+
+        nlohmann::json toJson() const;
+    };
+
+    /// @brief All managed objects of a scene at some point in time
+    struct HeapSnapshot
+    {
+        std::vector<HeapObjectSnapshot> objects;
+
+        nlohmann::json toJson() const;
+    };
+
+    /// @brief Debugging tool for finding memory growth and broken reference counting.
+    /// Snapshots are expensive since they walk the whole heap, so they are meant to be taken on demand rather than every frame
+    class HeapInspector
+    {
+    public:
+        explicit HeapInspector(Scene const &scene) : m_scene(scene) {}
+
+        /// @brief Capture every managed object of the scene together with retention paths and reference counting problems
+        /// @return Snapshot of the heap
+        HeapSnapshot takeSnapshot() const;
+
+        /// @brief Remember current state of the heap so that it could later be compared against
+        void markBaseline() { m_baseline = takeSnapshot(); }
+
+        bool hasBaseline() const { return m_baseline.has_value(); }
+
+        /// @brief Compare current state of the heap with the baseline or with an empty heap if no baseline was marked
+        /// @return Json description of the difference
+        nlohmann::json diffWithBaseline() const;
+
+        /// @brief Compare two snapshots to find which objects were created or grew between them
+        /// @param before Earlier snapshot
+        /// @param after Later snapshot
+        /// @return Json description of the difference
+        static nlohmann::json diff(HeapSnapshot const &before, HeapSnapshot const &after);
+
+    private:
+        Scene const &m_scene;
+        std::optional<HeapSnapshot> m_baseline;
+    };
+}
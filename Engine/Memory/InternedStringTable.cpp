@@ -0,0 +1,10 @@
+#include "InternedStringTable.hpp"
+
+Engine::InternedStringTable::InternedStringTable(std::vector<std::string> const &strings) : m_texts(strings)
+{
+    m_strings.reserve(strings.size());
+    for (std::string const &str : strings)
+    {
+        m_strings.push_back(std::make_unique<StringObject>(str, true));
+    }
+}
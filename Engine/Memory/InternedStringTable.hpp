@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include "../Object/MemoryObject.hpp"
+
+namespace Engine
+{
+    /// @brief Immortal string objects created from the constant strings of a single code unit(scene or type).
+    /// Strings are created once when code is loaded and are shared by every instruction that uses them, so using a string literal never allocates
+    class InternedStringTable
+    {
+    public:
+        explicit InternedStringTable(std::vector<std::string> const &strings);
+
+        bool has(size_t id) const { return id < m_strings.size(); }
+
+        /// @brief Get string object for the constant with given id
+        /// @param id Id of the string in the constant table
+        /// @return String object, which is never freed while the table is alive
+        StringObject *get(size_t id) const { return m_strings.at(id).get(); }
+
+        /// @brief Get text of the constant with given id as a native string, used for looking up things by name
+        std::string const &getText(size_t id) const { return m_texts.at(id); }
+
+        size_t getCount() const { return m_strings.size(); }
+
+    private:
+        std::vector<std::unique_ptr<StringObject>> m_strings;
+        std::vector<std::string> m_texts;
+    };
+}
@@ -0,0 +1,69 @@
+#include "MemoryStatistics.hpp"
+#include <iomanip>
+
+std::string Engine::memoryObjectKindToString(MemoryObjectKind kind)
+{
+    switch (kind)
+    {
+    case MemoryObjectKind::String:
+        return "String";
+    case MemoryObjectKind::Array:
+        return "Array";
+    case MemoryObjectKind::TypedArray:
+        return "TypedArray";
+    case MemoryObjectKind::Map:
+        return "Map";
+    case MemoryObjectKind::Struct:
+        return "Struct";
+    default:
+        return "Unknown";
+    }
+}
+
+static void printUsage(std::ostream &out, std::string const &name, Engine::MemoryUsage const &usage)
+{
+    out << "  " << std::left << std::setw(24) << name << std::right
+        << std::setw(10) << usage.count << " live " << std::setw(12) << usage.bytes << " B"
+        << "  (peak " << usage.peakCount << " / " << usage.peakBytes << " B)" << std::endl;
+}
+
+void Engine::MemoryReport::print(std::ostream &out) const
+{
+    out << "Managed memory";
+    if (budget != 0)
+    {
+        out << " (budget " << budget << " B" << (managed.bytes > budget ? ", EXCEEDED" : "") << ")";
+    }
+    out << ":" << std::endl;
+    printUsage(out, "total", managed);
+    for (size_t i = 0; i < managedByKind.size(); i++)
+    {
+        printUsage(out, memoryObjectKindToString((MemoryObjectKind)i), managedByKind[i]);
+    }
+    printUsage(out, "temporary", temporary);
+    out << "Garbage collector (budget " << collectionBudget << " B, slice " << collectionSliceSize << " objects):" << std::endl;
+    out << "  allocated " << collector.allocationCount << " objects / " << collector.allocatedBytes << " B, freed " << collector.freeCount << " objects" << std::endl;
+    out << "  " << collector.collectionCount << " cycles, pause last " << collector.lastPauseMicroseconds << " us, max " << collector.maxPauseMicroseconds
+        << " us, total " << collector.totalPauseMicroseconds << " us" << std::endl;
+    out << "  " << collector.temporaryAllocationCount << " temporary objects, " << collector.lastFrameTemporaryCount << " in the last frame" << std::endl;
+    out << "  " << collector.traceCount << " tracing passes ";
+    if (traceInterval != 0)
+    {
+        out << "(every " << traceInterval << " cycles)";
+    }
+    else
+    {
+        out << "(disabled)";
+    }
+    out << ", freed " << collector.lastTraceFreeCount << " objects in the last one, " << collector.traceFreeCount << " in total" << std::endl;
+    out << "Game objects:" << std::endl;
+    printUsage(out, "total", gameObjects);
+    for (auto const &[type, usage] : gameObjectsByType)
+    {
+        printUsage(out, type, usage);
+    }
+    out << "Content:" << std::endl;
+    printUsage(out, "textures", content.textures);
+    printUsage(out, "sounds", content.sounds);
+    printUsage(out, "fonts", content.fonts);
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <ostream>
+
+namespace Engine
+{
+    /// @brief Amount and size of live allocations of a single kind together with the highest values they ever reached
+    struct MemoryUsage
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+        uint64_t peakCount = 0;
+        uint64_t peakBytes = 0;
+
+        /// @brief Record a new allocation
+        void add(size_t size)
+        {
+            count++;
+            bytes += size;
+            peakCount = std::max(peakCount, count);
+            peakBytes = std::max(peakBytes, bytes);
+        }
+
+        /// @brief Record that an allocation was freed
+        void remove(size_t size)
+        {
+            count--;
+            bytes -= size;
+        }
+
+        /// @brief Record that size of an existing allocation changed
+        void resize(size_t oldSize, size_t newSize)
+        {
+            bytes = bytes - oldSize + newSize;
+            peakBytes = std::max(peakBytes, bytes);
+        }
+    };
+
+    /// @brief Kinds of objects managed by the garbage collector
+    enum class MemoryObjectKind
+    {
+        String,
+        Array,
+        TypedArray,
+        Map,
+        Struct,
+        // not an actual kind, used as the amount of kinds
+        Count
+    };
+
+    std::string memoryObjectKindToString(MemoryObjectKind kind);
+
+    /// @brief Numbers describing work done by the garbage collector
+    struct GarbageCollectorStatistics
+    {
+        /// @brief Total amount of objects created since the collector was created
+        uint64_t allocationCount = 0;
+        /// @brief Total amount of objects freed since the collector was created
+        uint64_t freeCount = 0;
+        /// @brief Total amount of bytes allocated since the collector was created
+        uint64_t allocatedBytes = 0;
+        /// @brief Amount of bytes used by the objects that are currently alive
+        uint64_t liveBytes = 0;
+        /// @brief Amount of finished collection cycles
+        uint64_t collectionCount = 0;
+        /// @brief Time spent in the last collection slice in microseconds
+        uint64_t lastPauseMicroseconds = 0;
+        /// @brief Longest time spent in a single collection slice in microseconds
+        uint64_t maxPauseMicroseconds = 0;
+        /// @brief Time spent collecting garbage in total in microseconds
+        uint64_t totalPauseMicroseconds = 0;
+        /// @brief Amount of tracing passes that were run to find reference cycles
+        uint64_t traceCount = 0;
+        /// @brief Amount of objects freed by the last tracing pass
+        uint64_t lastTraceFreeCount = 0;
+        /// @brief Total amount of objects freed by tracing passes
+        uint64_t traceFreeCount = 0;
+        /// @brief Total amount of temporary objects created in the frame storage
+        uint64_t temporaryAllocationCount = 0;
+        /// @brief Amount of temporary objects created during the last finished frame
+        uint64_t lastFrameTemporaryCount = 0;
+    };
+
+    /// @brief Memory used by the loaded assets. Assets are never unloaded, so peaks are the same as current values
+    struct ContentMemoryUsage
+    {
+        MemoryUsage textures;
+        MemoryUsage sounds;
+        MemoryUsage fonts;
+    };
+
+    /// @brief Snapshot of all memory used by a scene
+    struct MemoryReport
+    {
+        /// @brief All objects managed by the garbage collector
+        MemoryUsage managed;
+        /// @brief Managed objects split by kind
+        std::array<MemoryUsage, (size_t)MemoryObjectKind::Count> managedByKind;
+        /// @brief Temporary objects created in the frame storage during the current frame
+        MemoryUsage temporary;
+        /// @brief All game objects of the scene
+        MemoryUsage gameObjects;
+        /// @brief Game objects split by the name of their type
+        std::map<std::string, MemoryUsage> gameObjectsByType;
+        ContentMemoryUsage content;
+        /// @brief Max amount of managed bytes the scene is allowed to use, zero if there is no limit
+        uint64_t budget = 0;
+        /// @brief Work done by the garbage collector of the scene
+        GarbageCollectorStatistics collector;
+        /// @brief Amount of bytes allocated between collection cycles
+        uint64_t collectionBudget = 0;
+        /// @brief Max amount of objects freed during one collection slice
+        uint64_t collectionSliceSize = 0;
+        /// @brief Amount of collection cycles between tracing passes, zero if tracing passes are disabled
+        uint64_t traceInterval = 0;
+
+        /// @brief Write human readable version of the report
+        /// @param out Stream to write to
+        void print(std::ostream &out) const;
+    };
+}
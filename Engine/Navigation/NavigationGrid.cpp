@@ -0,0 +1,236 @@
+#include "NavigationGrid.hpp"
+#include <cmath>
+#include <algorithm>
+
+Engine::NavigationGrid::NavigationGrid(sf::Vector2f origin, sf::Vector2i size, float cellSize)
+    : m_origin(origin), m_cellSize(cellSize), m_cells(std::make_shared<NavigationCells>())
+{
+    m_cells->width = std::max(size.x, 0);
+    m_cells->height = std::max(size.y, 0);
+    m_cells->blocked.assign((size_t)m_cells->width * m_cells->height, 0);
+}
+
+sf::Vector2i Engine::NavigationGrid::getCell(sf::Vector2f position) const
+{
+    return sf::Vector2i((int32_t)std::floor((position.x - m_origin.x) / m_cellSize), (int32_t)std::floor((position.y - m_origin.y) / m_cellSize));
+}
+
+sf::Vector2f Engine::NavigationGrid::getCellCenter(sf::Vector2i cell) const
+{
+    return m_origin + sf::Vector2f(((float)cell.x + 0.5f) * m_cellSize, ((float)cell.y + 0.5f) * m_cellSize);
+}
+
+void Engine::NavigationGrid::setBlocked(sf::Vector2i cell, bool blocked)
+{
+    if (!m_cells->isInside(cell.x, cell.y) || isBlocked(cell) == blocked)
+    {
+        return;
+    }
+    getWritableCells().blocked[m_cells->getIndex(cell)] = blocked ? 1 : 0;
+    invalidate(cell, blocked);
+}
+
+void Engine::NavigationGrid::setAreaBlocked(sf::FloatRect const &area, bool blocked)
+{
+    float left = std::min(area.position.x, area.position.x + area.size.x);
+    float right = std::max(area.position.x, area.position.x + area.size.x);
+    float top = std::min(area.position.y, area.position.y + area.size.y);
+    float bottom = std::max(area.position.y, area.position.y + area.size.y);
+    // cells that only touch the edge of the area are left as they are
+    int32_t minX = std::max((int32_t)std::floor((left - m_origin.x) / m_cellSize), 0);
+    int32_t minY = std::max((int32_t)std::floor((top - m_origin.y) / m_cellSize), 0);
+    int32_t maxX = std::min((int32_t)std::ceil((right - m_origin.x) / m_cellSize) - 1, m_cells->width - 1);
+    int32_t maxY = std::min((int32_t)std::ceil((bottom - m_origin.y) / m_cellSize) - 1, m_cells->height - 1);
+    for (int32_t y = minY; y <= maxY; y++)
+    {
+        for (int32_t x = minX; x <= maxX; x++)
+        {
+            setBlocked(sf::Vector2i(x, y), blocked);
+        }
+    }
+}
+
+std::optional<std::vector<sf::Vector2f>> Engine::NavigationGrid::findPath(sf::Vector2f from, sf::Vector2f to, PathAlgorithm algorithm)
+{
+    sf::Vector2i start = getCell(from);
+    sf::Vector2i goal = getCell(to);
+    // both algorithms find paths of the same length, so paths found by either can be reused by both
+    auto cached = std::find_if(m_paths.begin(), m_paths.end(), [start, goal](CachedPath const &path)
+                               { return path.start == start && path.goal == goal; });
+    if (cached == m_paths.end())
+    {
+        std::optional<std::vector<sf::Vector2i>> cells = m_search.findPath(*m_cells, start, goal, algorithm);
+        CachedPath path{.start = start, .goal = goal, .length = {}, .cells = {}};
+        if (cells.has_value())
+        {
+            float length = 0.f;
+            for (size_t i = 1; i < cells->size(); i++)
+            {
+                length += getOctileDistance(cells.value()[i - 1], cells.value()[i]);
+            }
+            path.length = length;
+            path.cells = std::move(cells.value());
+        }
+        if (m_paths.size() < MaxCachedPaths)
+        {
+            m_paths.push_back(std::move(path));
+            cached = m_paths.end() - 1;
+        }
+        else
+        {
+            m_paths[m_nextPathSlot] = std::move(path);
+            cached = m_paths.begin() + m_nextPathSlot;
+            m_nextPathSlot = (m_nextPathSlot + 1) % MaxCachedPaths;
+        }
+    }
+    if (!cached->length.has_value())
+    {
+        return {};
+    }
+    return getCellCenters(cached->cells);
+}
+
+sf::Vector2f Engine::NavigationGrid::getFlowDirection(sf::Vector2f target, sf::Vector2f position)
+{
+    sf::Vector2i targetCell = getCell(target);
+    auto it = std::find_if(m_flowFields.begin(), m_flowFields.end(), [targetCell](CachedFlowField const &field)
+                           { return field.field.getTarget() == targetCell; });
+    if (it == m_flowFields.end())
+    {
+        CachedFlowField field{.field = FlowField(*m_cells, targetCell), .dirty = false, .lastUse = 0};
+        if (m_flowFields.size() < MaxFlowFields)
+        {
+            m_flowFields.push_back(std::move(field));
+            it = m_flowFields.end() - 1;
+        }
+        else
+        {
+            it = std::min_element(m_flowFields.begin(), m_flowFields.end(), [](CachedFlowField const &a, CachedFlowField const &b)
+                                  { return a.lastUse < b.lastUse; });
+            *it = std::move(field);
+        }
+    }
+    else if (it->dirty)
+    {
+        it->field.build(*m_cells);
+        it->dirty = false;
+    }
+    it->lastUse = ++m_useCounter;
+    sf::Vector2i cell = getCell(position);
+    std::optional<sf::Vector2i> step = it->field.getDirection(*m_cells, cell);
+    if (!step.has_value())
+    {
+        return sf::Vector2f();
+    }
+    sf::Vector2f offset = getCellCenter(cell + step.value()) - position;
+    float length = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+    return length > 0.f ? offset / length : sf::Vector2f();
+}
+
+uint64_t Engine::NavigationGrid::requestPath(sf::Vector2f from, sf::Vector2f to, PathAlgorithm algorithm)
+{
+    if (m_worker == nullptr)
+    {
+        m_worker = std::make_unique<NavigationWorker>();
+    }
+    uint64_t id = m_nextRequest++;
+    m_cellsShared = true;
+    m_worker->push(PathJob{.id = id, .cells = m_cells, .start = getCell(from), .goal = getCell(to), .algorithm = algorithm});
+    return id;
+}
+
+std::vector<Engine::FinishedPath> Engine::NavigationGrid::takeFinishedPaths()
+{
+    std::vector<FinishedPath> paths;
+    if (m_worker == nullptr)
+    {
+        return paths;
+    }
+    for (PathJobResult const &result : m_worker->takeFinished())
+    {
+        FinishedPath path{.request = result.id, .points = {}};
+        if (result.cells.has_value())
+        {
+            path.points = getCellCenters(result.cells.value());
+        }
+        paths.push_back(std::move(path));
+    }
+    return paths;
+}
+
+Engine::NavigationCells &Engine::NavigationGrid::getWritableCells()
+{
+    // cells given to the worker are never written to again, even once the worker is done with them, since checking that would need synchronization
+    if (m_cellsShared)
+    {
+        m_cells = std::make_shared<NavigationCells>(*m_cells);
+        m_cellsShared = false;
+    }
+    return *m_cells;
+}
+
+void Engine::NavigationGrid::invalidate(sf::Vector2i cell, bool blocked)
+{
+    if (blocked)
+    {
+        // path becomes invalid if it goes through the cell or cuts the corner that the cell now forms
+        std::erase_if(m_paths, [cell](CachedPath const &path)
+                      {
+                          for (size_t i = 0; i < path.cells.size(); i++)
+                          {
+                              sf::Vector2i current = path.cells[i];
+                              if (current == cell)
+                              {
+                                  return true;
+                              }
+                              if (i > 0)
+                              {
+                                  sf::Vector2i previous = path.cells[i - 1];
+                                  if (sf::Vector2i(current.x, previous.y) == cell || sf::Vector2i(previous.x, current.y) == cell)
+                                  {
+                                      return true;
+                                  }
+                              }
+                          }
+                          return false; });
+    }
+    else
+    {
+        // freed cell can only make a path shorter if going past it is shorter than the path, unreachable goals may become reachable
+        std::erase_if(m_paths, [cell](CachedPath const &path)
+                      { return !path.length.has_value() || getOctileDistance(path.start, cell) + getOctileDistance(cell, path.goal) - 1.f < path.length.value(); });
+    }
+    m_nextPathSlot = 0;
+
+    for (CachedFlowField &field : m_flowFields)
+    {
+        if (field.dirty)
+        {
+            continue;
+        }
+        if (blocked)
+        {
+            // cell that could not reach the target was not part of any route
+            field.dirty = field.field.getDistance(*m_cells, cell).has_value();
+            continue;
+        }
+        for (int32_t y = -1; y <= 1 && !field.dirty; y++)
+        {
+            for (int32_t x = -1; x <= 1 && !field.dirty; x++)
+            {
+                field.dirty = field.field.getDistance(*m_cells, cell + sf::Vector2i(x, y)).has_value() || cell == field.field.getTarget();
+            }
+        }
+    }
+}
+
+std::vector<sf::Vector2f> Engine::NavigationGrid::getCellCenters(std::vector<sf::Vector2i> const &cells) const
+{
+    std::vector<sf::Vector2f> points;
+    points.reserve(cells.size());
+    for (sf::Vector2i const &cell : cells)
+    {
+        points.push_back(getCellCenter(cell));
+    }
+    return points;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "PathSearch.hpp"
+#include "NavigationWorker.hpp"
+
+namespace Engine
+{
+    /// @brief Path found by a background search
+    struct FinishedPath
+    {
+        uint64_t request;
+        /// @brief Centers of the cells of the path or nothing if goal could not be reached
+        std::optional<std::vector<sf::Vector2f>> points;
+    };
+
+    /// @brief Grid of walkable and blocked cells covering a rectangular part of the world, used to find paths for moving agents.
+    /// Found paths and flow fields are cached and only the ones that are affected by changed cells are thrown away
+    class NavigationGrid
+    {
+    public:
+        /// @brief Create grid where every cell is walkable
+        /// @param origin World position of the top left corner of the grid
+        /// @param size Amount of cells along each axis
+        /// @param cellSize Width and height of a single cell
+        explicit NavigationGrid(sf::Vector2f origin, sf::Vector2i size, float cellSize);
+
+        sf::Vector2i getSize() const { return sf::Vector2i(m_cells->width, m_cells->height); }
+
+        float getCellSize() const { return m_cellSize; }
+
+        /// @brief Get cell that contains the world position, cell may be outside of the grid
+        sf::Vector2i getCell(sf::Vector2f position) const;
+
+        sf::Vector2f getCellCenter(sf::Vector2i cell) const;
+
+        /// @brief Check if cell can't be entered, cells outside of the grid are always blocked
+        bool isBlocked(sf::Vector2i cell) const { return !m_cells->isWalkable(cell.x, cell.y); }
+
+        /// @brief Change walkability of a single cell, cells outside of the grid are ignored
+        void setBlocked(sf::Vector2i cell, bool blocked);
+
+        /// @brief Change walkability of every cell that overlaps the area
+        void setAreaBlocked(sf::FloatRect const &area, bool blocked);
+
+        /// @brief Find shortest path between cells containing the given positions
+        /// @return Centers of every cell of the path or nothing if there is no path
+        std::optional<std::vector<sf::Vector2f>> findPath(sf::Vector2f from, sf::Vector2f to, PathAlgorithm algorithm);
+
+        /// @brief Get direction in which an agent standing at the position should move to reach the target by the shortest path.
+        /// Distances to the target are calculated once and reused by every agent going to the same cell
+        /// @return Normalized direction towards the center of the next cell or zero vector if position is at the target or can't reach it
+        sf::Vector2f getFlowDirection(sf::Vector2f target, sf::Vector2f position);
+
+        /// @brief Start searching for a path on the worker thread
+        /// @return Id of the request used to identify the result
+        uint64_t requestPath(sf::Vector2f from, sf::Vector2f to, PathAlgorithm algorithm);
+
+        /// @brief Get every background search that finished since the last call in the order they were requested
+        std::vector<FinishedPath> takeFinishedPaths();
+
+        size_t getCachedPathCount() const { return m_paths.size(); }
+
+        size_t getFlowFieldCount() const { return m_flowFields.size(); }
+
+        static constexpr size_t MaxCachedPaths = 64;
+
+        static constexpr size_t MaxFlowFields = 8;
+
+    private:
+        struct CachedPath
+        {
+            sf::Vector2i start;
+            sf::Vector2i goal;
+            /// @brief Length of the path in cells, nothing if goal was unreachable
+            std::optional<float> length;
+            std::vector<sf::Vector2i> cells;
+        };
+
+        struct CachedFlowField
+        {
+            FlowField field;
+            /// @brief Field has to be rebuilt before use since cells it depends on were changed
+            bool dirty;
+            uint64_t lastUse;
+        };
+
+        /// @brief Get cells for modification, copying them first if a background search still reads them
+        NavigationCells &getWritableCells();
+
+        /// @brief Throw away cached results that are no longer correct after the cell changed
+        void invalidate(sf::Vector2i cell, bool blocked);
+
+        std::vector<sf::Vector2f> getCellCenters(std::vector<sf::Vector2i> const &cells) const;
+
+        sf::Vector2f m_origin;
+        float m_cellSize;
+        std::shared_ptr<NavigationCells> m_cells;
+        /// @brief Current cells were given to a background search and have to be copied before changing
+        bool m_cellsShared = false;
+        PathSearch m_search;
+        std::vector<CachedPath> m_paths;
+        /// @brief Slot of the path cache that will be replaced next once the cache is full
+        size_t m_nextPathSlot = 0;
+        std::vector<CachedFlowField> m_flowFields;
+        uint64_t m_useCounter = 0;
+        uint64_t m_nextRequest = 0;
+        /// @brief Worker is only started once the first background search is requested
+        std::unique_ptr<NavigationWorker> m_worker;
+    };
+}
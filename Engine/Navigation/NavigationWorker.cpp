@@ -0,0 +1,62 @@
+#include "NavigationWorker.hpp"
+
+Engine::NavigationWorker::NavigationWorker() : m_thread(&NavigationWorker::run, this)
+{
+}
+
+Engine::NavigationWorker::~NavigationWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void Engine::NavigationWorker::push(PathJob job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+std::vector<Engine::PathJobResult> Engine::NavigationWorker::takeFinished()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<PathJobResult> finished = std::move(m_finished);
+    m_finished.clear();
+    return finished;
+}
+
+size_t Engine::NavigationWorker::getPendingCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size() + m_running;
+}
+
+void Engine::NavigationWorker::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait(lock, [this]()
+                         { return m_stopping || !m_jobs.empty(); });
+        if (m_stopping)
+        {
+            return;
+        }
+        PathJob job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_running++;
+        // search runs without the lock so that main thread can keep pushing jobs and taking results
+        lock.unlock();
+        std::optional<std::vector<sf::Vector2i>> path = m_search.findPath(*job.cells, job.start, job.goal, job.algorithm);
+        job.cells.reset();
+        lock.lock();
+        m_running--;
+        m_finished.push_back(PathJobResult{job.id, std::move(path)});
+    }
+}
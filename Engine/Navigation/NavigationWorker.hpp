@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "PathSearch.hpp"
+
+namespace Engine
+{
+    /// @brief Path search requested to run in the background
+    struct PathJob
+    {
+        uint64_t id;
+        /// @brief Cells as they were when the search was requested, grid copies cells before changing them while a job still uses them
+        std::shared_ptr<NavigationCells const> cells;
+        sf::Vector2i start;
+        sf::Vector2i goal;
+        PathAlgorithm algorithm;
+    };
+
+    struct PathJobResult
+    {
+        uint64_t id;
+        /// @brief Found path or nothing if goal could not be reached
+        std::optional<std::vector<sf::Vector2i>> cells;
+    };
+
+    /// @brief Thread that runs path searches one by one in the order they were requested, so that long searches don't stall the frame
+    class NavigationWorker
+    {
+    public:
+        explicit NavigationWorker();
+
+        /// @brief Stop the thread, jobs that didn't start yet are dropped
+        ~NavigationWorker();
+
+        NavigationWorker(NavigationWorker const &) = delete;
+
+        NavigationWorker &operator=(NavigationWorker const &) = delete;
+
+        void push(PathJob job);
+
+        /// @brief Get results of every job that finished since the last call, in the order jobs were pushed
+        std::vector<PathJobResult> takeFinished();
+
+        /// @brief Get amount of jobs that were pushed but did not finish yet
+        size_t getPendingCount();
+
+    private:
+        void run();
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<PathJob> m_jobs;
+        std::vector<PathJobResult> m_finished;
+        /// @brief Amount of jobs that were taken from the queue but are still being searched
+        size_t m_running = 0;
+        bool m_stopping = false;
+        /// @brief Search buffers used only by the worker thread
+        PathSearch m_search;
+        /// @brief Declared last so that everything the thread uses already exists when it starts
+        std::thread m_thread;
+    };
+}
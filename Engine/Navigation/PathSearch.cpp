@@ -0,0 +1,320 @@
+#include "PathSearch.hpp"
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <algorithm>
+#include <functional>
+
+static constexpr sf::Vector2i Neighbours[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+
+static int32_t sign(int32_t value)
+{
+    return (value > 0) - (value < 0);
+}
+
+bool Engine::NavigationCells::canMove(int32_t x, int32_t y, int32_t dx, int32_t dy) const
+{
+    if (!isWalkable(x + dx, y + dy))
+    {
+        return false;
+    }
+    return dx == 0 || dy == 0 || (isWalkable(x + dx, y) && isWalkable(x, y + dy));
+}
+
+float Engine::getOctileDistance(sf::Vector2i a, sf::Vector2i b)
+{
+    int32_t dx = std::abs(a.x - b.x);
+    int32_t dy = std::abs(a.y - b.y);
+    return (float)std::max(dx, dy) + (std::numbers::sqrt2_v<float> - 1.f) * (float)std::min(dx, dy);
+}
+
+std::optional<std::vector<sf::Vector2i>> Engine::PathSearch::findPath(NavigationCells const &cells, sf::Vector2i start, sf::Vector2i goal, PathAlgorithm algorithm)
+{
+    m_expandedCount = 0;
+    if (!cells.isWalkable(start.x, start.y) || !cells.isWalkable(goal.x, goal.y))
+    {
+        return {};
+    }
+    size_t cellCount = (size_t)cells.width * cells.height;
+    if (m_reached.size() != cellCount)
+    {
+        m_distances.assign(cellCount, 0.f);
+        m_parents.assign(cellCount, 0);
+        m_reached.assign(cellCount, 0);
+        m_closed.assign(cellCount, 0);
+        m_searchId = 0;
+    }
+    // stamps would start matching old searches again after wrapping around
+    if (++m_searchId == 0)
+    {
+        std::fill(m_reached.begin(), m_reached.end(), 0);
+        std::fill(m_closed.begin(), m_closed.end(), 0);
+        m_searchId = 1;
+    }
+    m_open.clear();
+    uint32_t startIndex = cells.getIndex(start);
+    uint32_t goalIndex = cells.getIndex(goal);
+    relax(cells, startIndex, startIndex, 0.f, goal);
+    while (!m_open.empty())
+    {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<OpenNode>());
+        uint32_t current = m_open.back().cell;
+        m_open.pop_back();
+        // cells are pushed again when a shorter route is found instead of updating the heap, older entries are skipped here
+        if (m_closed[current] == m_searchId)
+        {
+            continue;
+        }
+        m_closed[current] = m_searchId;
+        m_expandedCount++;
+        if (current == goalIndex)
+        {
+            return buildPath(cells, goalIndex);
+        }
+        sf::Vector2i cell = cells.getCell(current);
+        float distance = m_distances[current];
+        if (algorithm == PathAlgorithm::AStar)
+        {
+            for (sf::Vector2i const &offset : Neighbours)
+            {
+                if (cells.canMove(cell.x, cell.y, offset.x, offset.y))
+                {
+                    relax(cells, cells.getIndex(cell + offset), current, distance + ((offset.x != 0 && offset.y != 0) ? std::numbers::sqrt2_v<float> : 1.f), goal);
+                }
+            }
+            continue;
+        }
+        std::optional<sf::Vector2i> direction;
+        if (current != startIndex)
+        {
+            sf::Vector2i parent = cells.getCell(m_parents[current]);
+            direction = sf::Vector2i(sign(cell.x - parent.x), sign(cell.y - parent.y));
+        }
+        addJumpDirections(cells, cell, direction);
+        for (sf::Vector2i const &offset : m_directions)
+        {
+            if (std::optional<sf::Vector2i> point = jump(cells, cell + offset, offset, goal); point.has_value())
+            {
+                relax(cells, cells.getIndex(point.value()), current, distance + getOctileDistance(cell, point.value()), goal);
+            }
+        }
+    }
+    return {};
+}
+
+void Engine::PathSearch::relax(NavigationCells const &cells, uint32_t cell, uint32_t parent, float distance, sf::Vector2i goal)
+{
+    if (m_reached[cell] == m_searchId && m_distances[cell] <= distance)
+    {
+        return;
+    }
+    m_reached[cell] = m_searchId;
+    m_distances[cell] = distance;
+    m_parents[cell] = parent;
+    m_open.push_back(OpenNode{distance + getOctileDistance(cells.getCell(cell), goal), cell});
+    std::push_heap(m_open.begin(), m_open.end(), std::greater<OpenNode>());
+}
+
+void Engine::PathSearch::addJumpDirections(NavigationCells const &cells, sf::Vector2i cell, std::optional<sf::Vector2i> direction)
+{
+    m_directions.clear();
+    if (!direction.has_value())
+    {
+        for (sf::Vector2i const &offset : Neighbours)
+        {
+            if (cells.canMove(cell.x, cell.y, offset.x, offset.y))
+            {
+                m_directions.push_back(offset);
+            }
+        }
+        return;
+    }
+    int32_t dx = direction->x;
+    int32_t dy = direction->y;
+    int32_t x = cell.x;
+    int32_t y = cell.y;
+    if (dx != 0 && dy != 0)
+    {
+        if (cells.isWalkable(x, y + dy))
+        {
+            m_directions.push_back(sf::Vector2i(0, dy));
+        }
+        if (cells.isWalkable(x + dx, y))
+        {
+            m_directions.push_back(sf::Vector2i(dx, 0));
+        }
+        if (cells.canMove(x, y, dx, dy))
+        {
+            m_directions.push_back(sf::Vector2i(dx, dy));
+        }
+        return;
+    }
+    // sideways directions are always checked since corners can't be cut, so cells around the end of a wall can only be reached by turning here
+    sf::Vector2i side(dy != 0 ? 1 : 0, dx != 0 ? 1 : 0);
+    bool forward = cells.isWalkable(x + dx, y + dy);
+    for (sf::Vector2i offset : {side, -side})
+    {
+        if (!cells.isWalkable(x + offset.x, y + offset.y))
+        {
+            continue;
+        }
+        if (forward)
+        {
+            m_directions.push_back(sf::Vector2i(dx + offset.x, dy + offset.y));
+        }
+        m_directions.push_back(offset);
+    }
+    if (forward)
+    {
+        m_directions.push_back(sf::Vector2i(dx, dy));
+    }
+}
+
+std::optional<sf::Vector2i> Engine::PathSearch::jump(NavigationCells const &cells, sf::Vector2i cell, sf::Vector2i direction, sf::Vector2i goal)
+{
+    int32_t dx = direction.x;
+    int32_t dy = direction.y;
+    int32_t x = cell.x;
+    int32_t y = cell.y;
+    while (true)
+    {
+        if (!cells.isWalkable(x, y))
+        {
+            return {};
+        }
+        if (x == goal.x && y == goal.y)
+        {
+            return sf::Vector2i(x, y);
+        }
+        if (dx != 0 && dy != 0)
+        {
+            // diagonal run stops wherever one of the straight runs starting from it finds something
+            if (jump(cells, sf::Vector2i(x + dx, y), sf::Vector2i(dx, 0), goal).has_value() ||
+                jump(cells, sf::Vector2i(x, y + dy), sf::Vector2i(0, dy), goal).has_value())
+            {
+                return sf::Vector2i(x, y);
+            }
+            if (!cells.canMove(x, y, dx, dy))
+            {
+                return {};
+            }
+        }
+        else if (dx != 0)
+        {
+            // cell next to the run that was blocked behind us can only be reached optimally by turning here
+            if ((cells.isWalkable(x, y - 1) && !cells.isWalkable(x - dx, y - 1)) || (cells.isWalkable(x, y + 1) && !cells.isWalkable(x - dx, y + 1)))
+            {
+                return sf::Vector2i(x, y);
+            }
+        }
+        else if ((cells.isWalkable(x - 1, y) && !cells.isWalkable(x - 1, y - dy)) || (cells.isWalkable(x + 1, y) && !cells.isWalkable(x + 1, y - dy)))
+        {
+            return sf::Vector2i(x, y);
+        }
+        x += dx;
+        y += dy;
+    }
+}
+
+std::vector<sf::Vector2i> Engine::PathSearch::buildPath(NavigationCells const &cells, uint32_t goal) const
+{
+    std::vector<sf::Vector2i> path;
+    uint32_t current = goal;
+    path.push_back(cells.getCell(current));
+    while (m_parents[current] != current)
+    {
+        sf::Vector2i from = cells.getCell(current);
+        sf::Vector2i to = cells.getCell(m_parents[current]);
+        // jump points are connected by straight or diagonal runs, which are filled in so that both algorithms return every cell
+        sf::Vector2i step(sign(to.x - from.x), sign(to.y - from.y));
+        for (sf::Vector2i cell = from + step; cell != to; cell += step)
+        {
+            path.push_back(cell);
+        }
+        path.push_back(to);
+        current = m_parents[current];
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+Engine::FlowField::FlowField(NavigationCells const &cells, sf::Vector2i target) : m_target(target)
+{
+    build(cells);
+}
+
+void Engine::FlowField::build(NavigationCells const &cells)
+{
+    constexpr float unreachable = std::numeric_limits<float>::infinity();
+    m_distances.assign((size_t)cells.width * cells.height, unreachable);
+    if (!cells.isWalkable(m_target.x, m_target.y))
+    {
+        return;
+    }
+    using Node = std::pair<float, uint32_t>;
+    std::vector<Node> open;
+    uint32_t target = cells.getIndex(m_target);
+    m_distances[target] = 0.f;
+    open.push_back(Node{0.f, target});
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), std::greater<Node>());
+        auto [distance, current] = open.back();
+        open.pop_back();
+        if (distance > m_distances[current])
+        {
+            continue;
+        }
+        sf::Vector2i cell = cells.getCell(current);
+        for (sf::Vector2i const &offset : Neighbours)
+        {
+            if (!cells.canMove(cell.x, cell.y, offset.x, offset.y))
+            {
+                continue;
+            }
+            uint32_t next = cells.getIndex(cell + offset);
+            float nextDistance = distance + ((offset.x != 0 && offset.y != 0) ? std::numbers::sqrt2_v<float> : 1.f);
+            if (nextDistance < m_distances[next])
+            {
+                m_distances[next] = nextDistance;
+                open.push_back(Node{nextDistance, next});
+                std::push_heap(open.begin(), open.end(), std::greater<Node>());
+            }
+        }
+    }
+}
+
+std::optional<float> Engine::FlowField::getDistance(NavigationCells const &cells, sf::Vector2i cell) const
+{
+    if (!cells.isInside(cell.x, cell.y) || std::isinf(m_distances[cells.getIndex(cell)]))
+    {
+        return {};
+    }
+    return m_distances[cells.getIndex(cell)];
+}
+
+std::optional<sf::Vector2i> Engine::FlowField::getDirection(NavigationCells const &cells, sf::Vector2i cell) const
+{
+    std::optional<float> distance = getDistance(cells, cell);
+    if (!distance.has_value() || cell == m_target)
+    {
+        return {};
+    }
+    std::optional<sf::Vector2i> best;
+    float bestDistance = distance.value();
+    for (sf::Vector2i const &offset : Neighbours)
+    {
+        if (!cells.canMove(cell.x, cell.y, offset.x, offset.y))
+        {
+            continue;
+        }
+        // distance through the neighbour is compared instead of the distance of the neighbour so that diagonal steps are not preferred over straight ones
+        float through = m_distances[cells.getIndex(cell + offset)] + ((offset.x != 0 && offset.y != 0) ? std::numbers::sqrt2_v<float> : 1.f);
+        if (m_distances[cells.getIndex(cell + offset)] < distance.value() && (!best.has_value() || through < bestDistance))
+        {
+            best = offset;
+            bestDistance = through;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <SFML/Graphics.hpp>
+
+namespace Engine
+{
+    enum class PathAlgorithm
+    {
+        /// @brief Regular A* that checks every neighbour of every visited cell
+        AStar,
+        /// @brief Jump point search, finds paths of the same length as A* while visiting only cells where the path can turn.
+        /// Much faster on open areas since straight runs of free cells are skipped in one go
+        JumpPoint
+    };
+
+    /// @brief Walkability of every cell of a navigation grid. Cells are stored row by row
+    struct NavigationCells
+    {
+        int32_t width = 0;
+        int32_t height = 0;
+        /// @brief Non zero value means that cell can not be entered
+        std::vector<uint8_t> blocked;
+
+        bool isInside(int32_t x, int32_t y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+
+        /// @brief Check if cell is inside the grid and free
+        bool isWalkable(int32_t x, int32_t y) const { return isInside(x, y) && blocked[(size_t)y * width + x] == 0; }
+
+        /// @brief Check if agent can move from the cell by the given offset.
+        /// Diagonal moves require both cells next to the corner to be free so that paths never cut corners of obstacles
+        bool canMove(int32_t x, int32_t y, int32_t dx, int32_t dy) const;
+
+        uint32_t getIndex(sf::Vector2i cell) const { return (uint32_t)cell.y * (uint32_t)width + (uint32_t)cell.x; }
+
+        sf::Vector2i getCell(uint32_t index) const { return sf::Vector2i((int32_t)(index % (uint32_t)width), (int32_t)(index / (uint32_t)width)); }
+    };
+
+    /// @brief Get length of the shortest path between two cells on an empty grid where diagonal steps cost square root of two
+    float getOctileDistance(sf::Vector2i a, sf::Vector2i b);
+
+    /// @brief Shortest path search on a navigation grid. Buffers are kept between searches,
+    /// so a single search should be reused for many queries but never shared between threads
+    class PathSearch
+    {
+    public:
+        /// @brief Find the shortest path between two cells
+        /// @return Every cell of the path including start and goal or nothing if goal can't be reached
+        std::optional<std::vector<sf::Vector2i>> findPath(NavigationCells const &cells, sf::Vector2i start, sf::Vector2i goal, PathAlgorithm algorithm);
+
+        /// @brief Get amount of cells that were taken out of the open list during the last search
+        size_t getExpandedCount() const { return m_expandedCount; }
+
+    private:
+        struct OpenNode
+        {
+            float estimate;
+            uint32_t cell;
+
+            /// @brief Ties are broken by cell index so that the same query always produces the same path
+            bool operator>(OpenNode const &other) const { return estimate > other.estimate || (estimate == other.estimate && cell > other.cell); }
+        };
+
+        /// @brief Add cell to the open list if it wasn't reached yet or the new route to it is shorter
+        void relax(NavigationCells const &cells, uint32_t cell, uint32_t parent, float distance, sf::Vector2i goal);
+
+        /// @brief Add every neighbour that jump point search needs to check when arriving at the cell from its parent
+        void addJumpDirections(NavigationCells const &cells, sf::Vector2i cell, std::optional<sf::Vector2i> direction);
+
+        /// @brief Move from the cell in the direction until reaching a cell where the path may need to turn
+        /// @param cell First cell after the one jump starts from
+        /// @return Found jump point or nothing if jump hit an obstacle
+        static std::optional<sf::Vector2i> jump(NavigationCells const &cells, sf::Vector2i cell, sf::Vector2i direction, sf::Vector2i goal);
+
+        std::vector<sf::Vector2i> buildPath(NavigationCells const &cells, uint32_t goal) const;
+
+        std::vector<float> m_distances;
+        std::vector<uint32_t> m_parents;
+        /// @brief Search during which the cell was reached, used to avoid clearing buffers between searches
+        std::vector<uint32_t> m_reached;
+        /// @brief Search during which the cell was expanded
+        std::vector<uint32_t> m_closed;
+        uint32_t m_searchId = 0;
+        std::vector<OpenNode> m_open;
+        std::vector<sf::Vector2i> m_directions;
+        size_t m_expandedCount = 0;
+    };
+
+    /// @brief Distance from every cell of the grid to a single target, shared by every agent moving to the same target
+    class FlowField
+    {
+    public:
+        FlowField(NavigationCells const &cells, sf::Vector2i target);
+
+        sf::Vector2i getTarget() const { return m_target; }
+
+        /// @brief Recalculate distances after cells changed
+        void build(NavigationCells const &cells);
+
+        /// @brief Get length of the shortest path from the cell to the target or nothing if target can't be reached from the cell
+        std::optional<float> getDistance(NavigationCells const &cells, sf::Vector2i cell) const;
+
+        /// @brief Get offset to the neighbour that is the closest to the target
+        /// @return Offset or nothing if cell is the target or can't reach it
+        std::optional<sf::Vector2i> getDirection(NavigationCells const &cells, sf::Vector2i cell) const;
+
+    private:
+        sf::Vector2i m_target;
+        std::vector<float> m_distances;
+    };
+}
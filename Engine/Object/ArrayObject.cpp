@@ -1,21 +1,50 @@
 #include "ArrayObject.hpp"
+#include <cassert>
 #include "../Error.hpp"
+#include "../Memory/GarbageCollector.hpp"
+#include "../Memory/FrameResource.hpp"
 
-Engine::ArrayObject::ArrayObject(size_t initialSize) : m_values(initialSize, NilValue)
+Engine::ArrayObject::ArrayObject(size_t initialSize) : ArrayObject(std::pmr::get_default_resource(), initialSize)
 {
 }
 
-Engine::ArrayObject::ArrayObject(std::vector<Value> const &values) : m_values(values)
+Engine::ArrayObject::ArrayObject(std::vector<Value> const &values) : ArrayObject(std::pmr::get_default_resource(), values)
 {
 }
 
-std::string Engine::ArrayObject::toString() const
+Engine::ArrayObject::ArrayObject(ArrayObject const &other) : ArrayObject(other.m_resource, other)
+{
+}
+
+Engine::ArrayObject::ArrayObject(std::pmr::memory_resource *resource, size_t initialSize) : m_resource(resource), m_length(initialSize)
+{
+    m_buffer = createBuffer({});
+    m_buffer->values.resize(initialSize, NilValue);
+}
+
+Engine::ArrayObject::ArrayObject(std::pmr::memory_resource *resource, std::vector<Value> const &values) : m_resource(resource), m_length(values.size())
+{
+    m_buffer = createBuffer(values);
+    for (Value const &v : m_buffer->values)
+    {
+        increaseValueRefCount(v);
+    }
+}
+
+Engine::ArrayObject::ArrayObject(std::pmr::memory_resource *resource, ArrayObject const &other) : MemoryObject(), m_resource(resource), m_buffer(other.m_buffer), m_length(other.m_length)
+{
+    // object is only marked as temporary after construction, so the kind of the new array is told by its resource
+    assert(GarbageCollector::isTemporary(&other) == (dynamic_cast<FrameResource *>(resource) != nullptr));
+    m_buffer->shareCount++;
+}
+
+std::string Engine::ArrayObject::toString(Scene const &scene) const
 {
     std::string result = "[";
-    for (size_t i = 0; i < m_values.size(); i++)
+    for (size_t i = 0; i < m_length; i++)
     {
-        result += valueToString(m_values[i]);
-        if (i != m_values.size() - 1)
+        result += valueToString(m_buffer->values[i], scene);
+        if (i != m_length - 1)
         {
             result += ',';
         }
@@ -25,33 +54,126 @@ std::string Engine::ArrayObject::toString() const
 
 void Engine::ArrayObject::setItem(size_t id, Value const &v)
 {
-    if (id >= m_values.size())
+    if (id >= m_length)
     {
         return;
     }
-    decreaseValueRefCount(m_values[id]);
-    m_values[id] = v;
+    if (isShared())
+    {
+        detachBuffer();
+    }
     increaseValueRefCount(v);
+    decreaseValueRefCount(m_buffer->values[id]);
+    m_buffer->values[id] = v;
 }
 
 Engine::Value Engine::ArrayObject::getItem(size_t id) const
 {
-    if (id >= m_values.size())
+    if (id >= m_length)
     {
-        throw Errors::RuntimeMemoryError(std::string("Attempted to get item at position " + std::to_string(id) + " in array of size " + std::to_string(m_values.size())));
+        throw Errors::RuntimeMemoryError(std::string("Attempted to get item at position " + std::to_string(id) + " in array of size " + std::to_string(m_length)));
     }
-    return m_values.at(id);
+    return m_buffer->values[id];
 }
 
 void Engine::ArrayObject::appendItem(Value const &v)
 {
-    m_values.push_back(v);
+    // some other array already added its own items after the ones we can see
+    if (m_length != m_buffer->values.size())
+    {
+        detachBuffer();
+    }
+    size_t capacity = m_buffer->values.capacity();
+    m_buffer->values.push_back(v);
+    increaseValueRefCount(v);
+    m_length++;
+    if (m_buffer->values.capacity() != capacity)
+    {
+        updateAccountedSize();
+    }
+}
+
+size_t Engine::ArrayObject::getAllocatedSize() const
+{
+    // shared buffer is accounted for by the array that created it
+    return sizeof(ArrayObject) + (isShared() ? 0 : sizeof(ArrayBuffer) + m_buffer->values.capacity() * sizeof(Value));
+}
+
+void Engine::ArrayObject::dropReferences()
+{
+    releaseBuffer(false);
+}
+
+void Engine::ArrayObject::releaseReferences()
+{
+    releaseBuffer(true);
+}
+
+void Engine::ArrayObject::traceReferences(GarbageCollector &collector) const
+{
+    if (m_buffer == nullptr)
+    {
+        return;
+    }
+    // whole buffer is traced since it holds references to items past the end of this array that other arrays might use
+    for (Value const &v : m_buffer->values)
+    {
+        collector.markReachable(v);
+    }
 }
 
 Engine::ArrayObject::~ArrayObject()
 {
-    for (Value const &v : m_values)
+    releaseBuffer(true);
+}
+
+void Engine::ArrayObject::detachBuffer()
+{
+    if (!isShared())
     {
-        decreaseValueRefCount(v);
+        // nobody else can see items past our length anymore, so they can be simply removed
+        for (size_t i = m_length; i < m_buffer->values.size(); i++)
+        {
+            decreaseValueRefCount(m_buffer->values[i]);
+        }
+        m_buffer->values.resize(m_length);
+        return;
+    }
+    ArrayBuffer *copy = createBuffer(getItems());
+    for (Value const &v : copy->values)
+    {
+        increaseValueRefCount(v);
+    }
+    releaseBuffer(true);
+    m_buffer = copy;
+    updateAccountedSize();
+}
+
+Engine::ArrayBuffer *Engine::ArrayObject::createBuffer(std::span<Value const> values)
+{
+    std::pmr::polymorphic_allocator<> allocator(m_resource);
+    return allocator.new_object<ArrayBuffer>(ArrayBuffer{.values = std::pmr::vector<Value>(values.begin(), values.end(), m_resource)});
+}
+
+void Engine::ArrayObject::releaseBuffer(bool releaseValues)
+{
+    if (m_buffer == nullptr)
+    {
+        return;
+    }
+    m_buffer->shareCount--;
+    if (m_buffer->shareCount == 0)
+    {
+        if (releaseValues)
+        {
+            for (Value const &v : m_buffer->values)
+            {
+                decreaseValueRefCount(v);
+            }
+        }
+        // buffer might have been created by another array, so it is freed using the resource that holds its items
+        std::pmr::polymorphic_allocator<> allocator(m_buffer->values.get_allocator().resource());
+        allocator.delete_object(m_buffer);
     }
+    m_buffer = nullptr;
 }
@@ -1,8 +1,21 @@
 #pragma once
+#include <span>
+#include <memory_resource>
 #include "MemoryObject.hpp"
 #include "../Execution/Value.hpp"
 namespace Engine
 {
+    /// @brief Storage for array items that can be shared between multiple arrays.
+    /// Buffer holds references to the stored values and has its own counter of arrays using it. Buffer and its items live in the memory resource of the array that created it
+    struct ArrayBuffer
+    {
+        std::pmr::vector<Value> values;
+        /// @brief Amount of arrays using this buffer
+        uint32_t shareCount = 1;
+    };
+
+    /// @brief Array of values with copy-on-write semantics. Array is a view of the first length items of the buffer, which can be shared with other arrays.
+    /// Buffer is copied only when array needs to change an item that other arrays can see
     class ArrayObject : public MemoryObject
     {
     public:
@@ -10,7 +23,23 @@ namespace Engine
         /// @param initialSize
         explicit ArrayObject(size_t initialSize);
         explicit ArrayObject(std::vector<Value> const &values);
-        std::string toString() const override;
+
+        /// @brief Create array of given size filled with Nil values, keeping the items in the given memory resource
+        explicit ArrayObject(std::pmr::memory_resource *resource, size_t initialSize);
+
+        /// @brief Create array with copies of the values, keeping the items in the given memory resource
+        explicit ArrayObject(std::pmr::memory_resource *resource, std::vector<Value> const &values);
+
+        /// @brief Create array that shares all items with other array. Items are copied once either of the arrays is modified
+        /// @param other Array to share items with
+        explicit ArrayObject(ArrayObject const &other);
+
+        /// @brief Create array that shares all items with other array. Buffer stays in the resource of the array that created it,
+        /// the given resource is only used for the private copy made once either of the arrays is modified.
+        /// Both arrays must be temporary or both regular, so that regular arrays never see buffers of the frame storage
+        explicit ArrayObject(std::pmr::memory_resource *resource, ArrayObject const &other);
+
+        std::string toString(Scene const &scene) const override;
 
         void setItem(size_t id, Value const &v);
 
@@ -19,15 +48,60 @@ namespace Engine
         /// @return Item at the given position
         Engine::Value getItem(size_t id) const;
 
+        /// @brief Add item to the end of the array. If array sees the whole buffer item is added to the buffer directly even if it is shared,
+        /// since other arrays only see items before it
+        /// @param v Item to add
         void appendItem(Value const &v);
 
-        std::vector<Value> &getItems() { return m_values; }
+        std::span<Value const> getItems() const { return std::span<Value const>(m_buffer->values.data(), m_length); }
+
+        size_t getLength() const { return m_length; }
+
+        /// @brief Is item storage currently used by other arrays as well
+        bool isShared() const { return m_buffer->shareCount > 1; }
+
+        /// @brief Get item storage of the array, which can hold more items than the array can see
+        ArrayBuffer const *getBuffer() const { return m_buffer; }
 
-        size_t getLength() const { return m_values.size(); }
+        /// @brief Remember that array was stored in one more local variable
+        void addVariableReference() { m_variableReferences++; }
+
+        /// @brief Remember that one of the local variables holding the array was overwritten or freed
+        void removeVariableReference() { m_variableReferences--; }
+
+        /// @brief Is the array currently stored in a local variable. When variable references are deferred variables don't count towards the reference counter,
+        /// so this is the only way to know that array is already in use by some variable
+        bool isStoredInVariable() const { return m_variableReferences > 0; }
+
+        size_t getAllocatedSize() const override;
+
+        MemoryObjectKind getKind() const override { return MemoryObjectKind::Array; }
+
+        void dropReferences() override;
+
+        void releaseReferences() override;
+
+        void traceReferences(GarbageCollector &collector) const override;
 
         virtual ~ArrayObject();
 
     private:
-        std::vector<Value> m_values;
+        /// @brief Replace shared buffer with a private copy of the items visible to this array
+        void detachBuffer();
+
+        /// @brief Create buffer in the memory resource of the array
+        ArrayBuffer *createBuffer(std::span<Value const> values);
+
+        /// @brief Stop using current buffer, freeing it if this was the last array using it
+        /// @param releaseValues Should reference counters of the values in the freed buffer be decreased
+        void releaseBuffer(bool releaseValues);
+
+        /// @brief Resource used for buffers created by this array
+        std::pmr::memory_resource *m_resource;
+        ArrayBuffer *m_buffer;
+        /// @brief Amount of items of the buffer that belong to this array
+        size_t m_length;
+        /// @brief Amount of local variables holding the array while variable references are deferred
+        uint32_t m_variableReferences = 0;
     };
 } // namespace Engine
@@ -17,3 +17,9 @@ void Engine::AudioObject::setPosition(sf::Vector2f pos)
 {
     m_sound->setPosition(pos);
 }
+
+size_t Engine::AudioObject::getAllocatedSize() const
+{
+    // sample data belongs to the content manager, so only the sound player itself is counted
+    return GameObject::getAllocatedSize() - sizeof(GameObject) + sizeof(AudioObject) + (m_sound ? sizeof(Sound) : 0);
+}
@@ -19,6 +19,8 @@ namespace Engine
 
         void setPosition(sf::Vector2f pos) override;
 
+        size_t getAllocatedSize() const override;
+
     private:
         std::unique_ptr<Sound> m_sound;
     };
@@ -2,7 +2,8 @@
 #include "ArrayObject.hpp"
 #include "../Scene.hpp"
 Engine::GameObject::GameObject(ObjectType const *type, std::string const &name, Scene &state)
-    : m_sprite(std::move(ContentManager::getInstance().createSpriteFromAsset(type->getSpriteData()))), m_type(type), m_name(name), m_visible(true), m_destroyed(false)
+    : m_sprite(std::move(ContentManager::getInstance().createSpriteFromAsset(type->getSpriteData()))), m_type(type), m_name(name), m_visible(true), m_destroyed(false),
+      m_fields(state.getMemoryResource())
 {
     for (std::pair<std::string, Runnable::CodeConstantValue> const &val : type->getFields())
     {
@@ -18,9 +19,10 @@ Engine::GameObject::GameObject(ObjectType const *type, std::string const &name,
             m_fields[val.first] = std::get<double>(val.second);
             break;
         case Runnable::CodeConstantValueType::StringId:
-            if (std::optional<std::string> str = state.getConstantStringById(std::get<size_t>(val.second)); str.has_value())
+            // field strings are stored in the string table of the type, not the one of the code that is currently running
+            if (type->hasStringAt(std::get<size_t>(val.second)))
             {
-                m_fields[val.first] = state.createString(str.value());
+                m_fields[val.first] = type->getStringObjectAt(std::get<size_t>(val.second));
             }
             else
             {
@@ -57,12 +59,18 @@ void Engine::GameObject::setPosition(sf::Vector2f pos)
     {
         m_sprite->setPosition(pos);
     }
+    updateSpatialIndex();
 }
 
 void Engine::GameObject::setSize(sf::Vector2f size)
 {
     m_size = size;
-    m_sprite->setSize(size);
+    // objects without sprites still use their size for overlap checks
+    if (m_sprite != nullptr)
+    {
+        m_sprite->setSize(size);
+    }
+    updateSpatialIndex();
 }
 
 void Engine::GameObject::update(float delta)
@@ -73,6 +81,75 @@ void Engine::GameObject::update(float delta)
     }
 }
 
+void Engine::GameObject::setUpdatePolicy(UpdatePolicy const &policy)
+{
+    m_updatePolicy = policy;
+    m_updatePolicy.interval = std::max<uint32_t>(1, policy.interval);
+    m_framesSinceUpdate = getUpdatePhase();
+}
+
+std::optional<float> Engine::GameObject::advanceUpdateClock(float delta, std::optional<sf::FloatRect> const &region)
+{
+    if (m_sleeping)
+    {
+        if (m_sleepTimeLeft <= 0.f || (m_sleepTimeLeft -= delta) > 0.f)
+        {
+            return {};
+        }
+        wake();
+    }
+    m_pendingDelta += delta;
+    m_framesSinceUpdate++;
+    switch (m_updatePolicy.mode)
+    {
+    case UpdateMode::Always:
+        break;
+    case UpdateMode::Interval:
+        if (m_framesSinceUpdate < m_updatePolicy.interval)
+        {
+            return {};
+        }
+        break;
+    case UpdateMode::InRegion:
+        if (region.has_value())
+        {
+            sf::FloatRect area(region->position - sf::Vector2f(m_updatePolicy.margin, m_updatePolicy.margin),
+                               region->size + sf::Vector2f(m_updatePolicy.margin, m_updatePolicy.margin) * 2.f);
+            if (!area.findIntersection(sf::FloatRect(m_position, m_size)).has_value() && !area.contains(m_position))
+            {
+                // time spent outside of the region is not simulated, otherwise objects would jump once they come back
+                m_pendingDelta = 0.f;
+                m_framesSinceUpdate = 0;
+                return {};
+            }
+        }
+        break;
+    }
+    float passed = m_pendingDelta;
+    m_pendingDelta = 0.f;
+    m_framesSinceUpdate = 0;
+    return passed;
+}
+
+void Engine::GameObject::sleep(float duration)
+{
+    m_sleeping = true;
+    m_sleepTimeLeft = std::max(0.f, duration);
+}
+
+void Engine::GameObject::wake()
+{
+    // scene wakes objects on every event they handle, so awake objects must keep the time they have accumulated
+    if (!m_sleeping)
+    {
+        return;
+    }
+    m_sleeping = false;
+    m_sleepTimeLeft = 0.f;
+    m_pendingDelta = 0.f;
+    m_framesSinceUpdate = getUpdatePhase();
+}
+
 std::optional<Engine::Value> Engine::GameObject::getFieldValue(std::string const &name) const
 {
     if (m_fields.contains(name))
@@ -84,12 +161,13 @@ std::optional<Engine::Value> Engine::GameObject::getFieldValue(std::string const
 
 void Engine::GameObject::setFieldValue(std::string const &name, Value const &val)
 {
+    // increase first in case the same object is assigned again
+    increaseValueRefCount(val);
     if (m_fields.contains(name))
     {
-        decreaseValueRefCount(val);
+        decreaseValueRefCount(m_fields[name]);
     }
     m_fields[name] = val;
-    increaseValueRefCount(val);
 }
 
 void Engine::GameObject::changeSprite(SpriteFramesAsset const *asset)
@@ -104,6 +182,21 @@ void Engine::GameObject::changeSprite(SpriteFramesAsset const *asset)
     {
         m_sprite->setAnimationFinishedCallback(std::bind(&GameObject::spriteAnimationFinishedCallback, this));
         m_size = sf::Vector2f(m_sprite->getCurrentFrameSize().size.x, m_sprite->getCurrentFrameSize().size.y);
+        updateSpatialIndex();
+    }
+}
+
+void Engine::GameObject::setSpatialIndex(SpatialGrid *index)
+{
+    m_spatialIndex = index;
+    updateSpatialIndex();
+}
+
+void Engine::GameObject::updateSpatialIndex()
+{
+    if (m_spatialIndex != nullptr)
+    {
+        m_spatialIndex->update(m_handle.index, getBounds(), m_type->getCollisionLayer());
     }
 }
 
@@ -125,6 +218,22 @@ void Engine::GameObject::spriteAnimationFinishedCallback()
     m_hasAnimationJustFinished = true;
 }
 
+size_t Engine::GameObject::getAllocatedSize() const
+{
+    size_t size = sizeof(GameObject) + (m_name.capacity() > 15 ? m_name.capacity() : 0);
+    // each field is a separately allocated node holding the key, the value and a link to the next node
+    size += m_fields.bucket_count() * sizeof(void *);
+    for (auto const &[name, val] : m_fields)
+    {
+        size += sizeof(std::pair<const std::string, Value>) + sizeof(void *) + (name.capacity() > 15 ? name.capacity() : 0);
+    }
+    if (m_sprite)
+    {
+        size += sizeof(AnimatedSprite);
+    }
+    return size;
+}
+
 void Engine::validateObject(Engine::GameObject const *obj)
 {
     if (obj->isDestroyed())
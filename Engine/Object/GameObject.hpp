@@ -1,15 +1,19 @@
 #pragma once
 
+#include <memory_resource>
+#include <unordered_map>
 #include "ObjectType.hpp"
-#include "MemoryObject.hpp"
+#include "ObjectHandle.hpp"
 #include "../Content/ContentManager.hpp"
 #include "../Content/AnimatedSprite.hpp"
+#include "../Spatial/SpatialGrid.hpp"
 
 namespace Engine
 {
     class Scene;
     /// @brief Object representing anything that participates in the game and has visuals or sounds attached to it.
-    class GameObject : public MemoryObject
+    /// Game objects are owned by the scene and scripts only reference them via handles, so they are not reference counted
+    class GameObject
     {
     public:
         explicit GameObject(ObjectType const *type, std::string const &name, Scene &state);
@@ -31,8 +35,35 @@ namespace Engine
 
         virtual void update(float delta);
 
+        /// @brief Set rules that decide on which frames the object is updated
+        void setUpdatePolicy(UpdatePolicy const &policy);
+
+        UpdatePolicy const &getUpdatePolicy() const { return m_updatePolicy; }
+
+        /// @brief Advance the update clock of the object by one frame according to its update policy
+        /// @param delta Time passed since last frame
+        /// @param region Area of the scene in which objects using region mode are updated, if not set all such objects are updated
+        /// @return Time passed since the last update of the object or nothing if object should not be updated on this frame
+        std::optional<float> advanceUpdateClock(float delta, std::optional<sf::FloatRect> const &region);
+
+        /// @brief Stop updating the object until it is woken up
+        /// @param duration Time in seconds after which the object wakes up by itself, zero or less means object sleeps until woken manually
+        void sleep(float duration = 0.f);
+
+        /// @brief Resume updating the object. Time spent asleep is not passed to the next update, does nothing if the object is awake
+        void wake();
+
+        bool isSleeping() const { return m_sleeping; }
+
         std::string const &getName() const { return m_name; }
 
+        /// @brief Get handle that can be used to reference this object from scripts
+        ObjectHandle getHandle() const { return m_handle; }
+
+        /// @brief Set handle assigned to the object by the object storage
+        /// @param handle Handle
+        void setHandle(ObjectHandle handle) { m_handle = handle; }
+
         /// @brief Get current script type of the object
         /// @return Pointer to the type information
         ObjectType const *getType() const { return m_type; }
@@ -42,6 +73,8 @@ namespace Engine
         /// @return True if field is present
         bool hasField(std::string const &name) const { return m_fields.contains(name); }
 
+        std::pmr::unordered_map<std::string, Value> const &getFields() const { return m_fields; }
+
         /// @brief Get value of the field if present
         /// @param name Name of the field
         /// @return Value of the field or None if no field uses that name
@@ -62,29 +95,63 @@ namespace Engine
         /// @param asset Sprite asset to update to, if `nullptr` sprite is just deleted 
         void changeSprite(SpriteFramesAsset const* asset);
 
-        /// @brief Mark object as ready to be destroyed. This does not instantly clear the memory used by the object to avoid accessing invalid data,
-        /// but it will put in the state where it is not rendered and not updated and attempting to call functions on it will throw errors
+        /// @brief Mark object as destroyed and release everything it references. This does not free the memory used by the object,
+        /// scene keeps it around until the end of the frame so that code which is still using the object would not access invalid data
         void destroy();
 
         bool isDestroyed() const { return m_destroyed; }
 
-        std::string toString() const override { return std::string("Object@") + getName(); }
+        std::string toString() const { return std::string("Object@") + getName(); }
+
+        /// @brief Set broadphase index that should be kept up to date with the bounds of the object
+        /// @param index Index or null if object should not be tracked
+        void setSpatialIndex(SpatialGrid *index);
+
+        /// @brief Get area occupied by the object
+        sf::FloatRect getBounds() const { return sf::FloatRect(m_position, m_size); }
+
+        /// @brief Get estimated amount of memory used by the object including its fields
+        virtual size_t getAllocatedSize() const;
+
+        /// @brief Get size of the object as it was last recorded in the memory statistics of the scene
+        size_t getAccountedSize() const { return m_accountedSize; }
+
+        void setAccountedSize(size_t size) { m_accountedSize = size; }
 
         virtual ~GameObject() = default;
 
     protected:
         void spriteAnimationFinishedCallback();
 
+        /// @brief Pass current bounds of the object to the broadphase index
+        void updateSpatialIndex();
+
     private:
+        /// @brief Get amount of frames counted as already passed when interval starts. Taken from the slot index so that objects sharing an interval don't all update on the same frame
+        uint32_t getUpdatePhase() const { return m_handle.index % m_updatePolicy.interval; }
+
         std::string m_name;
+        ObjectHandle m_handle{};
         std::unique_ptr<AnimatedSprite> m_sprite;
         ObjectType const *m_type;
         sf::Vector2f m_position;
         sf::Vector2f m_size;
         bool m_visible;
         bool m_destroyed;
-        std::unordered_map<std::string, Value> m_fields;
+        /// @brief Field values, allocated from the memory of the scene that owns the object
+        std::pmr::unordered_map<std::string, Value> m_fields;
         bool m_hasAnimationJustFinished = false;
+        size_t m_accountedSize = 0;
+        UpdatePolicy m_updatePolicy;
+        bool m_sleeping = false;
+        /// @brief Time left until the object wakes up by itself, zero if it only wakes up manually
+        float m_sleepTimeLeft = 0.f;
+        /// @brief Time passed since the last update
+        float m_pendingDelta = 0.f;
+        /// @brief Frames passed since the last update
+        uint32_t m_framesSinceUpdate = 0;
+        /// @brief Broadphase index of the scene, slot index of the handle is used as id in the index
+        SpatialGrid *m_spatialIndex = nullptr;
     };
 
     /// @brief Check if given object has been destroyed and throw an error if it was
@@ -0,0 +1,272 @@
+#include "MapObject.hpp"
+#include "../Error.hpp"
+#include "../Memory/GarbageCollector.hpp"
+#include <functional>
+
+std::string Engine::MapObject::toString(Scene const &scene) const
+{
+    std::string result = "{";
+    bool first = true;
+    for (Slot const &slot : m_slots)
+    {
+        if (slot.state != SlotState::Occupied)
+        {
+            continue;
+        }
+        if (!first)
+        {
+            result += ',';
+        }
+        first = false;
+        result += valueToString(slot.key, scene) + ":" + valueToString(slot.value, scene);
+    }
+    return result + "}";
+}
+
+size_t Engine::MapObject::getAllocatedSize() const
+{
+    return sizeof(MapObject) + m_slots.capacity() * sizeof(Slot);
+}
+
+void Engine::MapObject::dropReferences()
+{
+    releaseSlots(false);
+}
+
+void Engine::MapObject::releaseReferences()
+{
+    releaseSlots(true);
+}
+
+void Engine::MapObject::traceReferences(GarbageCollector &collector) const
+{
+    for (Slot const &slot : m_slots)
+    {
+        if (slot.state == SlotState::Occupied)
+        {
+            collector.markReachable(slot.key);
+            collector.markReachable(slot.value);
+        }
+    }
+}
+
+bool Engine::MapObject::isValidKey(Value const &key)
+{
+    return key.index() == ValueType::Integer || key.index() == ValueType::String || key.index() == ValueType::Object;
+}
+
+std::optional<Engine::Value> Engine::MapObject::get(Value const &key) const
+{
+    if (!isValidKey(key))
+    {
+        return {};
+    }
+    if (std::optional<size_t> slot = findSlot(key, hashKey(key)); slot.has_value())
+    {
+        return m_slots[slot.value()].value;
+    }
+    return {};
+}
+
+void Engine::MapObject::set(Value const &key, Value const &value)
+{
+    if (!isValidKey(key))
+    {
+        throw Errors::RuntimeMemoryError(std::string("Values of type ") + typeToString((ValueType)key.index()) + " can not be used as map keys");
+    }
+    size_t hash = hashKey(key);
+    if (std::optional<size_t> slot = findSlot(key, hash); slot.has_value())
+    {
+        increaseValueRefCount(value);
+        decreaseValueRefCount(m_slots[slot.value()].value);
+        m_slots[slot.value()].value = value;
+        return;
+    }
+    // keep at least a quarter of the slots empty so that probe sequences stay short
+    if ((m_usedSlots + 1) * 4 > m_slots.size() * 3)
+    {
+        // if most of the used slots are removed keys cleaning them up is enough
+        rehash(m_count * 2 >= m_slots.size() / 2 ? std::max<size_t>(m_slots.size() * 2, 8) : m_slots.size());
+    }
+    size_t mask = m_slots.size() - 1;
+    size_t i = hash & mask;
+    // removed slots can be reused since key is known to not be present further along the probe sequence
+    while (m_slots[i].state == SlotState::Occupied)
+    {
+        i = (i + 1) & mask;
+    }
+    if (m_slots[i].state == SlotState::Empty)
+    {
+        m_usedSlots++;
+    }
+    increaseValueRefCount(key);
+    increaseValueRefCount(value);
+    m_slots[i] = Slot{.key = key, .value = value, .hash = hash, .state = SlotState::Occupied};
+    m_count++;
+}
+
+bool Engine::MapObject::has(Value const &key) const
+{
+    return isValidKey(key) && findSlot(key, hashKey(key)).has_value();
+}
+
+bool Engine::MapObject::remove(Value const &key)
+{
+    if (!isValidKey(key))
+    {
+        return false;
+    }
+    std::optional<size_t> slot = findSlot(key, hashKey(key));
+    if (!slot.has_value())
+    {
+        return false;
+    }
+    Slot &removed = m_slots[slot.value()];
+    decreaseValueRefCount(removed.key);
+    decreaseValueRefCount(removed.value);
+    removed.key = NilValue;
+    removed.value = NilValue;
+    removed.state = SlotState::Removed;
+    m_count--;
+    return true;
+}
+
+void Engine::MapObject::clear()
+{
+    releaseSlots(true);
+}
+
+std::vector<Engine::Value> Engine::MapObject::getKeys() const
+{
+    std::vector<Value> keys;
+    keys.reserve(m_count);
+    for (Slot const &slot : m_slots)
+    {
+        if (slot.state == SlotState::Occupied)
+        {
+            keys.push_back(slot.key);
+        }
+    }
+    return keys;
+}
+
+std::vector<Engine::Value> Engine::MapObject::getValues() const
+{
+    std::vector<Value> values;
+    values.reserve(m_count);
+    for (Slot const &slot : m_slots)
+    {
+        if (slot.state == SlotState::Occupied)
+        {
+            values.push_back(slot.value);
+        }
+    }
+    return values;
+}
+
+Engine::MapObject::~MapObject()
+{
+    releaseSlots(true);
+}
+
+size_t Engine::MapObject::hashKey(Value const &key)
+{
+    switch (key.index())
+    {
+    case ValueType::Integer:
+    {
+        // mix the bits so that sequential ids don't end up in long runs of neighbouring slots
+        uint64_t x = (uint64_t)std::get<IntType>(key);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return (size_t)(x ^ (x >> 31));
+    }
+    case ValueType::String:
+    {
+        StringObject const *str = std::get<StringObject *>(key);
+        return str->isInterned() ? str->getHash() : std::hash<std::string_view>{}(str->getString());
+    }
+    case ValueType::Object:
+    {
+        ObjectHandle handle = std::get<ObjectHandle>(key);
+        return (size_t)(((uint64_t)handle.index * 0x9e3779b97f4a7c15ULL) ^ handle.generation);
+    }
+    }
+    return 0;
+}
+
+bool Engine::MapObject::areKeysEqual(Value const &a, Value const &b)
+{
+    if (a.index() != b.index())
+    {
+        return false;
+    }
+    switch (a.index())
+    {
+    case ValueType::Integer:
+        return std::get<IntType>(a) == std::get<IntType>(b);
+    case ValueType::String:
+        return std::get<StringObject *>(a)->equals(std::get<StringObject *>(b));
+    case ValueType::Object:
+        return std::get<ObjectHandle>(a) == std::get<ObjectHandle>(b);
+    }
+    return false;
+}
+
+std::optional<size_t> Engine::MapObject::findSlot(Value const &key, size_t hash) const
+{
+    if (m_slots.empty())
+    {
+        return {};
+    }
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = hash & mask; m_slots[i].state != SlotState::Empty; i = (i + 1) & mask)
+    {
+        if (m_slots[i].state == SlotState::Occupied && m_slots[i].hash == hash && areKeysEqual(m_slots[i].key, key))
+        {
+            return i;
+        }
+    }
+    return {};
+}
+
+void Engine::MapObject::rehash(size_t capacity)
+{
+    std::vector<Slot> old = std::move(m_slots);
+    m_slots = std::vector<Slot>(capacity);
+    m_usedSlots = m_count;
+    size_t mask = capacity - 1;
+    for (Slot &slot : old)
+    {
+        if (slot.state != SlotState::Occupied)
+        {
+            continue;
+        }
+        size_t i = slot.hash & mask;
+        while (m_slots[i].state != SlotState::Empty)
+        {
+            i = (i + 1) & mask;
+        }
+        // references simply move to the new slot, so counters stay the same
+        m_slots[i] = std::move(slot);
+    }
+    updateAccountedSize();
+}
+
+void Engine::MapObject::releaseSlots(bool releaseValues)
+{
+    if (releaseValues)
+    {
+        for (Slot const &slot : m_slots)
+        {
+            if (slot.state == SlotState::Occupied)
+            {
+                decreaseValueRefCount(slot.key);
+                decreaseValueRefCount(slot.value);
+            }
+        }
+    }
+    m_slots.clear();
+    m_count = 0;
+    m_usedSlots = 0;
+}
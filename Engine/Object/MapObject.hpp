@@ -0,0 +1,95 @@
+#pragma once
+#include <vector>
+#include <optional>
+#include "MemoryObject.hpp"
+#include "../Execution/Value.hpp"
+
+namespace Engine
+{
+    /// @brief Hash map from ints, strings or object handles to any values.
+    /// Uses open addressing with linear probing so lookups only touch a single contiguous array
+    class MapObject : public MemoryObject
+    {
+    public:
+        explicit MapObject() = default;
+
+        std::string toString(Scene const &scene) const override;
+
+        size_t getAllocatedSize() const override;
+
+        MemoryObjectKind getKind() const override { return MemoryObjectKind::Map; }
+
+        void dropReferences() override;
+
+        void releaseReferences() override;
+
+        void traceReferences(GarbageCollector &collector) const override;
+
+        /// @brief Check if value can be used as a key in the map
+        static bool isValidKey(Value const &key);
+
+        /// @brief Get value stored under the key
+        /// @param key Key to look for
+        /// @return Value or nothing if key is not present
+        std::optional<Value> get(Value const &key) const;
+
+        /// @brief Set value stored under the key, adding the key if it's not present. Throws error if key is not of valid type
+        /// @param key Key of the value
+        /// @param value New value
+        void set(Value const &key, Value const &value);
+
+        bool has(Value const &key) const;
+
+        /// @brief Remove key and value stored under it
+        /// @param key Key to remove
+        /// @return True if key was present
+        bool remove(Value const &key);
+
+        /// @brief Remove all keys and values
+        void clear();
+
+        size_t getCount() const { return m_count; }
+
+        std::vector<Value> getKeys() const;
+
+        std::vector<Value> getValues() const;
+
+        virtual ~MapObject();
+
+    private:
+        enum class SlotState : uint8_t
+        {
+            Empty,
+            Occupied,
+            // slot was used by a removed key, lookups have to continue past it
+            Removed
+        };
+
+        struct Slot
+        {
+            Value key;
+            Value value;
+            size_t hash = 0;
+            SlotState state = SlotState::Empty;
+        };
+
+        static size_t hashKey(Value const &key);
+
+        static bool areKeysEqual(Value const &a, Value const &b);
+
+        /// @brief Find slot that stores the key
+        /// @return Index of the slot or nothing if key is not present
+        std::optional<size_t> findSlot(Value const &key, size_t hash) const;
+
+        /// @brief Rebuild storage with given capacity, removing all tombstones
+        void rehash(size_t capacity);
+
+        void releaseSlots(bool releaseValues);
+
+        std::vector<Slot> m_slots;
+        /// @brief Amount of stored keys
+        size_t m_count = 0;
+        /// @brief Amount of slots that are not empty, including removed ones
+        size_t m_usedSlots = 0;
+    };
+}
@@ -1,4 +1,6 @@
 #include "MemoryObject.hpp"
+#include "../Memory/GarbageCollector.hpp"
+#include <functional>
 
 void Engine::MemoryObject::increaseRefCounter()
 {
@@ -8,4 +10,42 @@ void Engine::MemoryObject::increaseRefCounter()
 void Engine::MemoryObject::decreaseRefCounter()
 {
     m_refCount--;
+    if (m_refCount <= 0 && m_collector != nullptr)
+    {
+        m_collector->addCandidate(this);
+    }
+}
+
+void Engine::MemoryObject::updateAccountedSize()
+{
+    // temporary objects live in the frame storage, which records every allocation on its own
+    if (m_collector != nullptr && !m_temporary)
+    {
+        m_collector->updateAccountedSize(this);
+    }
+}
+
+Engine::StringObject::StringObject(std::string const &str, bool interned) : m_string(str), m_interned(interned)
+{
+    if (interned)
+    {
+        m_hash = std::hash<std::string_view>{}(m_string);
+    }
+}
+
+Engine::StringObject::StringObject(std::pmr::memory_resource *resource, std::string_view str) : m_string(str, resource)
+{
+}
+
+bool Engine::StringObject::equals(StringObject const *other) const
+{
+    if (this == other)
+    {
+        return true;
+    }
+    if (m_interned && other->m_interned && m_hash != other->m_hash)
+    {
+        return false;
+    }
+    return m_string == other->m_string;
 }
\ No newline at end of file
@@ -1,9 +1,15 @@
 #pragma once
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <memory_resource>
 #include <iostream>
+#include "../Memory/MemoryStatistics.hpp"
 namespace Engine
 {
+    class Scene;
+    class GarbageCollector;
+
     /// @brief Base object for anything that need to be memory managed in some way
     class MemoryObject
     {
@@ -17,29 +23,107 @@ namespace Engine
         void decreaseRefCounter();
 
         /// @brief Should this object be deleted by the garbage collector
-        bool isDead() const { return m_dead || m_refCount == 0; }
+        bool isDead() const { return m_refCount <= 0; }
+
+        int32_t getRefCount() const { return m_refCount; }
+
+        /// @brief Record the current size of the object in the memory usage of its collector.
+        /// Must be called by code that grows or shrinks the object, since sizes are not measured again otherwise
+        void updateAccountedSize();
+
+        /// @brief Get number that identifies this object. When built with SIMPLEGAMETOOL_OBJECT_IDS the number is unique among all objects ever created by its collector,
+        /// otherwise address of the object is used, which can be given to a new object once this one is freed
+#ifdef SIMPLEGAMETOOL_OBJECT_IDS
+        uint64_t getId() const { return m_id; }
+#else
+        uint64_t getId() const { return (uint64_t)(uintptr_t)this; }
+#endif
 
         /// @brief Get string representation of this object, used for printing and such
-        virtual std::string toString() const = 0;
+        /// @param scene Scene used to resolve any object handles stored inside
+        virtual std::string toString(Scene const &scene) const = 0;
+
+        /// @brief Get approximate amount of bytes used by this object, including any memory owned by it
+        virtual size_t getAllocatedSize() const = 0;
+
+        /// @brief Get kind of the object, used for grouping objects in memory statistics
+        virtual MemoryObjectKind getKind() const = 0;
+
+        /// @brief Forget about all of the stored references without updating reference counters of the referenced objects.
+        /// Used when referenced objects are going to be freed together with this one
+        virtual void dropReferences() {}
+
+        /// @brief Release all of the stored references, updating reference counters of the referenced objects
+        virtual void releaseReferences() {}
+
+        /// @brief Pass every value stored in this object to the collector so that it could mark them as reachable
+        /// @param collector Collector performing the trace
+        virtual void traceReferences([[maybe_unused]] GarbageCollector &collector) const {}
 
         virtual ~MemoryObject() {}
 
     private:
-        bool m_dead = false;
+        friend class GarbageCollector;
+
+#ifdef SIMPLEGAMETOOL_OBJECT_IDS
+        uint64_t m_id = 0;
+#endif
+        /// @brief Collector that owns this object or null if object is not managed by any collector
+        GarbageCollector *m_collector = nullptr;
+        /// @brief Position of the object in the list of all objects of the collector
+        size_t m_heapIndex = 0;
+        /// @brief How many bytes were reserved for this object by the collector
+        uint32_t m_allocationSize = 0;
+        /// @brief Size of the object at the moment of creation, used for keeping track of memory usage
+        uint32_t m_accountedSize = 0;
+        // kept next to the other 32 bit fields so that the header has no padding
         int32_t m_refCount = 0;
+        /// @brief Is the object currently in the list of objects that might be garbage
+        bool m_queuedForCollection = false;
+        /// @brief Is the object referenced by one of the roots that don't count towards reference counter
+        bool m_rootReferenced = false;
+        /// @brief Was the object reached during the last tracing pass
+        bool m_reachable = false;
+        /// @brief Was the object allocated in the frame storage of the collector. Such objects are never queued for collection and are all freed at once at the end of the frame
+        bool m_temporary = false;
     };
 
     /// @brief Wrapper around native string that can be stored in the managed memory of the engine
     class StringObject : public MemoryObject
     {
     public:
-        explicit StringObject(std::string const &str) : m_string(str) {}
+        /// @brief Create a new string object
+        /// @param str Text of the string
+        /// @param interned If true the string is treated as an immortal constant that must never be modified
+        explicit StringObject(std::string const &str, bool interned = false);
+
+        /// @brief Create a new string object that keeps its text in the given memory resource
+        /// @param resource Resource used for the text
+        /// @param str Text of the string
+        explicit StringObject(std::pmr::memory_resource *resource, std::string_view str);
+
+        std::pmr::string &getString() { return m_string; }
+
+        std::pmr::string const &getString() const { return m_string; }
+
+        std::string toString(Scene const &) const override { return std::string(m_string); }
+
+        size_t getAllocatedSize() const override { return sizeof(StringObject) + (m_string.capacity() > 15 ? m_string.capacity() : 0); }
+
+        MemoryObjectKind getKind() const override { return MemoryObjectKind::String; }
+
+        /// @brief Is this string a shared constant created from the code string table
+        bool isInterned() const { return m_interned; }
 
-        std::string &getString() { return m_string; }
+        /// @brief Get hash of the text, only available for interned strings since other strings can be modified
+        size_t getHash() const { return m_hash; }
 
-        std::string toString() const override { return m_string; }
+        /// @brief Check if both strings have the same text, avoiding full comparison when possible
+        bool equals(StringObject const *other) const;
 
     private:
-        std::string m_string;
+        std::pmr::string m_string;
+        size_t m_hash = 0;
+        bool m_interned = false;
     };
-}
\ No newline at end of file
+}
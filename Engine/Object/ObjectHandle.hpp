@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+namespace Engine
+{
+    /// @brief Weak reference to a game object stored in the scene. Consists of the slot index in the object storage and generation of the slot at the moment of creation.
+    /// Once object is destroyed the generation of the slot changes, so any handle that still points to it can be detected as stale with a single compare
+    struct ObjectHandle
+    {
+        uint32_t index;
+        uint32_t generation;
+
+        bool operator==(ObjectHandle const &other) const = default;
+    };
+}
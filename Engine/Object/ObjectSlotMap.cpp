@@ -0,0 +1,52 @@
+#include "ObjectSlotMap.hpp"
+#include "GameObject.hpp"
+#include <limits>
+
+Engine::GameObject *Engine::ObjectSlotMap::insert(std::unique_ptr<GameObject> object)
+{
+    uint32_t index;
+    if (!m_freeSlots.empty())
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        index = (uint32_t)m_slots.size();
+        m_slots.push_back(Slot{});
+    }
+    object->setHandle(ObjectHandle{.index = index, .generation = m_slots[index].generation});
+    m_slots[index].object = std::move(object);
+    return m_slots[index].object.get();
+}
+
+Engine::GameObject *Engine::ObjectSlotMap::get(ObjectHandle handle) const
+{
+    if (!isAlive(handle))
+    {
+        return nullptr;
+    }
+    return m_slots[handle.index].object.get();
+}
+
+std::unique_ptr<Engine::GameObject> Engine::ObjectSlotMap::remove(ObjectHandle handle)
+{
+    if (!isAlive(handle))
+    {
+        return nullptr;
+    }
+    Slot &slot = m_slots[handle.index];
+    std::unique_ptr<GameObject> obj = std::move(slot.object);
+    // if generation would wrap around old handles could become valid again, so slot is simply never used again
+    if (slot.generation == std::numeric_limits<uint32_t>::max())
+    {
+        slot.generation = 0;
+        m_retiredSlotCount++;
+    }
+    else
+    {
+        slot.generation++;
+        m_freeSlots.push_back(handle.index);
+    }
+    return obj;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "ObjectHandle.hpp"
+
+namespace Engine
+{
+    class GameObject;
+
+    /// @brief Storage for game objects that gives out generational handles instead of raw pointers.
+    /// Slots of removed objects are reused right away, handles pointing to the old object are detected by comparing generation of the slot
+    class ObjectSlotMap
+    {
+    public:
+        explicit ObjectSlotMap() = default;
+
+        /// @brief Add object to the storage and assign handle to it
+        /// @param object Object to store
+        /// @return Pointer to the stored object
+        GameObject *insert(std::unique_ptr<GameObject> object);
+
+        /// @brief Get object that handle points to
+        /// @param handle Handle of the object
+        /// @return Pointer to the object or null if handle is stale
+        GameObject *get(ObjectHandle handle) const;
+
+        /// @brief Check if object that handle points to is still present in the storage
+        /// @param handle Handle to check
+        /// @return True if object is still alive
+        bool isAlive(ObjectHandle handle) const { return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation; }
+
+        /// @brief Remove object from the storage and invalidate all handles pointing to it.
+        /// @param handle Handle of the object to remove
+        /// @return Ownership of the object, so that caller could decide when to free the memory, or null if handle is stale
+        std::unique_ptr<GameObject> remove(ObjectHandle handle);
+
+        /// @brief Get amount of slots in the storage, including slots that are currently free. Used for iterating over the objects
+        size_t getSlotCount() const { return m_slots.size(); }
+
+        /// @brief Get object stored in the slot with given index
+        /// @param index Index of the slot
+        /// @return Object or null if slot is empty
+        GameObject *getAt(size_t index) const { return m_slots[index].object.get(); }
+
+        /// @brief Get amount of objects currently stored
+        size_t getCount() const { return m_slots.size() - m_freeSlots.size() - m_retiredSlotCount; }
+
+    private:
+        struct Slot
+        {
+            std::unique_ptr<GameObject> object;
+            // generation starts with 1 so that zero initialized handles never point to anything
+            uint32_t generation = 1;
+        };
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        /// @brief Amount of slots which ran out of generations and will never be used again
+        size_t m_retiredSlotCount = 0;
+    };
+}
@@ -1,5 +1,6 @@
 #include "ObjectType.hpp"
 #include "../Scene.hpp"
+#include "../TypeManager.hpp"
 
 Engine::ObjectType::ObjectType(std::string const &name,
                                SpriteFramesAsset const *sprite,
@@ -19,6 +20,19 @@ Engine::ObjectType::ObjectType(std::string const &name,
       m_nativeMethods(nativeMethods),
       m_strings(strings)
 {
+    // collision settings are read once since they are needed every time an object moves
+    if (std::optional<Value> layer = getConstant("collision_layer"); layer.has_value() && layer->index() == ValueType::Integer)
+    {
+        m_collisionLayer = (uint32_t)std::get<IntType>(layer.value());
+    }
+    if (std::optional<Value> mask = getConstant("collision_mask"); mask.has_value() && mask->index() == ValueType::Integer)
+    {
+        m_collisionMask = (uint32_t)std::get<IntType>(mask.value());
+    }
+    m_hasCollisionHandlers = hasMethod("on_collision_enter") || hasMethod("on_collision_exit");
+    // policy and body are checked here so that a broken type fails once when it's loaded instead of on every instance
+    m_defaultUpdatePolicy = readUpdatePolicy();
+    m_bodyType = readBodyType();
 }
 
 void Engine::ObjectType::callNativeMethod(std::string const &name, Scene &scene) const
@@ -26,7 +40,7 @@ void Engine::ObjectType::callNativeMethod(std::string const &name, Scene &scene)
     m_nativeMethods.at(name)(scene);
 }
 
-std::optional<Engine::Value> Engine::ObjectType::getConstant(std::string const &name, Scene &scene) const
+std::optional<Engine::Value> Engine::ObjectType::getConstant(std::string const &name) const
 {
     if (!m_constants.contains(name))
     {
@@ -43,9 +57,9 @@ std::optional<Engine::Value> Engine::ObjectType::getConstant(std::string const &
         return std::get<double>(m_constants.at(name));
 
     case Runnable::CodeConstantValueType::StringId:
-        if (std::optional<std::string> str = scene.getConstantStringById(std::get<size_t>(m_constants.at(name))); str.has_value())
+        if (m_strings.has(std::get<size_t>(m_constants.at(name))))
         {
-            return scene.createString(str.value());
+            return m_strings.get(std::get<size_t>(m_constants.at(name)));
         }
         else
         {
@@ -57,3 +71,58 @@ std::optional<Engine::Value> Engine::ObjectType::getConstant(std::string const &
     }
     return {};
 }
+
+Engine::UpdatePolicy Engine::ObjectType::readUpdatePolicy() const
+{
+    UpdatePolicy policy;
+    if (m_constants.contains("update_interval") && m_constants.contains("update_margin"))
+    {
+        // each constant enables a different mode, so having both is most likely a mistake
+        throw TypeError("Type '" + m_name + "' can not have both 'update_interval' and 'update_margin'");
+    }
+    if (std::optional<Value> interval = getConstant("update_interval"); interval.has_value() && interval->index() == ValueType::Integer)
+    {
+        policy.mode = UpdateMode::Interval;
+        policy.interval = (uint32_t)std::max<IntType>(1, std::get<IntType>(interval.value()));
+    }
+    if (std::optional<Value> margin = getConstant("update_margin"); margin.has_value())
+    {
+        policy.mode = UpdateMode::InRegion;
+        if (margin->index() == ValueType::Float)
+        {
+            policy.margin = (float)std::get<FloatType>(margin.value());
+        }
+        else if (margin->index() == ValueType::Integer)
+        {
+            policy.margin = (float)std::get<IntType>(margin.value());
+        }
+    }
+    if (std::optional<Value> asleep = getConstant("start_asleep"); asleep.has_value() && asleep->index() == ValueType::Bool)
+    {
+        policy.startAsleep = std::get<bool>(asleep.value());
+    }
+    return policy;
+}
+
+std::optional<Engine::BodyType> Engine::ObjectType::readBodyType() const
+{
+    std::optional<Value> body = getConstant("body");
+    if (!body.has_value() || body->index() != ValueType::String)
+    {
+        return {};
+    }
+    std::string name(std::get<StringObject *>(body.value())->getString());
+    if (name == "static")
+    {
+        return BodyType::Static;
+    }
+    if (name == "kinematic")
+    {
+        return BodyType::Kinematic;
+    }
+    if (name == "dynamic")
+    {
+        return BodyType::Dynamic;
+    }
+    throw TypeError("Unknown body type '" + name + "' in type '" + m_name + "', expected static, kinematic or dynamic");
+}
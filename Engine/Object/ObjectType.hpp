@@ -4,6 +4,9 @@
 #include "../Content/Asset.hpp"
 #include "../Execution/Value.hpp"
 #include "../Execution/Runnable.hpp"
+#include "../Memory/InternedStringTable.hpp"
+#include "UpdatePolicy.hpp"
+#include "../Physics/PhysicsWorld.hpp"
 
 namespace Engine
 {
@@ -43,27 +46,59 @@ namespace Engine
 
         void callNativeMethod(std::string const &name, Scene &scene) const;
 
-        inline std::string const &getStringAt(size_t id) const { return m_strings.at(id); }
+        inline std::string const &getStringAt(size_t id) const { return m_strings.getText(id); }
 
-        bool hasStringAt(size_t id) const { return id < m_strings.size(); }
+        /// @brief Get shared string object for the string constant of this type
+        inline StringObject *getStringObjectAt(size_t id) const { return m_strings.get(id); }
+
+        bool hasStringAt(size_t id) const { return m_strings.has(id); }
 
         std::string const &getName() const { return m_name; }
 
         /// @brief Try getting the constant field
         /// @param name Name of the field to get
-        /// @param scene Scene used for resolving strings, if constant references a string scene will be used to create string object
-        /// @return Value containing constant or none if no constant uses that name
-        std::optional<Value> getConstant(std::string const &name, Scene &scene) const;
+        /// @return Value containing constant or none if no constant uses that name. String constants use shared string objects of the type
+        std::optional<Value> getConstant(std::string const &name) const;
+
+        /// @brief Get update policy for new instances of this type as described by type constants.
+        /// `update_interval` enables interval mode, `update_margin` enables region mode and `start_asleep` makes new objects start asleep
+        UpdatePolicy const &getDefaultUpdatePolicy() const { return m_defaultUpdatePolicy; }
+
+        /// @brief Get bit mask of collision layers that instances of this type belong to, set by `collision_layer` constant. Defaults to the first layer
+        uint32_t getCollisionLayer() const { return m_collisionLayer; }
+
+        /// @brief Get bit mask of collision layers that instances of this type can collide with, set by `collision_mask` constant. Defaults to every layer
+        uint32_t getCollisionMask() const { return m_collisionMask; }
+
+        /// @brief Check if instances of this type can collide with instances of the other type. Both types have to accept each other's layers
+        bool canCollideWith(ObjectType const *other) const { return (m_collisionMask & other->m_collisionLayer) != 0 && (other->m_collisionMask & m_collisionLayer) != 0; }
+
+        /// @brief Get type of the physics body that instances of this type get, set by `body` constant to "static", "kinematic" or "dynamic". Types without it have no body
+        std::optional<BodyType> getBodyType() const { return m_bodyType; }
+
+        /// @brief Does the type define `on_collision_enter` or `on_collision_exit` methods. Only such types take part in contact generation
+        bool hasCollisionHandlers() const { return m_hasCollisionHandlers; }
 
     private:
+        /// @brief Read update policy from the type constants or throw `TypeError` if type has both interval and margin
+        UpdatePolicy readUpdatePolicy() const;
+
+        /// @brief Read body type from the type constants or throw `TypeError` if name of the body type is unknown
+        std::optional<BodyType> readBodyType() const;
+
         std::string m_name;
         std::unordered_map<std::string, Runnable::RunnableFunction> m_methods;
         SpriteFramesAsset const *m_sprite;
         ObjectType const *m_parent;
         std::unordered_map<std::string, Runnable::CodeConstantValue> m_fields;
         std::unordered_map<std::string, Runnable::CodeConstantValue> m_constants;
-        std::vector<std::string> m_strings;
         std::unordered_map<std::string, std::function<void(Scene &scene)>> m_nativeMethods;
+        InternedStringTable m_strings;
+        uint32_t m_collisionLayer = 1;
+        uint32_t m_collisionMask = 0xffffffff;
+        bool m_hasCollisionHandlers = false;
+        UpdatePolicy m_defaultUpdatePolicy;
+        std::optional<BodyType> m_bodyType;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "ParticleEmitterObject.hpp"
+#include "../Error.hpp"
+
+/// @brief Get settings of the effect or throw error if there is no such effect
+static Engine::ParticleSettings const &getEffectSettings(std::string const &effectName)
+{
+    if (Engine::ParticleEffectAsset const *effect = Engine::ContentManager::getInstance().getParticleAsset(effectName); effect != nullptr)
+    {
+        return effect->getSettings();
+    }
+    throw Engine::Errors::ContentError("No particle effect asset named '" + effectName + "'");
+}
+
+Engine::ParticleEmitterObject::ParticleEmitterObject(ObjectType const *type, std::string const &name, Scene &scene, std::string const &effectName)
+    : GameObject(type, name, scene), m_particles(getEffectSettings(effectName))
+{
+    ParticleSettings const &settings = m_particles.getSettings();
+    if (settings.sprite.empty())
+    {
+        return;
+    }
+    SpriteFramesAsset const *sprite = ContentManager::getInstance().getAnimationAsset(settings.sprite);
+    if (sprite == nullptr)
+    {
+        throw Errors::ContentError("Particle effect '" + effectName + "' uses sprite '" + settings.sprite + "' which doesn't exist");
+    }
+    m_texture = ContentManager::getInstance().loadTexture(sprite->getPath());
+    if (!settings.animation.empty() && sprite->hasAnimation(settings.animation))
+    {
+        m_frames = sprite->getFrames(settings.animation).frames;
+    }
+    else
+    {
+        m_frames.push_back(sprite->getDefaultFrame());
+    }
+}
+
+void Engine::ParticleEmitterObject::update(float delta)
+{
+    GameObject::update(delta);
+    m_particles.update(delta, getBounds());
+}
+
+void Engine::ParticleEmitterObject::draw(sf::RenderWindow &window)
+{
+    if (isDestroyed() || m_particles.getCount() == 0)
+    {
+        return;
+    }
+    // vertex array keeps its capacity, so after the first few frames building vertices does not allocate
+    m_particles.buildVertices(m_vertices, m_frames);
+    window.draw(m_vertices, sf::RenderStates(m_texture));
+}
+
+size_t Engine::ParticleEmitterObject::getAllocatedSize() const
+{
+    return GameObject::getAllocatedSize() - sizeof(GameObject) + sizeof(ParticleEmitterObject) + m_particles.getAllocatedSize() + m_frames.capacity() * sizeof(sf::IntRect);
+}
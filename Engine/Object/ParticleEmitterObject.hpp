@@ -0,0 +1,40 @@
+#pragma once
+#include "GameObject.hpp"
+#include "../Particles/ParticleSystem.hpp"
+#include <SFML/Graphics.hpp>
+
+namespace Engine
+{
+    /// @brief Object that spawns and draws particles of a single effect. Particles are not objects themselves and are all drawn with one draw call.
+    /// New particles are placed randomly in the area of the object and keep moving in world space once spawned
+    class ParticleEmitterObject : public GameObject
+    {
+    public:
+        /// @param effectName Name of the particle effect asset
+        explicit ParticleEmitterObject(ObjectType const *type, std::string const &name, Scene &scene, std::string const &effectName);
+
+        void update(float delta) override;
+
+        void draw(sf::RenderWindow &window) override;
+
+        /// @brief Start spawning particles continuously at the rate of the effect
+        void emit() { m_particles.setEmitting(true); }
+
+        /// @brief Spawn particles at once
+        void burst(size_t count) { m_particles.burst(count, getBounds()); }
+
+        /// @brief Stop spawning new particles, already spawned particles live out their lifetime
+        void stop() { m_particles.setEmitting(false); }
+
+        size_t getParticleCount() const { return m_particles.getCount(); }
+
+        size_t getAllocatedSize() const override;
+
+    private:
+        ParticleSystem m_particles;
+        sf::Texture const *m_texture = nullptr;
+        /// @brief Texture rects of the frames particles go through during their lifetime
+        std::vector<sf::IntRect> m_frames;
+        sf::VertexArray m_vertices;
+    };
+}
@@ -0,0 +1,72 @@
+#include "StructObject.hpp"
+#include <memory>
+#include "../Memory/GarbageCollector.hpp"
+
+static_assert(alignof(Engine::Value) <= alignof(Engine::StructObject), "Struct fields must be aligned when placed right after the object");
+
+Engine::StructObject::StructObject(StructType const *type) : m_type(type)
+{
+    std::uninitialized_copy(type->getDefaultValues().begin(), type->getDefaultValues().end(), getFieldStorage());
+    for (Value const &v : getFields())
+    {
+        increaseValueRefCount(v);
+    }
+}
+
+void Engine::StructObject::setField(size_t slot, Value const &v)
+{
+    increaseValueRefCount(v);
+    decreaseValueRefCount(getFieldStorage()[slot]);
+    getFieldStorage()[slot] = v;
+}
+
+std::string Engine::StructObject::toString(Scene const &scene) const
+{
+    std::string result = m_type->getName() + "{";
+    for (size_t i = 0; i < m_type->getFieldCount(); i++)
+    {
+        result += m_type->getFieldName(i) + ":" + valueToString(getField(i), scene);
+        if (i != m_type->getFieldCount() - 1)
+        {
+            result += ',';
+        }
+    }
+    return result + "}";
+}
+
+void Engine::StructObject::dropReferences()
+{
+    clearFields(false);
+}
+
+void Engine::StructObject::releaseReferences()
+{
+    clearFields(true);
+}
+
+void Engine::StructObject::traceReferences(GarbageCollector &collector) const
+{
+    for (Value const &v : getFields())
+    {
+        collector.markReachable(v);
+    }
+}
+
+Engine::StructObject::~StructObject()
+{
+    clearFields(true);
+    std::destroy_n(getFieldStorage(), m_type->getFieldCount());
+}
+
+void Engine::StructObject::clearFields(bool releaseValues)
+{
+    Value *fields = getFieldStorage();
+    for (size_t i = 0; i < m_type->getFieldCount(); i++)
+    {
+        if (releaseValues)
+        {
+            decreaseValueRefCount(fields[i]);
+        }
+        fields[i] = NilValue;
+    }
+}
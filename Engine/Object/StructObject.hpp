@@ -0,0 +1,54 @@
+#pragma once
+#include <span>
+#include "MemoryObject.hpp"
+#include "StructType.hpp"
+#include "../Execution/Value.hpp"
+
+namespace Engine
+{
+    /// @brief Instance of a user declared struct. Field values are stored right after the object in the same allocation,
+    /// so struct should only be created using `GarbageCollector::createSized` with size from `getAllocationSize`
+    class StructObject : public MemoryObject
+    {
+    public:
+        /// @brief Create a new struct instance with fields set to default values
+        /// @param type Layout of the struct
+        explicit StructObject(StructType const *type);
+
+        /// @brief Get amount of bytes needed to store struct of given type together with all of its fields
+        static size_t getAllocationSize(StructType const *type) { return sizeof(StructObject) + type->getFieldCount() * sizeof(Value); }
+
+        StructType const *getType() const { return m_type; }
+
+        Value const &getField(size_t slot) const { return getFieldStorage()[slot]; }
+
+        void setField(size_t slot, Value const &v);
+
+        std::span<Value const> getFields() const { return std::span<Value const>(getFieldStorage(), m_type->getFieldCount()); }
+
+        std::string toString(Scene const &scene) const override;
+
+        size_t getAllocatedSize() const override { return getAllocationSize(m_type); }
+
+        MemoryObjectKind getKind() const override { return MemoryObjectKind::Struct; }
+
+        void dropReferences() override;
+
+        void releaseReferences() override;
+
+        void traceReferences(GarbageCollector &collector) const override;
+
+        virtual ~StructObject();
+
+    private:
+        Value *getFieldStorage() { return reinterpret_cast<Value *>(this + 1); }
+
+        Value const *getFieldStorage() const { return reinterpret_cast<Value const *>(this + 1); }
+
+        /// @brief Set every field to nil
+        /// @param releaseValues Should reference counters of the previous values be decreased
+        void clearFields(bool releaseValues);
+
+        StructType const *m_type;
+    };
+}
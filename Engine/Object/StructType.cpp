@@ -0,0 +1,49 @@
+#include "StructType.hpp"
+#include <stdexcept>
+
+Engine::StructType::StructType(std::string const &name,
+                               std::vector<std::string> const &fieldNames,
+                               std::vector<Runnable::CodeConstantValue> const &defaults,
+                               std::vector<std::string> const &strings)
+    : m_name(name), m_fieldNames(fieldNames), m_strings(strings)
+{
+    for (size_t i = 0; i < m_fieldNames.size(); i++)
+    {
+        m_fieldSlots[m_fieldNames[i]] = i;
+    }
+    m_defaults.reserve(defaults.size());
+    for (Runnable::CodeConstantValue const &val : defaults)
+    {
+        switch ((Runnable::CodeConstantValueType)val.index())
+        {
+        case Runnable::CodeConstantValueType::Bool:
+            m_defaults.push_back(std::get<bool>(val));
+            break;
+        case Runnable::CodeConstantValueType::Int:
+            m_defaults.push_back(std::get<int64_t>(val));
+            break;
+        case Runnable::CodeConstantValueType::Float:
+            m_defaults.push_back(std::get<double>(val));
+            break;
+        case Runnable::CodeConstantValueType::StringId:
+            if (!m_strings.has(std::get<size_t>(val)))
+            {
+                throw std::runtime_error("Failed to find string");
+            }
+            m_defaults.push_back(m_strings.get(std::get<size_t>(val)));
+            break;
+        case Runnable::CodeConstantValueType::Vector:
+            m_defaults.push_back(std::get<sf::Vector2f>(val));
+            break;
+        }
+    }
+}
+
+std::optional<size_t> Engine::StructType::getFieldSlot(std::string const &name) const
+{
+    if (auto it = m_fieldSlots.find(name); it != m_fieldSlots.end())
+    {
+        return it->second;
+    }
+    return {};
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <optional>
+#include <unordered_map>
+#include "../Execution/Value.hpp"
+#include "../Execution/Runnable.hpp"
+#include "../Memory/InternedStringTable.hpp"
+
+namespace Engine
+{
+    /// @brief Layout of a user declared struct. Fields are stored in slots in the order of declaration
+    class StructType
+    {
+    public:
+        /// @brief Create a new struct layout
+        /// @param name Name of the struct
+        /// @param fieldNames Names of the fields in order of declaration
+        /// @param defaults Default values of the fields in the same order as names
+        /// @param strings Strings referenced by the default values
+        explicit StructType(std::string const &name,
+                            std::vector<std::string> const &fieldNames,
+                            std::vector<Runnable::CodeConstantValue> const &defaults,
+                            std::vector<std::string> const &strings = {});
+
+        std::string const &getName() const { return m_name; }
+
+        size_t getFieldCount() const { return m_fieldNames.size(); }
+
+        std::string const &getFieldName(size_t slot) const { return m_fieldNames[slot]; }
+
+        /// @brief Get slot used by the field with given name
+        /// @param name Name of the field
+        /// @return Slot index or None if struct has no such field
+        std::optional<size_t> getFieldSlot(std::string const &name) const;
+
+        /// @brief Values new instances start with. String values use shared string objects of the struct
+        std::vector<Value> const &getDefaultValues() const { return m_defaults; }
+
+    private:
+        std::string m_name;
+        std::vector<std::string> m_fieldNames;
+        std::unordered_map<std::string, size_t> m_fieldSlots;
+        InternedStringTable m_strings;
+        std::vector<Value> m_defaults;
+    };
+}
@@ -30,3 +30,9 @@ void Engine::TextObject::setFontSize(IntType size)
 {
     m_text.setCharacterSize(size);
 }
+
+size_t Engine::TextObject::getAllocatedSize() const
+{
+    // text keeps its string as utf-32 together with generated vertices, only the string is counted
+    return GameObject::getAllocatedSize() - sizeof(GameObject) + sizeof(TextObject) + m_text.getString().getSize() * sizeof(char32_t);
+}
@@ -17,6 +17,10 @@ namespace Engine
         void setPosition(sf::Vector2f pos) override;
 
         void setFontSize(IntType size);
+
+        IntType getFontSize() const { return (IntType)m_text.getCharacterSize(); }
+
+        size_t getAllocatedSize() const override;
     private:
         sf::Text m_text;
     };
@@ -0,0 +1,254 @@
+#include "TilemapObject.hpp"
+#include <cmath>
+#include <algorithm>
+
+/// @brief Tolerance used when deciding if a box edge lies exactly on a tile edge, in fractions of a tile
+static constexpr float EdgeTolerance = 0.0001f;
+
+Engine::TilemapObject::TilemapObject(ObjectType const *type, std::string const &name, Scene &scene, std::string const &tilesetName, sf::Vector2i mapSize, sf::Vector2f tileSize)
+    : GameObject(type, name, scene),
+      m_tileset(ContentManager::getInstance().getAnimationAsset(tilesetName)),
+      m_texture(m_tileset != nullptr ? ContentManager::getInstance().loadTexture(m_tileset->getPath()) : nullptr),
+      m_mapSize(std::max(mapSize.x, 0), std::max(mapSize.y, 0)),
+      m_baseTileSize(tileSize),
+      m_tiles((size_t)m_mapSize.x * m_mapSize.y, 0),
+      m_chunkCount((m_mapSize.x + ChunkSize - 1) / ChunkSize, (m_mapSize.y + ChunkSize - 1) / ChunkSize),
+      m_chunks((size_t)m_chunkCount.x * m_chunkCount.y)
+{
+    setSize(sf::Vector2f(tileSize.x * (float)m_mapSize.x, tileSize.y * (float)m_mapSize.y));
+}
+
+void Engine::TilemapObject::draw(sf::RenderWindow &window)
+{
+    if (isDestroyed() || m_texture == nullptr || m_mapSize.x == 0 || m_mapSize.y == 0)
+    {
+        return;
+    }
+    sf::Vector2f tileSize = getTileSize();
+    sf::Vector2f scale(tileSize.x / m_baseTileSize.x, tileSize.y / m_baseTileSize.y);
+    sf::RenderStates states(m_texture);
+    states.transform.translate(getPosition()).scale(scale);
+
+    // only chunks that can be seen are built and drawn
+    sf::View const &view = window.getView();
+    sf::Vector2f viewStart = view.getCenter() - view.getSize() / 2.f;
+    sf::Vector2f viewEnd = view.getCenter() + view.getSize() / 2.f;
+    sf::Vector2f chunkSize = tileSize * (float)ChunkSize;
+    int32_t firstX = std::max((int32_t)std::floor((viewStart.x - getPosition().x) / chunkSize.x), 0);
+    int32_t firstY = std::max((int32_t)std::floor((viewStart.y - getPosition().y) / chunkSize.y), 0);
+    int32_t lastX = std::min((int32_t)std::floor((viewEnd.x - getPosition().x) / chunkSize.x), m_chunkCount.x - 1);
+    int32_t lastY = std::min((int32_t)std::floor((viewEnd.y - getPosition().y) / chunkSize.y), m_chunkCount.y - 1);
+    for (int32_t y = firstY; y <= lastY; y++)
+    {
+        for (int32_t x = firstX; x <= lastX; x++)
+        {
+            size_t index = (size_t)y * m_chunkCount.x + x;
+            if (m_chunks[index].dirty)
+            {
+                buildChunk(index);
+            }
+            if (m_chunks[index].vertices.getVertexCount() > 0)
+            {
+                window.draw(m_chunks[index].vertices, states);
+            }
+        }
+    }
+}
+
+sf::Vector2f Engine::TilemapObject::getTileSize() const
+{
+    if (m_mapSize.x == 0 || m_mapSize.y == 0)
+    {
+        return m_baseTileSize;
+    }
+    return sf::Vector2f(getSize().x / (float)m_mapSize.x, getSize().y / (float)m_mapSize.y);
+}
+
+Engine::TileId Engine::TilemapObject::getTile(sf::Vector2i cell) const
+{
+    if (!isInside(cell))
+    {
+        return 0;
+    }
+    return m_tiles[(size_t)cell.y * m_mapSize.x + cell.x];
+}
+
+void Engine::TilemapObject::setTile(sf::Vector2i cell, TileId tile)
+{
+    if (!isInside(cell) || getTile(cell) == tile)
+    {
+        return;
+    }
+    m_tiles[(size_t)cell.y * m_mapSize.x + cell.x] = tile;
+    m_chunks[getChunkIndex(cell)].dirty = true;
+}
+
+void Engine::TilemapObject::setTiles(std::vector<TileId> const &tiles)
+{
+    std::fill(m_tiles.begin(), m_tiles.end(), 0);
+    std::copy_n(tiles.begin(), std::min(tiles.size(), m_tiles.size()), m_tiles.begin());
+    for (Chunk &chunk : m_chunks)
+    {
+        chunk.dirty = true;
+    }
+}
+
+sf::Vector2i Engine::TilemapObject::getCell(sf::Vector2f position) const
+{
+    sf::Vector2f tileSize = getTileSize();
+    return sf::Vector2i((int32_t)std::floor((position.x - getPosition().x) / tileSize.x), (int32_t)std::floor((position.y - getPosition().y) / tileSize.y));
+}
+
+void Engine::TilemapObject::setTileSolid(TileId tile, bool solid)
+{
+    if (tile >= m_solidTiles.size())
+    {
+        m_solidTiles.resize((size_t)tile + 1, m_solidByDefault ? 1 : 0);
+    }
+    m_solidTiles[tile] = solid ? 1 : 0;
+}
+
+bool Engine::TilemapObject::isTileSolid(TileId tile) const
+{
+    if (tile == 0)
+    {
+        return false;
+    }
+    return tile < m_solidTiles.size() ? m_solidTiles[tile] != 0 : m_solidByDefault;
+}
+
+bool Engine::TilemapObject::isAreaSolid(sf::FloatRect const &area) const
+{
+    float left = std::min(area.position.x, area.position.x + area.size.x);
+    float top = std::min(area.position.y, area.position.y + area.size.y);
+    auto [firstX, lastX] = getCellSpan(left, left + std::abs(area.size.x), true);
+    auto [firstY, lastY] = getCellSpan(top, top + std::abs(area.size.y), false);
+    for (int32_t y = firstY; y <= lastY; y++)
+    {
+        if (isLineSolid(y, firstX, lastX, false))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+sf::Vector2f Engine::TilemapObject::sweep(sf::FloatRect const &box, sf::Vector2f motion) const
+{
+    sf::FloatRect moved = box;
+    float x = sweepAxis(moved, motion.x, true);
+    moved.position.x += x;
+    float y = sweepAxis(moved, motion.y, false);
+    return sf::Vector2f(x, y);
+}
+
+float Engine::TilemapObject::sweepAxis(sf::FloatRect const &box, float motion, bool horizontal) const
+{
+    if (motion == 0.f)
+    {
+        return 0.f;
+    }
+    float tile = horizontal ? getTileSize().x : getTileSize().y;
+    float origin = horizontal ? getPosition().x : getPosition().y;
+    float start = horizontal ? box.position.x : box.position.y;
+    float end = start + (horizontal ? box.size.x : box.size.y);
+    float acrossStart = horizontal ? box.position.y : box.position.x;
+    float acrossEnd = acrossStart + (horizontal ? box.size.y : box.size.x);
+    auto [from, to] = getCellSpan(acrossStart, acrossEnd, !horizontal);
+    int32_t lineCount = horizontal ? m_mapSize.x : m_mapSize.y;
+    if (motion > 0.f)
+    {
+        // only lines that begin at or after the leading edge of the box can stop it
+        int32_t first = std::max((int32_t)std::ceil((end - origin) / tile - EdgeTolerance), 0);
+        int32_t last = std::min((int32_t)std::ceil((end + motion - origin) / tile) - 1, lineCount - 1);
+        for (int32_t line = first; line <= last; line++)
+        {
+            if (isLineSolid(line, from, to, horizontal))
+            {
+                return std::clamp(origin + (float)line * tile - end, 0.f, motion);
+            }
+        }
+        return motion;
+    }
+    int32_t first = std::min((int32_t)std::floor((start - origin) / tile + EdgeTolerance) - 1, lineCount - 1);
+    int32_t last = std::max((int32_t)std::floor((start + motion - origin) / tile), 0);
+    for (int32_t line = first; line >= last; line--)
+    {
+        if (isLineSolid(line, from, to, horizontal))
+        {
+            return std::clamp(origin + (float)(line + 1) * tile - start, motion, 0.f);
+        }
+    }
+    return motion;
+}
+
+std::pair<int32_t, int32_t> Engine::TilemapObject::getCellSpan(float start, float end, bool horizontal) const
+{
+    float tile = horizontal ? getTileSize().x : getTileSize().y;
+    float origin = horizontal ? getPosition().x : getPosition().y;
+    int32_t count = horizontal ? m_mapSize.x : m_mapSize.y;
+    // cells that only touch the span with their edge are not included
+    int32_t first = std::max((int32_t)std::floor((start - origin) / tile), 0);
+    int32_t last = std::min((int32_t)std::ceil((end - origin) / tile) - 1, count - 1);
+    return {first, last};
+}
+
+bool Engine::TilemapObject::isLineSolid(int32_t line, int32_t from, int32_t to, bool horizontal) const
+{
+    for (int32_t i = from; i <= to; i++)
+    {
+        if (isCellSolid(horizontal ? sf::Vector2i(line, i) : sf::Vector2i(i, line)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Engine::TilemapObject::buildChunk(size_t index)
+{
+    Chunk &chunk = m_chunks[index];
+    chunk.dirty = false;
+    chunk.vertices.setPrimitiveType(sf::PrimitiveType::Triangles);
+    chunk.vertices.clear();
+    sf::IntRect frame = m_tileset->getDefaultFrame();
+    if (frame.size.x <= 0 || frame.size.y <= 0)
+    {
+        return;
+    }
+    int32_t columns = std::max(((int32_t)m_texture->getSize().x - frame.position.x) / frame.size.x, 1);
+    int32_t chunkX = (int32_t)(index % m_chunkCount.x) * ChunkSize;
+    int32_t chunkY = (int32_t)(index / m_chunkCount.x) * ChunkSize;
+    for (int32_t y = chunkY; y < std::min(chunkY + ChunkSize, m_mapSize.y); y++)
+    {
+        for (int32_t x = chunkX; x < std::min(chunkX + ChunkSize, m_mapSize.x); x++)
+        {
+            TileId tile = m_tiles[(size_t)y * m_mapSize.x + x];
+            if (tile == 0)
+            {
+                continue;
+            }
+            sf::Vector2f texture((float)(frame.position.x + ((tile - 1) % columns) * frame.size.x), (float)(frame.position.y + ((tile - 1) / columns) * frame.size.y));
+            sf::Vector2f textureEnd = texture + sf::Vector2f((float)frame.size.x, (float)frame.size.y);
+            sf::Vector2f position((float)x * m_baseTileSize.x, (float)y * m_baseTileSize.y);
+            sf::Vector2f positionEnd = position + m_baseTileSize;
+            // two triangles per tile
+            chunk.vertices.append(sf::Vertex{.position = position, .texCoords = texture});
+            chunk.vertices.append(sf::Vertex{.position = sf::Vector2f(positionEnd.x, position.y), .texCoords = sf::Vector2f(textureEnd.x, texture.y)});
+            chunk.vertices.append(sf::Vertex{.position = sf::Vector2f(position.x, positionEnd.y), .texCoords = sf::Vector2f(texture.x, textureEnd.y)});
+            chunk.vertices.append(sf::Vertex{.position = sf::Vector2f(position.x, positionEnd.y), .texCoords = sf::Vector2f(texture.x, textureEnd.y)});
+            chunk.vertices.append(sf::Vertex{.position = sf::Vector2f(positionEnd.x, position.y), .texCoords = sf::Vector2f(textureEnd.x, texture.y)});
+            chunk.vertices.append(sf::Vertex{.position = positionEnd, .texCoords = textureEnd});
+        }
+    }
+}
+
+size_t Engine::TilemapObject::getAllocatedSize() const
+{
+    size_t size = GameObject::getAllocatedSize() - sizeof(GameObject) + sizeof(TilemapObject) + m_tiles.capacity() * sizeof(TileId) + m_solidTiles.capacity();
+    for (Chunk const &chunk : m_chunks)
+    {
+        size += sizeof(Chunk) + chunk.vertices.getVertexCount() * sizeof(sf::Vertex);
+    }
+    return size;
+}
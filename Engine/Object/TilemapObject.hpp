@@ -0,0 +1,99 @@
+#pragma once
+#include "GameObject.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+namespace Engine
+{
+    /// @brief Index of a tile in the tileset, starting from 1. Zero means that there is no tile
+    using TileId = uint16_t;
+
+    /// @brief Grid of tiles drawn from a single tileset texture. Whole level is a single object, so large maps don't fill the scene with objects.
+    /// Tiles are drawn in square chunks, vertices of each chunk are cached and only built again once a tile in the chunk changes
+    class TilemapObject : public GameObject
+    {
+    public:
+        /// @brief Create tilemap with no tiles
+        /// @param tilesetName Name of the sprite asset used as tileset. Default frame of the asset is the first tile, other tiles follow it row by row
+        /// @param mapSize Amount of tiles along each axis
+        /// @param tileSize Size of a single tile in the world
+        explicit TilemapObject(ObjectType const *type, std::string const &name, Scene &scene, std::string const &tilesetName, sf::Vector2i mapSize, sf::Vector2f tileSize);
+
+        void draw(sf::RenderWindow &window) override;
+
+        sf::Vector2i getMapSize() const { return m_mapSize; }
+
+        /// @brief Get size of a single tile in the world, which changes if the object is resized
+        sf::Vector2f getTileSize() const;
+
+        bool isInside(sf::Vector2i cell) const { return cell.x >= 0 && cell.y >= 0 && cell.x < m_mapSize.x && cell.y < m_mapSize.y; }
+
+        /// @brief Get tile in the cell, cells outside of the map are empty
+        TileId getTile(sf::Vector2i cell) const;
+
+        /// @brief Change tile in the cell, cells outside of the map are ignored
+        void setTile(sf::Vector2i cell, TileId tile);
+
+        /// @brief Replace every tile of the map
+        /// @param tiles Tiles stored row by row, missing tiles are left empty
+        void setTiles(std::vector<TileId> const &tiles);
+
+        /// @brief Get cell that contains the world position, cell may be outside of the map
+        sf::Vector2i getCell(sf::Vector2f position) const;
+
+        /// @brief Set if objects collide with the tile. Every non empty tile is solid by default
+        void setTileSolid(TileId tile, bool solid);
+
+        bool isTileSolid(TileId tile) const;
+
+        bool isCellSolid(sf::Vector2i cell) const { return isTileSolid(getTile(cell)); }
+
+        /// @brief Check if any solid tile overlaps the area. Tiles that only touch the edge of the area are not counted
+        bool isAreaSolid(sf::FloatRect const &area) const;
+
+        /// @brief Find how far the box can move before hitting a solid tile. Box is moved horizontally first and vertically after that,
+        /// so that sliding along walls and floors works. Tiles the box already overlaps don't block it, which lets stuck objects get out
+        /// @param box Area occupied by the moving object
+        /// @param motion Desired movement
+        /// @return Movement that can be done without entering solid tiles
+        sf::Vector2f sweep(sf::FloatRect const &box, sf::Vector2f motion) const;
+
+        size_t getAllocatedSize() const override;
+
+        /// @brief Width and height of a single chunk in tiles
+        static constexpr int32_t ChunkSize = 16;
+
+    private:
+        struct Chunk
+        {
+            sf::VertexArray vertices;
+            bool dirty = true;
+        };
+
+        /// @brief Move box along a single axis until it hits a solid tile
+        /// @return Distance that can be moved
+        float sweepAxis(sf::FloatRect const &box, float motion, bool horizontal) const;
+
+        /// @brief Get range of cells along one axis that overlap the span, clamped to the map
+        std::pair<int32_t, int32_t> getCellSpan(float start, float end, bool horizontal) const;
+
+        /// @brief Check if any tile of a row or column is solid within the given range of cells across it
+        bool isLineSolid(int32_t line, int32_t from, int32_t to, bool horizontal) const;
+
+        size_t getChunkIndex(sf::Vector2i cell) const { return (size_t)(cell.y / ChunkSize) * m_chunkCount.x + (size_t)(cell.x / ChunkSize); }
+
+        void buildChunk(size_t index);
+
+        SpriteFramesAsset const *m_tileset;
+        sf::Texture const *m_texture;
+        sf::Vector2i m_mapSize;
+        /// @brief Size of the tile the map was created with, vertices are built for it and scaled when object is resized
+        sf::Vector2f m_baseTileSize;
+        std::vector<TileId> m_tiles;
+        sf::Vector2i m_chunkCount;
+        std::vector<Chunk> m_chunks;
+        /// @brief Solidity of tiles by id, ids past the end use the default
+        std::vector<uint8_t> m_solidTiles;
+        bool m_solidByDefault = true;
+    };
+}
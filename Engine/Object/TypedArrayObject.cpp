@@ -0,0 +1,367 @@
+#include "TypedArrayObject.hpp"
+#include "../Error.hpp"
+#include "../System/Simd.hpp"
+#include <algorithm>
+
+// vector arrays are processed as flat arrays of floats
+static_assert(sizeof(Engine::VectorType) == sizeof(float) * 2);
+
+static float *asFloats(std::vector<Engine::VectorType> &vectors)
+{
+    return reinterpret_cast<float *>(vectors.data());
+}
+
+static float const *asFloats(std::vector<Engine::VectorType> const &vectors)
+{
+    return reinterpret_cast<float const *>(vectors.data());
+}
+
+Engine::TypedArrayObject::TypedArrayObject(ElementType type, size_t size) : m_type(type)
+{
+    switch (m_type)
+    {
+    case ElementType::Int:
+        m_ints.resize(size, 0);
+        break;
+    case ElementType::Float:
+        m_floats.resize(size, 0.0);
+        break;
+    case ElementType::Vector:
+        m_vectors.resize(size, VectorType(0.f, 0.f));
+        break;
+    }
+}
+
+std::string Engine::TypedArrayObject::toString(Scene const &scene) const
+{
+    std::vector<Value> values = toValues();
+    std::string result = "[";
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        result += valueToString(values[i], scene);
+        if (i != values.size() - 1)
+        {
+            result += ',';
+        }
+    }
+    return result + "]";
+}
+
+size_t Engine::TypedArrayObject::getAllocatedSize() const
+{
+    return sizeof(TypedArrayObject) + m_ints.capacity() * sizeof(IntType) + m_floats.capacity() * sizeof(FloatType) + m_vectors.capacity() * sizeof(VectorType);
+}
+
+size_t Engine::TypedArrayObject::getLength() const
+{
+    switch (m_type)
+    {
+    case ElementType::Int:
+        return m_ints.size();
+    case ElementType::Float:
+        return m_floats.size();
+    case ElementType::Vector:
+        return m_vectors.size();
+    }
+    return 0;
+}
+
+Engine::Value Engine::TypedArrayObject::getItem(size_t id) const
+{
+    if (id >= getLength())
+    {
+        throw Errors::RuntimeMemoryError(std::string("Attempted to get item at position " + std::to_string(id) + " in array of size " + std::to_string(getLength())));
+    }
+    switch (m_type)
+    {
+    case ElementType::Int:
+        return m_ints[id];
+    case ElementType::Float:
+        return m_floats[id];
+    case ElementType::Vector:
+        return m_vectors[id];
+    }
+    return NilValue;
+}
+
+void Engine::TypedArrayObject::setItem(size_t id, Value const &v)
+{
+    if (id >= getLength())
+    {
+        throw Errors::RuntimeMemoryError(std::string("Attempted to set item at position " + std::to_string(id) + " in array of size " + std::to_string(getLength())));
+    }
+    switch (m_type)
+    {
+    case ElementType::Int:
+        m_ints[id] = toInt(v);
+        break;
+    case ElementType::Float:
+        m_floats[id] = toFloat(v);
+        break;
+    case ElementType::Vector:
+        m_vectors[id] = toVector(v);
+        break;
+    }
+}
+
+void Engine::TypedArrayObject::fill(Value const &v)
+{
+    switch (m_type)
+    {
+    case ElementType::Int:
+        std::fill(m_ints.begin(), m_ints.end(), toInt(v));
+        break;
+    case ElementType::Float:
+        std::fill(m_floats.begin(), m_floats.end(), toFloat(v));
+        break;
+    case ElementType::Vector:
+        std::fill(m_vectors.begin(), m_vectors.end(), toVector(v));
+        break;
+    }
+}
+
+void Engine::TypedArrayObject::add(Value const &v)
+{
+    switch (m_type)
+    {
+    case ElementType::Int:
+        Simd::addScalar(m_ints.data(), m_ints.size(), toInt(v));
+        break;
+    case ElementType::Float:
+        Simd::addScalar(m_floats.data(), m_floats.size(), toFloat(v));
+        break;
+    case ElementType::Vector:
+    {
+        VectorType vec = toVector(v);
+        Simd::addPairs(asFloats(m_vectors), m_vectors.size() * 2, vec.x, vec.y);
+    }
+    break;
+    }
+}
+
+void Engine::TypedArrayObject::scale(Value const &v)
+{
+    switch (m_type)
+    {
+    case ElementType::Int:
+    {
+        IntType factor = toInt(v);
+        for (IntType &item : m_ints)
+        {
+            item *= factor;
+        }
+    }
+    break;
+    case ElementType::Float:
+        Simd::mulScalar(m_floats.data(), m_floats.size(), toFloat(v));
+        break;
+    case ElementType::Vector:
+    {
+        VectorType factor = v.index() == ValueType::Vector ? std::get<VectorType>(v) : VectorType((float)toFloat(v), (float)toFloat(v));
+        Simd::mulPairs(asFloats(m_vectors), m_vectors.size() * 2, factor.x, factor.y);
+    }
+    break;
+    }
+}
+
+void Engine::TypedArrayObject::addArray(TypedArrayObject const &other)
+{
+    checkCompatible(other);
+    switch (m_type)
+    {
+    case ElementType::Int:
+        Simd::add(m_ints.data(), other.m_ints.data(), m_ints.size());
+        break;
+    case ElementType::Float:
+        Simd::add(m_floats.data(), other.m_floats.data(), m_floats.size());
+        break;
+    case ElementType::Vector:
+        Simd::add(asFloats(m_vectors), asFloats(other.m_vectors), m_vectors.size() * 2);
+        break;
+    }
+}
+
+void Engine::TypedArrayObject::mulArray(TypedArrayObject const &other)
+{
+    checkCompatible(other);
+    switch (m_type)
+    {
+    case ElementType::Int:
+        for (size_t i = 0; i < m_ints.size(); i++)
+        {
+            m_ints[i] *= other.m_ints[i];
+        }
+        break;
+    case ElementType::Float:
+        Simd::mul(m_floats.data(), other.m_floats.data(), m_floats.size());
+        break;
+    case ElementType::Vector:
+        Simd::mul(asFloats(m_vectors), asFloats(other.m_vectors), m_vectors.size() * 2);
+        break;
+    }
+}
+
+Engine::Value Engine::TypedArrayObject::sum() const
+{
+    switch (m_type)
+    {
+    case ElementType::Int:
+        return Simd::sum(m_ints.data(), m_ints.size());
+    case ElementType::Float:
+        return Simd::sum(m_floats.data(), m_floats.size());
+    case ElementType::Vector:
+    {
+        VectorType result;
+        Simd::sumPairs(asFloats(m_vectors), m_vectors.size() * 2, result.x, result.y);
+        return result;
+    }
+    }
+    return NilValue;
+}
+
+Engine::Value Engine::TypedArrayObject::min() const
+{
+    if (getLength() == 0)
+    {
+        throw Errors::RuntimeMemoryError("Attempted to get smallest item of an empty array");
+    }
+    switch (m_type)
+    {
+    case ElementType::Int:
+        return *std::min_element(m_ints.begin(), m_ints.end());
+    case ElementType::Float:
+        return Simd::min(m_floats.data(), m_floats.size());
+    case ElementType::Vector:
+    {
+        VectorType result;
+        Simd::minPairs(asFloats(m_vectors), m_vectors.size() * 2, result.x, result.y);
+        return result;
+    }
+    }
+    return NilValue;
+}
+
+Engine::Value Engine::TypedArrayObject::max() const
+{
+    if (getLength() == 0)
+    {
+        throw Errors::RuntimeMemoryError("Attempted to get largest item of an empty array");
+    }
+    switch (m_type)
+    {
+    case ElementType::Int:
+        return *std::max_element(m_ints.begin(), m_ints.end());
+    case ElementType::Float:
+        return Simd::max(m_floats.data(), m_floats.size());
+    case ElementType::Vector:
+    {
+        VectorType result;
+        Simd::maxPairs(asFloats(m_vectors), m_vectors.size() * 2, result.x, result.y);
+        return result;
+    }
+    }
+    return NilValue;
+}
+
+Engine::Value Engine::TypedArrayObject::dot(TypedArrayObject const &other) const
+{
+    checkCompatible(other);
+    switch (m_type)
+    {
+    case ElementType::Int:
+    {
+        IntType result = 0;
+        for (size_t i = 0; i < m_ints.size(); i++)
+        {
+            result += m_ints[i] * other.m_ints[i];
+        }
+        return result;
+    }
+    case ElementType::Float:
+        return Simd::dot(m_floats.data(), other.m_floats.data(), m_floats.size());
+    case ElementType::Vector:
+        return (FloatType)Simd::dot(asFloats(m_vectors), asFloats(other.m_vectors), m_vectors.size() * 2);
+    }
+    return NilValue;
+}
+
+void Engine::TypedArrayObject::clamp(Value const &low, Value const &high)
+{
+    switch (m_type)
+    {
+    case ElementType::Int:
+    {
+        IntType lowInt = toInt(low);
+        IntType highInt = toInt(high);
+        for (IntType &item : m_ints)
+        {
+            item = std::min(std::max(item, lowInt), highInt);
+        }
+    }
+    break;
+    case ElementType::Float:
+        Simd::clamp(m_floats.data(), m_floats.size(), toFloat(low), toFloat(high));
+        break;
+    case ElementType::Vector:
+    {
+        VectorType lowVec = toVector(low);
+        VectorType highVec = toVector(high);
+        Simd::clampPairs(asFloats(m_vectors), m_vectors.size() * 2, lowVec.x, lowVec.y, highVec.x, highVec.y);
+    }
+    break;
+    }
+}
+
+std::vector<Engine::Value> Engine::TypedArrayObject::toValues() const
+{
+    std::vector<Value> values;
+    values.reserve(getLength());
+    for (size_t i = 0; i < getLength(); i++)
+    {
+        values.push_back(getItem(i));
+    }
+    return values;
+}
+
+void Engine::TypedArrayObject::checkCompatible(TypedArrayObject const &other) const
+{
+    if (other.m_type != m_type)
+    {
+        throw Errors::RuntimeMemoryError("Attempted to combine typed arrays with different element types");
+    }
+    if (other.getLength() != getLength())
+    {
+        throw Errors::RuntimeMemoryError("Attempted to combine typed arrays of size " + std::to_string(getLength()) + " and " + std::to_string(other.getLength()));
+    }
+}
+
+Engine::IntType Engine::TypedArrayObject::toInt(Value const &v) const
+{
+    if (v.index() != ValueType::Integer)
+    {
+        throw Errors::RuntimeMemoryError(std::string("Expected Int value for int array, got ") + typeToString((ValueType)v.index()));
+    }
+    return std::get<IntType>(v);
+}
+
+Engine::FloatType Engine::TypedArrayObject::toFloat(Value const &v) const
+{
+    if (v.index() == ValueType::Integer)
+    {
+        return (FloatType)std::get<IntType>(v);
+    }
+    if (v.index() != ValueType::Float)
+    {
+        throw Errors::RuntimeMemoryError(std::string("Expected Float value for float array, got ") + typeToString((ValueType)v.index()));
+    }
+    return std::get<FloatType>(v);
+}
+
+Engine::VectorType Engine::TypedArrayObject::toVector(Value const &v) const
+{
+    if (v.index() != ValueType::Vector)
+    {
+        throw Errors::RuntimeMemoryError(std::string("Expected Vector value for vector array, got ") + typeToString((ValueType)v.index()));
+    }
+    return std::get<VectorType>(v);
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+#include "MemoryObject.hpp"
+#include "../Execution/Value.hpp"
+
+namespace Engine
+{
+    /// @brief Array where every element has the same numeric type. Elements are stored as native values next to each other
+    /// which makes them cheaper to store than regular arrays and allows bulk operations to use SIMD instructions
+    class TypedArrayObject : public MemoryObject
+    {
+    public:
+        enum class ElementType
+        {
+            Int,
+            Float,
+            Vector
+        };
+
+        /// @brief Create array of given size filled with zeros
+        /// @param type Type of every element
+        /// @param size Amount of elements
+        explicit TypedArrayObject(ElementType type, size_t size);
+
+        std::string toString(Scene const &scene) const override;
+
+        size_t getAllocatedSize() const override;
+
+        MemoryObjectKind getKind() const override { return MemoryObjectKind::TypedArray; }
+
+        ElementType getElementType() const { return m_type; }
+
+        size_t getLength() const;
+
+        /// @brief Try to get item at given id and throw error if id is out of bounds
+        /// @param id Index of the item
+        /// @return Item at the given position
+        Value getItem(size_t id) const;
+
+        /// @brief Try to set item at given id and throw error if id is out of bounds or value can not be converted to element type
+        /// @param id Index of the item
+        /// @param v New value
+        void setItem(size_t id, Value const &v);
+
+        /// @brief Set every element to the given value
+        void fill(Value const &v);
+
+        /// @brief Add value to every element. Vector arrays accept vectors, other arrays accept numbers
+        void add(Value const &v);
+
+        /// @brief Multiply every element by the value. Vector arrays accept both numbers and vectors(multiplied component wise)
+        void scale(Value const &v);
+
+        /// @brief Add elements of other array to elements of this one at the same positions. Arrays must have same type and length
+        void addArray(TypedArrayObject const &other);
+
+        /// @brief Multiply elements of this array by elements of other array at the same positions. Arrays must have same type and length
+        void mulArray(TypedArrayObject const &other);
+
+        /// @brief Get sum of all elements
+        Value sum() const;
+
+        /// @brief Get smallest element, vector arrays find smallest value for each component separately. Array must not be empty
+        Value min() const;
+
+        /// @brief Get largest element, vector arrays find largest value for each component separately. Array must not be empty
+        Value max() const;
+
+        /// @brief Get sum of products of the elements at the same positions, for vector arrays sum of dot products of elements is returned
+        Value dot(TypedArrayObject const &other) const;
+
+        /// @brief Limit every element to the given range, vector arrays limit each component separately
+        void clamp(Value const &low, Value const &high);
+
+        /// @brief Get all elements converted into regular values
+        std::vector<Value> toValues() const;
+
+    private:
+        /// @brief Throw error if other array can not be used in element wise operation with this one
+        void checkCompatible(TypedArrayObject const &other) const;
+
+        IntType toInt(Value const &v) const;
+
+        FloatType toFloat(Value const &v) const;
+
+        VectorType toVector(Value const &v) const;
+
+        ElementType m_type;
+        // only the storage that matches the element type is used
+        std::vector<IntType> m_ints;
+        std::vector<FloatType> m_floats;
+        std::vector<VectorType> m_vectors;
+    };
+}
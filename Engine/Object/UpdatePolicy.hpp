@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <optional>
+
+namespace Engine
+{
+    /// @brief Rule that decides on which frames the object is updated
+    enum class UpdateMode
+    {
+        /// @brief Update every frame
+        Always,
+        /// @brief Update once every N frames, passing time accumulated since the last update
+        Interval,
+        /// @brief Update only while the object is inside the update region of the scene
+        InRegion
+    };
+
+    /// @brief Settings controlling how often object runs its update logic. Lets scenes with many objects spend time only on the ones that matter right now
+    struct UpdatePolicy
+    {
+        UpdateMode mode = UpdateMode::Always;
+        /// @brief Amount of frames between updates when using interval mode
+        uint32_t interval = 1;
+        /// @brief Extra distance around the update region in which objects are still updated when using region mode
+        float margin = 0.f;
+        /// @brief Should new objects start asleep, sleeping objects are not updated until woken by an event or a script
+        bool startAsleep = false;
+    };
+
+    /// @brief Get update mode with the given name as used in scene files and scripts
+    /// @param name Name of the mode
+    /// @return Mode or nothing if name is unknown
+    inline std::optional<UpdateMode> getUpdateModeByName(std::string const &name)
+    {
+        if (name == "always")
+        {
+            return UpdateMode::Always;
+        }
+        if (name == "interval")
+        {
+            return UpdateMode::Interval;
+        }
+        if (name == "region")
+        {
+            return UpdateMode::InRegion;
+        }
+        return {};
+    }
+}
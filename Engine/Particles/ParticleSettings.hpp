@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <SFML/Graphics.hpp>
+
+namespace Engine
+{
+    /// @brief Description of how particles of an effect are spawned, move and look. Random values are picked uniformly from their range for every particle
+    struct ParticleSettings
+    {
+        /// @brief Name of the sprite asset used to draw particles, particles are plain squares if empty
+        std::string sprite;
+        /// @brief Animation of the sprite played once over the lifetime of every particle, default frame of the sprite is used if empty
+        std::string animation;
+        /// @brief Particles past this amount are not spawned, storage for all of them is allocated once
+        size_t maxParticles = 1000;
+        /// @brief Particles spawned per second while emitter is emitting
+        float rate = 50.f;
+        float minLifetime = 1.f;
+        float maxLifetime = 1.f;
+        float minSpeed = 50.f;
+        float maxSpeed = 50.f;
+        /// @brief Direction of the movement in degrees, 0 points right and 90 points down
+        float direction = 0.f;
+        /// @brief Width of the cone around the direction in which particles move, in degrees
+        float spread = 360.f;
+        sf::Vector2f gravity;
+        /// @brief Fraction of velocity lost per second
+        float drag = 0.f;
+        float startSize = 4.f;
+        float endSize = 4.f;
+        sf::Color startColor = sf::Color::White;
+        sf::Color endColor = sf::Color::White;
+    };
+}
@@ -0,0 +1,129 @@
+#include "ParticleSystem.hpp"
+#include "../System/Simd.hpp"
+#include "../System/Random.hpp"
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+
+Engine::ParticleSystem::ParticleSystem(ParticleSettings const &settings)
+    : m_settings(settings),
+      m_positionX(settings.maxParticles),
+      m_positionY(settings.maxParticles),
+      m_velocityX(settings.maxParticles),
+      m_velocityY(settings.maxParticles),
+      m_age(settings.maxParticles),
+      m_lifetime(settings.maxParticles)
+{
+    // size and color only depend on how far particle is into its life, so they are calculated once for evenly spaced points
+    for (size_t i = 0; i < RampSize; i++)
+    {
+        float progress = (float)i / (float)(RampSize - 1);
+        m_sizeRamp[i] = (settings.startSize + (settings.endSize - settings.startSize) * progress) / 2.f;
+        m_colorRamp[i] = sf::Color((uint8_t)std::lround((float)settings.startColor.r + (float)(settings.endColor.r - settings.startColor.r) * progress),
+                                   (uint8_t)std::lround((float)settings.startColor.g + (float)(settings.endColor.g - settings.startColor.g) * progress),
+                                   (uint8_t)std::lround((float)settings.startColor.b + (float)(settings.endColor.b - settings.startColor.b) * progress),
+                                   (uint8_t)std::lround((float)settings.startColor.a + (float)(settings.endColor.a - settings.startColor.a) * progress));
+    }
+}
+
+void Engine::ParticleSystem::setEmitting(bool emitting)
+{
+    m_emitting = emitting;
+    m_pendingSpawn = 0.f;
+}
+
+void Engine::ParticleSystem::burst(size_t count, sf::FloatRect const &area)
+{
+    spawn(count, area);
+}
+
+void Engine::ParticleSystem::update(float delta, sf::FloatRect const &area)
+{
+    float damping = std::max(0.f, 1.f - m_settings.drag * delta);
+    Simd::integrateMotion(m_positionX.data(), m_positionY.data(), m_velocityX.data(), m_velocityY.data(), m_count,
+                          delta, m_settings.gravity.x, m_settings.gravity.y, damping);
+    Simd::addScalar(m_age.data(), m_count, delta);
+    removeExpired();
+    if (m_emitting)
+    {
+        m_pendingSpawn += m_settings.rate * delta;
+        size_t count = (size_t)m_pendingSpawn;
+        m_pendingSpawn -= (float)count;
+        spawn(count, area);
+    }
+}
+
+void Engine::ParticleSystem::spawn(size_t count, sf::FloatRect const &area)
+{
+    Random &random = Random::getInstance();
+    count = std::min(count, m_settings.maxParticles - m_count);
+    float halfSpread = m_settings.spread / 2.f;
+    for (size_t i = m_count; i < m_count + count; i++)
+    {
+        float angle = (m_settings.direction + random.getRandomFloatInRange(-halfSpread, halfSpread)) * std::numbers::pi_v<float> / 180.f;
+        float speed = m_settings.minSpeed < m_settings.maxSpeed ? random.getRandomFloatInRange(m_settings.minSpeed, m_settings.maxSpeed) : m_settings.minSpeed;
+        m_positionX[i] = area.position.x + (area.size.x > 0.f ? random.getRandomFloatInRange(0.f, area.size.x) : 0.f);
+        m_positionY[i] = area.position.y + (area.size.y > 0.f ? random.getRandomFloatInRange(0.f, area.size.y) : 0.f);
+        m_velocityX[i] = std::cos(angle) * speed;
+        m_velocityY[i] = std::sin(angle) * speed;
+        m_age[i] = 0.f;
+        m_lifetime[i] = m_settings.minLifetime < m_settings.maxLifetime ? random.getRandomFloatInRange(m_settings.minLifetime, m_settings.maxLifetime) : m_settings.minLifetime;
+    }
+    m_count += count;
+}
+
+void Engine::ParticleSystem::removeExpired()
+{
+    // last particle takes the place of the expired one, order of particles does not matter
+    size_t i = 0;
+    while (i < m_count)
+    {
+        if (m_age[i] < m_lifetime[i])
+        {
+            i++;
+            continue;
+        }
+        m_count--;
+        m_positionX[i] = m_positionX[m_count];
+        m_positionY[i] = m_positionY[m_count];
+        m_velocityX[i] = m_velocityX[m_count];
+        m_velocityY[i] = m_velocityY[m_count];
+        m_age[i] = m_age[m_count];
+        m_lifetime[i] = m_lifetime[m_count];
+    }
+}
+
+void Engine::ParticleSystem::buildVertices(sf::VertexArray &vertices, std::vector<sf::IntRect> const &frames) const
+{
+    vertices.setPrimitiveType(sf::PrimitiveType::Triangles);
+    vertices.resize(m_count * 6);
+    for (size_t i = 0; i < m_count; i++)
+    {
+        float progress = m_lifetime[i] > 0.f ? std::min(m_age[i] / m_lifetime[i], 1.f) : 1.f;
+        size_t step = (size_t)(progress * (float)(RampSize - 1));
+        float halfSize = m_sizeRamp[step];
+        sf::Color color = m_colorRamp[step];
+        sf::Vector2f start(m_positionX[i] - halfSize, m_positionY[i] - halfSize);
+        sf::Vector2f end(m_positionX[i] + halfSize, m_positionY[i] + halfSize);
+        sf::Vector2f textureStart;
+        sf::Vector2f textureEnd;
+        if (!frames.empty())
+        {
+            sf::IntRect const &frame = frames[std::min((size_t)(progress * (float)frames.size()), frames.size() - 1)];
+            textureStart = sf::Vector2f((float)frame.position.x, (float)frame.position.y);
+            textureEnd = textureStart + sf::Vector2f((float)frame.size.x, (float)frame.size.y);
+        }
+        sf::Vertex *quad = &vertices[i * 6];
+        quad[0] = sf::Vertex{.position = start, .color = color, .texCoords = textureStart};
+        quad[1] = sf::Vertex{.position = sf::Vector2f(end.x, start.y), .color = color, .texCoords = sf::Vector2f(textureEnd.x, textureStart.y)};
+        quad[2] = sf::Vertex{.position = sf::Vector2f(start.x, end.y), .color = color, .texCoords = sf::Vector2f(textureStart.x, textureEnd.y)};
+        quad[3] = quad[2];
+        quad[4] = quad[1];
+        quad[5] = sf::Vertex{.position = end, .color = color, .texCoords = textureEnd};
+    }
+}
+
+size_t Engine::ParticleSystem::getAllocatedSize() const
+{
+    return (m_positionX.capacity() + m_positionY.capacity() + m_velocityX.capacity() + m_velocityY.capacity() + m_age.capacity() + m_lifetime.capacity()) * sizeof(float);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+#include "ParticleSettings.hpp"
+
+namespace Engine
+{
+    /// @brief Simulation of many short lived particles that don't need to be separate objects.
+    /// Each particle property is stored in its own array so that the whole set can be moved with vector instructions,
+    /// size, color and animation frame are looked up by the age of the particle when vertices are built
+    class ParticleSystem
+    {
+    public:
+        explicit ParticleSystem(ParticleSettings const &settings);
+
+        ParticleSettings const &getSettings() const { return m_settings; }
+
+        /// @brief Start or stop spawning particles every update. Particles that are already alive are not affected
+        void setEmitting(bool emitting);
+
+        bool isEmitting() const { return m_emitting; }
+
+        /// @brief Spawn particles at once, particles that don't fit are dropped
+        /// @param area Area in which particles are placed
+        void burst(size_t count, sf::FloatRect const &area);
+
+        /// @brief Move particles, remove the ones that lived out their lifetime and spawn new ones if emitting
+        /// @param area Area in which new particles are placed
+        void update(float delta, sf::FloatRect const &area);
+
+        /// @brief Remove every particle
+        void clear() { m_count = 0; }
+
+        size_t getCount() const { return m_count; }
+
+        /// @brief Write two triangles for every particle into the array
+        /// @param frames Texture rects of the animation played over the particle lifetime, if empty particles are not textured
+        void buildVertices(sf::VertexArray &vertices, std::vector<sf::IntRect> const &frames) const;
+
+        /// @brief Get amount of memory used by particle storage
+        size_t getAllocatedSize() const;
+
+    private:
+        /// @brief Amount of precalculated steps of size and color over the particle lifetime
+        static constexpr size_t RampSize = 256;
+
+        void spawn(size_t count, sf::FloatRect const &area);
+
+        /// @brief Remove particles whose age reached their lifetime
+        void removeExpired();
+
+        ParticleSettings m_settings;
+        /// @brief Half of the particle size at evenly spaced points of its lifetime
+        std::array<float, RampSize> m_sizeRamp;
+        std::array<sf::Color, RampSize> m_colorRamp;
+        std::vector<float> m_positionX;
+        std::vector<float> m_positionY;
+        std::vector<float> m_velocityX;
+        std::vector<float> m_velocityY;
+        std::vector<float> m_age;
+        std::vector<float> m_lifetime;
+        /// @brief Amount of alive particles, they always occupy the beginning of the arrays
+        size_t m_count = 0;
+        bool m_emitting = false;
+        /// @brief Part of a particle that was due to spawn but did not fit into previous updates
+        float m_pendingSpawn = 0.f;
+    };
+}
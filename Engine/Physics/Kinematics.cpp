@@ -0,0 +1,115 @@
+#include "Kinematics.hpp"
+#include <algorithm>
+
+size_t Engine::Kinematics::getOrAdd(uint32_t id)
+{
+    if (id >= m_denseIndices.size())
+    {
+        m_denseIndices.resize(id + 1, NoIndex);
+    }
+    if (m_denseIndices[id] == NoIndex)
+    {
+        m_denseIndices[id] = (uint32_t)m_ids.size();
+        m_ids.push_back(id);
+        m_positionX.push_back(0.f);
+        m_positionY.push_back(0.f);
+        m_velocityX.push_back(0.f);
+        m_velocityY.push_back(0.f);
+        m_accelerationX.push_back(0.f);
+        m_accelerationY.push_back(0.f);
+        m_drag.push_back(0.f);
+        m_moved.push_back(0);
+    }
+    return m_denseIndices[id];
+}
+
+void Engine::Kinematics::setVelocity(uint32_t id, sf::Vector2f velocity)
+{
+    size_t index = getOrAdd(id);
+    m_velocityX[index] = velocity.x;
+    m_velocityY[index] = velocity.y;
+}
+
+sf::Vector2f Engine::Kinematics::getVelocity(uint32_t id) const
+{
+    return contains(id) ? sf::Vector2f(m_velocityX[m_denseIndices[id]], m_velocityY[m_denseIndices[id]]) : sf::Vector2f();
+}
+
+void Engine::Kinematics::setAcceleration(uint32_t id, sf::Vector2f acceleration)
+{
+    size_t index = getOrAdd(id);
+    m_accelerationX[index] = acceleration.x;
+    m_accelerationY[index] = acceleration.y;
+}
+
+sf::Vector2f Engine::Kinematics::getAcceleration(uint32_t id) const
+{
+    return contains(id) ? sf::Vector2f(m_accelerationX[m_denseIndices[id]], m_accelerationY[m_denseIndices[id]]) : sf::Vector2f();
+}
+
+void Engine::Kinematics::setDrag(uint32_t id, float drag)
+{
+    m_drag[getOrAdd(id)] = std::max(drag, 0.f);
+}
+
+float Engine::Kinematics::getDrag(uint32_t id) const
+{
+    return contains(id) ? m_drag[m_denseIndices[id]] : 0.f;
+}
+
+void Engine::Kinematics::remove(uint32_t id)
+{
+    if (!contains(id))
+    {
+        return;
+    }
+    // last object takes the place of the removed one so that arrays stay without gaps
+    size_t index = m_denseIndices[id];
+    size_t last = m_ids.size() - 1;
+    m_ids[index] = m_ids[last];
+    m_positionX[index] = m_positionX[last];
+    m_positionY[index] = m_positionY[last];
+    m_velocityX[index] = m_velocityX[last];
+    m_velocityY[index] = m_velocityY[last];
+    m_accelerationX[index] = m_accelerationX[last];
+    m_accelerationY[index] = m_accelerationY[last];
+    m_drag[index] = m_drag[last];
+    m_moved[index] = m_moved[last];
+    m_denseIndices[m_ids[index]] = (uint32_t)index;
+    m_denseIndices[id] = NoIndex;
+
+    m_ids.pop_back();
+    m_positionX.pop_back();
+    m_positionY.pop_back();
+    m_velocityX.pop_back();
+    m_velocityY.pop_back();
+    m_accelerationX.pop_back();
+    m_accelerationY.pop_back();
+    m_drag.pop_back();
+    m_moved.pop_back();
+}
+
+/// @brief Advance every body by one step. Components are passed as restrict parameters since every one of them is a separate vector,
+/// which lets the compiler vectorize the loop without checking whether writes to one array change another
+static void integrateBodies(float *__restrict positionX, float *__restrict positionY, float *__restrict velocityX, float *__restrict velocityY,
+                            float const *__restrict accelerationX, float const *__restrict accelerationY, float const *__restrict drag,
+                            uint8_t *__restrict moved, size_t count, float delta)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        float damping = std::max(0.f, 1.f - drag[i] * delta);
+        float vx = (velocityX[i] + accelerationX[i] * delta) * damping;
+        float vy = (velocityY[i] + accelerationY[i] * delta) * damping;
+        velocityX[i] = vx;
+        velocityY[i] = vy;
+        positionX[i] += vx * delta;
+        positionY[i] += vy * delta;
+        moved[i] = (vx != 0.f) | (vy != 0.f);
+    }
+}
+
+void Engine::Kinematics::integrate(float delta)
+{
+    integrateBodies(m_positionX.data(), m_positionY.data(), m_velocityX.data(), m_velocityY.data(),
+                    m_accelerationX.data(), m_accelerationY.data(), m_drag.data(), m_moved.data(), m_ids.size(), delta);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <SFML/System.hpp>
+
+namespace Engine
+{
+    /// @brief Velocity, acceleration and drag of moving objects, integrated natively every frame so that objects that only move don't need scripts.
+    /// State is stored as separate arrays for each component and only for objects that actually have any movement state,
+    /// which keeps the integration loop short and lets the compiler vectorize it
+    class Kinematics
+    {
+    public:
+        explicit Kinematics() = default;
+
+        void setVelocity(uint32_t id, sf::Vector2f velocity);
+
+        sf::Vector2f getVelocity(uint32_t id) const;
+
+        void setAcceleration(uint32_t id, sf::Vector2f acceleration);
+
+        sf::Vector2f getAcceleration(uint32_t id) const;
+
+        /// @brief Set how quickly object loses its velocity
+        /// @param drag Fraction of velocity lost per second, 0 means no drag
+        void setDrag(uint32_t id, float drag);
+
+        float getDrag(uint32_t id) const;
+
+        /// @brief Stop tracking movement state of the object
+        /// @param id Id of the object
+        void remove(uint32_t id);
+
+        bool contains(uint32_t id) const { return id < m_denseIndices.size() && m_denseIndices[id] != NoIndex; }
+
+        /// @brief Get ids of all objects with movement state in the order their positions are stored
+        std::span<uint32_t const> getIds() const { return m_ids; }
+
+        /// @brief Set position of the object that will be used as a starting point for the next integration step
+        /// @param index Index of the object in the list returned by getIds
+        void setPosition(size_t index, sf::Vector2f position)
+        {
+            m_positionX[index] = position.x;
+            m_positionY[index] = position.y;
+        }
+
+        /// @brief Get position of the object after the last integration step
+        /// @param index Index of the object in the list returned by getIds
+        sf::Vector2f getPosition(size_t index) const { return sf::Vector2f(m_positionX[index], m_positionY[index]); }
+
+        /// @brief Check if object moved during the last integration step
+        /// @param index Index of the object in the list returned by getIds
+        bool hasMoved(size_t index) const { return m_moved[index]; }
+
+        /// @brief Advance velocities and positions of all objects using semi-implicit Euler integration
+        /// @param delta Time passed since last step
+        void integrate(float delta);
+
+    private:
+        static constexpr uint32_t NoIndex = 0xffffffff;
+
+        /// @brief Get index of the object in the component arrays, adding object with empty state if it's not present
+        size_t getOrAdd(uint32_t id);
+
+        /// @brief Index of each object in the component arrays by object id
+        std::vector<uint32_t> m_denseIndices;
+        std::vector<uint32_t> m_ids;
+        std::vector<float> m_positionX;
+        std::vector<float> m_positionY;
+        std::vector<float> m_velocityX;
+        std::vector<float> m_velocityY;
+        std::vector<float> m_accelerationX;
+        std::vector<float> m_accelerationY;
+        std::vector<float> m_drag;
+        std::vector<uint8_t> m_moved;
+    };
+}
@@ -0,0 +1,262 @@
+#include "PhysicsShape.hpp"
+#include <cmath>
+#include <numbers>
+#include <limits>
+#include <algorithm>
+
+static float cross(sf::Vector2f a, sf::Vector2f b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+static float dot(sf::Vector2f a, sf::Vector2f b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+Engine::PhysicsShape Engine::PhysicsShape::createCircle(float radius)
+{
+    PhysicsShape shape(ShapeType::Circle);
+    shape.m_radius = std::max(radius, 0.f);
+    return shape;
+}
+
+Engine::PhysicsShape Engine::PhysicsShape::createBox(sf::Vector2f halfSize)
+{
+    PhysicsShape shape(ShapeType::Box);
+    float x = std::abs(halfSize.x);
+    float y = std::abs(halfSize.y);
+    shape.m_vertices = {{-x, -y}, {x, -y}, {x, y}, {-x, y}};
+    shape.computeNormals();
+    return shape;
+}
+
+std::optional<Engine::PhysicsShape> Engine::PhysicsShape::createPolygon(std::vector<sf::Vector2f> const &vertices)
+{
+    if (vertices.size() < 3)
+    {
+        return {};
+    }
+    PhysicsShape shape(ShapeType::Polygon);
+    shape.m_vertices = vertices;
+    float area = 0.f;
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        area += cross(vertices[i], vertices[(i + 1) % vertices.size()]);
+    }
+    if (area == 0.f)
+    {
+        return {};
+    }
+    // separation tests expect normals pointing outwards, which depends on the winding order
+    if (area < 0.f)
+    {
+        std::reverse(shape.m_vertices.begin(), shape.m_vertices.end());
+    }
+    size_t count = shape.m_vertices.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        sf::Vector2f edge = shape.m_vertices[(i + 1) % count] - shape.m_vertices[i];
+        sf::Vector2f next = shape.m_vertices[(i + 2) % count] - shape.m_vertices[(i + 1) % count];
+        if (cross(edge, next) < 0.f)
+        {
+            return {};
+        }
+    }
+    shape.computeNormals();
+    return shape;
+}
+
+void Engine::PhysicsShape::computeNormals()
+{
+    m_normals.resize(m_vertices.size());
+    for (size_t i = 0; i < m_vertices.size(); i++)
+    {
+        sf::Vector2f edge = m_vertices[(i + 1) % m_vertices.size()] - m_vertices[i];
+        float length = std::sqrt(dot(edge, edge));
+        m_normals[i] = length > 0.f ? sf::Vector2f(edge.y / length, -edge.x / length) : sf::Vector2f();
+    }
+}
+
+float Engine::PhysicsShape::getArea() const
+{
+    if (m_type == ShapeType::Circle)
+    {
+        return std::numbers::pi_v<float> * m_radius * m_radius;
+    }
+    float area = 0.f;
+    for (size_t i = 0; i < m_vertices.size(); i++)
+    {
+        area += cross(m_vertices[i], m_vertices[(i + 1) % m_vertices.size()]);
+    }
+    return area * 0.5f;
+}
+
+sf::FloatRect Engine::PhysicsShape::getBounds(sf::Vector2f position) const
+{
+    if (m_type == ShapeType::Circle)
+    {
+        return sf::FloatRect(position - sf::Vector2f(m_radius, m_radius), sf::Vector2f(m_radius * 2.f, m_radius * 2.f));
+    }
+    sf::Vector2f min = m_vertices.front();
+    sf::Vector2f max = m_vertices.front();
+    for (sf::Vector2f const &v : m_vertices)
+    {
+        min = sf::Vector2f(std::min(min.x, v.x), std::min(min.y, v.y));
+        max = sf::Vector2f(std::max(max.x, v.x), std::max(max.y, v.y));
+    }
+    return sf::FloatRect(position + min, max - min);
+}
+
+static std::optional<Engine::ContactManifold> collideCircles(Engine::PhysicsShape const &a, sf::Vector2f positionA, Engine::PhysicsShape const &b, sf::Vector2f positionB)
+{
+    sf::Vector2f offset = positionB - positionA;
+    float radius = a.getRadius() + b.getRadius();
+    float distanceSquared = dot(offset, offset);
+    if (distanceSquared >= radius * radius)
+    {
+        return {};
+    }
+    float distance = std::sqrt(distanceSquared);
+    // circles at the same spot are pushed apart along a fixed axis so that result does not depend on rounding
+    sf::Vector2f normal = distance > 0.f ? offset / distance : sf::Vector2f(0.f, -1.f);
+    return Engine::ContactManifold{.normal = normal, .penetration = radius - distance, .point = positionA + normal * a.getRadius()};
+}
+
+/// @brief Find the edge of the first polygon along which polygons are the furthest apart
+/// @return Index of the edge and the distance, negative distance means that polygons overlap along every edge
+static std::pair<size_t, float> findMaxSeparation(Engine::PhysicsShape const &a, sf::Vector2f positionA, Engine::PhysicsShape const &b, sf::Vector2f positionB)
+{
+    std::span<sf::Vector2f const> normals = a.getNormals();
+    std::span<sf::Vector2f const> verticesA = a.getVertices();
+    std::span<sf::Vector2f const> verticesB = b.getVertices();
+    sf::Vector2f offset = positionB - positionA;
+    size_t bestEdge = 0;
+    float bestSeparation = -std::numeric_limits<float>::max();
+    for (size_t i = 0; i < normals.size(); i++)
+    {
+        float separation = std::numeric_limits<float>::max();
+        for (sf::Vector2f const &v : verticesB)
+        {
+            separation = std::min(separation, dot(normals[i], v + offset - verticesA[i]));
+        }
+        if (separation > bestSeparation)
+        {
+            bestSeparation = separation;
+            bestEdge = i;
+        }
+    }
+    return {bestEdge, bestSeparation};
+}
+
+/// @brief Find vertex of the polygon that goes the deepest along the direction
+static sf::Vector2f findDeepestVertex(Engine::PhysicsShape const &shape, sf::Vector2f position, sf::Vector2f direction)
+{
+    std::span<sf::Vector2f const> vertices = shape.getVertices();
+    sf::Vector2f best = vertices.front();
+    for (sf::Vector2f const &v : vertices)
+    {
+        if (dot(v, direction) > dot(best, direction))
+        {
+            best = v;
+        }
+    }
+    return best + position;
+}
+
+static std::optional<Engine::ContactManifold> collidePolygons(Engine::PhysicsShape const &a, sf::Vector2f positionA, Engine::PhysicsShape const &b, sf::Vector2f positionB)
+{
+    auto [edgeA, separationA] = findMaxSeparation(a, positionA, b, positionB);
+    if (separationA >= 0.f)
+    {
+        return {};
+    }
+    auto [edgeB, separationB] = findMaxSeparation(b, positionB, a, positionA);
+    if (separationB >= 0.f)
+    {
+        return {};
+    }
+    // edge of the first polygon is preferred when both are almost equally good, which keeps the normal stable between steps
+    constexpr float tolerance = 0.001f;
+    if (separationB > separationA + tolerance)
+    {
+        sf::Vector2f normal = -b.getNormals()[edgeB];
+        return Engine::ContactManifold{.normal = normal, .penetration = -separationB, .point = findDeepestVertex(a, positionA, normal)};
+    }
+    sf::Vector2f normal = a.getNormals()[edgeA];
+    return Engine::ContactManifold{.normal = normal, .penetration = -separationA, .point = findDeepestVertex(b, positionB, -normal)};
+}
+
+/// @brief Collide polygon with a circle, normal points from the polygon to the circle
+static std::optional<Engine::ContactManifold> collidePolygonCircle(Engine::PhysicsShape const &polygon, sf::Vector2f positionA, Engine::PhysicsShape const &circle, sf::Vector2f positionB)
+{
+    std::span<sf::Vector2f const> vertices = polygon.getVertices();
+    std::span<sf::Vector2f const> normals = polygon.getNormals();
+    sf::Vector2f center = positionB - positionA;
+    float radius = circle.getRadius();
+    size_t bestEdge = 0;
+    float bestSeparation = -std::numeric_limits<float>::max();
+    for (size_t i = 0; i < normals.size(); i++)
+    {
+        float separation = dot(normals[i], center - vertices[i]);
+        if (separation > radius)
+        {
+            return {};
+        }
+        if (separation > bestSeparation)
+        {
+            bestSeparation = separation;
+            bestEdge = i;
+        }
+    }
+    sf::Vector2f v1 = vertices[bestEdge];
+    sf::Vector2f v2 = vertices[(bestEdge + 1) % vertices.size()];
+    // when center is outside of the polygon next to a corner the closest feature is the corner, not the edge
+    std::optional<sf::Vector2f> corner;
+    if (bestSeparation > 0.f && dot(center - v1, v2 - v1) < 0.f)
+    {
+        corner = v1;
+    }
+    else if (bestSeparation > 0.f && dot(center - v2, v1 - v2) < 0.f)
+    {
+        corner = v2;
+    }
+    if (corner.has_value())
+    {
+        sf::Vector2f offset = center - corner.value();
+        float distanceSquared = dot(offset, offset);
+        if (distanceSquared >= radius * radius)
+        {
+            return {};
+        }
+        float distance = std::sqrt(distanceSquared);
+        sf::Vector2f normal = distance > 0.f ? offset / distance : normals[bestEdge];
+        return Engine::ContactManifold{.normal = normal, .penetration = radius - distance, .point = positionA + corner.value()};
+    }
+    sf::Vector2f normal = normals[bestEdge];
+    return Engine::ContactManifold{.normal = normal, .penetration = radius - bestSeparation, .point = positionB - normal * radius};
+}
+
+std::optional<Engine::ContactManifold> Engine::collideShapes(PhysicsShape const &a, sf::Vector2f positionA, PhysicsShape const &b, sf::Vector2f positionB)
+{
+    bool circleA = a.getType() == ShapeType::Circle;
+    bool circleB = b.getType() == ShapeType::Circle;
+    if (circleA && circleB)
+    {
+        return collideCircles(a, positionA, b, positionB);
+    }
+    if (!circleA && !circleB)
+    {
+        return collidePolygons(a, positionA, b, positionB);
+    }
+    if (circleB)
+    {
+        return collidePolygonCircle(a, positionA, b, positionB);
+    }
+    std::optional<ContactManifold> manifold = collidePolygonCircle(b, positionB, a, positionA);
+    if (manifold.has_value())
+    {
+        manifold->normal = -manifold->normal;
+    }
+    return manifold;
+}
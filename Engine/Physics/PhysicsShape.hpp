@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <optional>
+#include <SFML/Graphics.hpp>
+
+namespace Engine
+{
+    enum class ShapeType
+    {
+        Circle,
+        /// @brief Axis aligned box, handled as a polygon with four vertices
+        Box,
+        /// @brief Convex polygon
+        Polygon
+    };
+
+    /// @brief Collision shape of a physics body. Bodies never rotate since game objects have no rotation, so shapes are described relative to the body position in world axes
+    class PhysicsShape
+    {
+    public:
+        /// @brief Create circle centered at the body position
+        static PhysicsShape createCircle(float radius);
+
+        /// @brief Create box centered at the body position
+        /// @param halfSize Half of the width and height of the box
+        static PhysicsShape createBox(sf::Vector2f halfSize);
+
+        /// @brief Create convex polygon
+        /// @param vertices Vertices relative to the body position in either winding order
+        /// @return Polygon or nothing if there are less than three vertices or polygon is not convex
+        static std::optional<PhysicsShape> createPolygon(std::vector<sf::Vector2f> const &vertices);
+
+        ShapeType getType() const { return m_type; }
+
+        float getRadius() const { return m_radius; }
+
+        /// @brief Get vertices of a box or a polygon. Vertices are ordered so that the signed area is positive
+        std::span<sf::Vector2f const> getVertices() const { return m_vertices; }
+
+        /// @brief Get outward normal of each edge, edge i goes from vertex i to vertex i + 1
+        std::span<sf::Vector2f const> getNormals() const { return m_normals; }
+
+        float getArea() const;
+
+        /// @brief Get bounding box of the shape placed at the given position
+        sf::FloatRect getBounds(sf::Vector2f position) const;
+
+    private:
+        explicit PhysicsShape(ShapeType type) : m_type(type) {}
+
+        /// @brief Compute edge normals of the polygon from its vertices
+        void computeNormals();
+
+        ShapeType m_type;
+        float m_radius = 0.f;
+        std::vector<sf::Vector2f> m_vertices;
+        std::vector<sf::Vector2f> m_normals;
+    };
+
+    /// @brief Information about two touching shapes
+    struct ContactManifold
+    {
+        /// @brief Direction from the first shape to the second one
+        sf::Vector2f normal;
+        /// @brief How deep the shapes are inside each other along the normal
+        float penetration;
+        /// @brief Point of the deepest contact in world space
+        sf::Vector2f point;
+    };
+
+    /// @brief Check if two shapes overlap and find how to separate them
+    /// @param a First shape
+    /// @param positionA Position of the body of the first shape
+    /// @param b Second shape
+    /// @param positionB Position of the body of the second shape
+    /// @return Contact information or nothing if shapes don't overlap
+    std::optional<ContactManifold> collideShapes(PhysicsShape const &a, sf::Vector2f positionA, PhysicsShape const &b, sf::Vector2f positionB);
+}
@@ -0,0 +1,445 @@
+#include "PhysicsWorld.hpp"
+#include <cmath>
+#include <algorithm>
+
+// tuning values are in world units, which are pixels for game objects
+/// @brief Penetration that is left alone by position correction, keeps resting contacts from jittering between touching and separated
+static constexpr float PenetrationSlop = 0.5f;
+/// @brief Fraction of penetration removed every step
+static constexpr float CorrectionFactor = 0.4f;
+/// @brief Bodies hitting each other slower than this don't bounce, otherwise resting bodies would never settle
+static constexpr float RestitutionThreshold = 20.f;
+/// @brief Bodies slower than this are considered to be resting
+static constexpr float SleepVelocity = 4.f;
+/// @brief Time every body of an island has to be resting before the island is put to sleep
+static constexpr float TimeToSleep = 0.5f;
+
+static float dot(sf::Vector2f a, sf::Vector2f b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+Engine::PhysicsWorld::PhysicsWorld(float fixedStep) : m_fixedStep(fixedStep)
+{
+}
+
+void Engine::PhysicsWorld::updateMass(Body &body)
+{
+    if (body.type != BodyType::Dynamic)
+    {
+        body.inverseMass = 0.f;
+        return;
+    }
+    // bodies without area still need finite mass so that they can be pushed around
+    float mass = body.shape.getArea() * body.density;
+    body.inverseMass = mass > 0.f ? 1.f / mass : 1.f;
+}
+
+uint32_t Engine::PhysicsWorld::createBody(BodyDefinition const &definition)
+{
+    Body body{
+        .type = definition.type,
+        .shape = definition.shape,
+        .position = definition.position,
+        .velocity = definition.type == BodyType::Static ? sf::Vector2f() : definition.velocity,
+        .density = definition.density,
+        .inverseMass = 0.f,
+        .friction = std::max(definition.friction, 0.f),
+        .restitution = std::clamp(definition.restitution, 0.f, 1.f),
+        .gravityScale = definition.gravityScale,
+        .linearDamping = std::max(definition.linearDamping, 0.f),
+        .layer = definition.layer,
+        .mask = definition.mask};
+    updateMass(body);
+
+    uint32_t id;
+    if (!m_freeBodies.empty())
+    {
+        id = m_freeBodies.back();
+        m_freeBodies.pop_back();
+        m_bodies[id] = std::move(body);
+    }
+    else
+    {
+        id = (uint32_t)m_bodies.size();
+        m_bodies.push_back(std::move(body));
+    }
+    m_bodyCount++;
+    m_grid.update(id, m_bodies[id].shape.getBounds(m_bodies[id].position), m_bodies[id].layer);
+    return id;
+}
+
+void Engine::PhysicsWorld::destroyBody(uint32_t id)
+{
+    if (!hasBody(id))
+    {
+        return;
+    }
+    wakeContacts(id);
+    std::erase_if(m_contacts, [this, id](Contact const &contact)
+                  {
+                      if (contact.first != id && contact.second != id)
+                      {
+                          return false;
+                      }
+                      m_events.push_back(ContactEvent{contact.first, contact.second, false});
+                      return true; });
+    m_grid.remove(id);
+    m_bodies[id].alive = false;
+    m_freeBodies.push_back(id);
+    m_bodyCount--;
+}
+
+void Engine::PhysicsWorld::setShape(uint32_t id, PhysicsShape const &shape)
+{
+    Body &body = m_bodies[id];
+    body.shape = shape;
+    updateMass(body);
+    m_grid.update(id, body.shape.getBounds(body.position), body.layer);
+    wake(id);
+    wakeContacts(id);
+}
+
+void Engine::PhysicsWorld::setPosition(uint32_t id, sf::Vector2f position)
+{
+    Body &body = m_bodies[id];
+    body.position = position;
+    m_grid.update(id, body.shape.getBounds(body.position), body.layer);
+    wake(id);
+    // bodies resting on this one would not notice that it's gone otherwise
+    wakeContacts(id);
+}
+
+void Engine::PhysicsWorld::setVelocity(uint32_t id, sf::Vector2f velocity)
+{
+    if (m_bodies[id].type == BodyType::Static)
+    {
+        return;
+    }
+    m_bodies[id].velocity = velocity;
+    wake(id);
+}
+
+void Engine::PhysicsWorld::applyImpulse(uint32_t id, sf::Vector2f impulse)
+{
+    if (m_bodies[id].type != BodyType::Dynamic)
+    {
+        return;
+    }
+    m_bodies[id].velocity += impulse * m_bodies[id].inverseMass;
+    wake(id);
+}
+
+void Engine::PhysicsWorld::wake(uint32_t id)
+{
+    m_bodies[id].awake = true;
+    m_bodies[id].sleepTime = 0.f;
+}
+
+void Engine::PhysicsWorld::wakeContacts(uint32_t id)
+{
+    for (Contact const &contact : m_contacts)
+    {
+        if (contact.first == id)
+        {
+            wake(contact.second);
+        }
+        else if (contact.second == id)
+        {
+            wake(contact.first);
+        }
+    }
+}
+
+size_t Engine::PhysicsWorld::getAwakeBodyCount() const
+{
+    return std::count_if(m_bodies.begin(), m_bodies.end(), [](Body const &body)
+                         { return isMoving(body); });
+}
+
+std::vector<Engine::ContactEvent> Engine::PhysicsWorld::takeContactEvents()
+{
+    std::vector<ContactEvent> events = std::move(m_events);
+    m_events.clear();
+    return events;
+}
+
+size_t Engine::PhysicsWorld::step(float delta)
+{
+    m_accumulator += delta;
+    size_t steps = 0;
+    while (m_accumulator >= m_fixedStep && steps < MaxStepsPerCall)
+    {
+        runStep();
+        m_accumulator -= m_fixedStep;
+        steps++;
+    }
+    if (m_accumulator >= m_fixedStep)
+    {
+        m_accumulator = 0.f;
+    }
+    return steps;
+}
+
+void Engine::PhysicsWorld::runStep()
+{
+    float delta = m_fixedStep;
+    for (Body &body : m_bodies)
+    {
+        if (isMoving(body) && body.type == BodyType::Dynamic)
+        {
+            body.velocity += m_gravity * body.gravityScale * delta;
+            body.velocity *= std::max(0.f, 1.f - body.linearDamping * delta);
+        }
+    }
+
+    // both lists are sorted so matching pairs can be found by walking them side by side
+    std::vector<Contact> contacts = findContacts();
+    auto previous = m_contacts.begin();
+    for (Contact &contact : contacts)
+    {
+        while (previous != m_contacts.end() && *previous < contact)
+        {
+            m_events.push_back(ContactEvent{previous->first, previous->second, false});
+            previous++;
+        }
+        if (previous != m_contacts.end() && !(contact < *previous))
+        {
+            // impulses from the last step are a good first guess, which lets stacks settle in fewer iterations
+            contact.normalImpulse = previous->normalImpulse;
+            contact.tangentImpulse = previous->tangentImpulse;
+            previous++;
+        }
+        else
+        {
+            m_events.push_back(ContactEvent{contact.first, contact.second, true});
+        }
+    }
+    for (; previous != m_contacts.end(); previous++)
+    {
+        m_events.push_back(ContactEvent{previous->first, previous->second, false});
+    }
+    m_contacts = std::move(contacts);
+
+    buildIslands();
+    solveContacts();
+    for (size_t i = 0; i < m_bodies.size(); i++)
+    {
+        if (isMoving(m_bodies[i]))
+        {
+            m_bodies[i].position += m_bodies[i].velocity * delta;
+        }
+    }
+    correctPositions();
+    for (size_t i = 0; i < m_bodies.size(); i++)
+    {
+        if (isMoving(m_bodies[i]))
+        {
+            m_grid.update((uint32_t)i, m_bodies[i].shape.getBounds(m_bodies[i].position), m_bodies[i].layer);
+        }
+    }
+    updateSleep(delta);
+}
+
+std::vector<Engine::PhysicsWorld::Contact> Engine::PhysicsWorld::findContacts() const
+{
+    std::vector<Contact> contacts;
+    for (uint32_t i = 0; i < m_bodies.size(); i++)
+    {
+        Body const &body = m_bodies[i];
+        if (!isMoving(body))
+        {
+            continue;
+        }
+        m_grid.query(body.shape.getBounds(body.position), m_queryResult, body.mask);
+        for (uint32_t j : m_queryResult)
+        {
+            Body const &other = m_bodies[j];
+            // pair of moving bodies is found by both of them, so only the one with the lower id keeps it
+            if (j == i || (other.mask & body.layer) == 0 || (isMoving(other) && j < i))
+            {
+                continue;
+            }
+            // nothing would push either of the bodies
+            if (body.type != BodyType::Dynamic && other.type != BodyType::Dynamic)
+            {
+                continue;
+            }
+            uint32_t first = std::min(i, j);
+            uint32_t second = std::max(i, j);
+            if (std::optional<ContactManifold> manifold = collideShapes(m_bodies[first].shape, m_bodies[first].position, m_bodies[second].shape, m_bodies[second].position))
+            {
+                contacts.push_back(Contact{.first = first, .second = second, .manifold = manifold.value()});
+            }
+        }
+    }
+    // bodies that didn't move can't change their contacts
+    for (Contact const &contact : m_contacts)
+    {
+        if (!isMoving(m_bodies[contact.first]) && !isMoving(m_bodies[contact.second]))
+        {
+            contacts.push_back(contact);
+        }
+    }
+    std::sort(contacts.begin(), contacts.end());
+    return contacts;
+}
+
+uint32_t Engine::PhysicsWorld::findIsland(uint32_t id)
+{
+    while (m_islandParents[id] != id)
+    {
+        m_islandParents[id] = m_islandParents[m_islandParents[id]];
+        id = m_islandParents[id];
+    }
+    return id;
+}
+
+void Engine::PhysicsWorld::buildIslands()
+{
+    m_islandParents.resize(m_bodies.size());
+    for (uint32_t i = 0; i < m_bodies.size(); i++)
+    {
+        m_islandParents[i] = i;
+    }
+    // static and kinematic bodies don't join islands, otherwise everything standing on the same floor would be a single island
+    std::vector<uint8_t> hasAwakeBody(m_bodies.size(), 0);
+    for (Contact const &contact : m_contacts)
+    {
+        Body const &first = m_bodies[contact.first];
+        Body const &second = m_bodies[contact.second];
+        if (first.type == BodyType::Dynamic && second.type == BodyType::Dynamic)
+        {
+            uint32_t a = findIsland(contact.first);
+            uint32_t b = findIsland(contact.second);
+            m_islandParents[std::max(a, b)] = std::min(a, b);
+        }
+        // moving kinematic body wakes whatever it touches
+        else if (first.type == BodyType::Kinematic && first.velocity != sf::Vector2f())
+        {
+            hasAwakeBody[contact.second] = 1;
+        }
+        else if (second.type == BodyType::Kinematic && second.velocity != sf::Vector2f())
+        {
+            hasAwakeBody[contact.first] = 1;
+        }
+    }
+    for (uint32_t i = 0; i < m_bodies.size(); i++)
+    {
+        if (m_bodies[i].alive && m_bodies[i].type == BodyType::Dynamic && (m_bodies[i].awake || hasAwakeBody[i]))
+        {
+            hasAwakeBody[findIsland(i)] = 1;
+        }
+    }
+    for (uint32_t i = 0; i < m_bodies.size(); i++)
+    {
+        if (m_bodies[i].alive && m_bodies[i].type == BodyType::Dynamic && !m_bodies[i].awake && hasAwakeBody[findIsland(i)])
+        {
+            wake(i);
+        }
+    }
+}
+
+void Engine::PhysicsWorld::updateSleep(float delta)
+{
+    std::vector<float> islandSleepTime(m_bodies.size(), TimeToSleep);
+    for (uint32_t i = 0; i < m_bodies.size(); i++)
+    {
+        Body &body = m_bodies[i];
+        if (!isMoving(body) || body.type != BodyType::Dynamic)
+        {
+            continue;
+        }
+        body.sleepTime = dot(body.velocity, body.velocity) > SleepVelocity * SleepVelocity ? 0.f : body.sleepTime + delta;
+        uint32_t island = findIsland(i);
+        islandSleepTime[island] = std::min(islandSleepTime[island], body.sleepTime);
+    }
+    for (uint32_t i = 0; i < m_bodies.size(); i++)
+    {
+        Body &body = m_bodies[i];
+        if (isMoving(body) && body.type == BodyType::Dynamic && islandSleepTime[findIsland(i)] >= TimeToSleep)
+        {
+            body.awake = false;
+            body.velocity = sf::Vector2f();
+        }
+    }
+}
+
+float Engine::PhysicsWorld::getSolverInverseMass(uint32_t id) const
+{
+    return isMoving(m_bodies[id]) ? m_bodies[id].inverseMass : 0.f;
+}
+
+void Engine::PhysicsWorld::solveContacts()
+{
+    for (Contact &contact : m_contacts)
+    {
+        Body &first = m_bodies[contact.first];
+        Body &second = m_bodies[contact.second];
+        float inverseMassA = getSolverInverseMass(contact.first);
+        float inverseMassB = getSolverInverseMass(contact.second);
+        if (inverseMassA + inverseMassB == 0.f)
+        {
+            contact.normalImpulse = 0.f;
+            contact.tangentImpulse = 0.f;
+            continue;
+        }
+        sf::Vector2f normal = contact.manifold.normal;
+        sf::Vector2f tangent(-normal.y, normal.x);
+        float approachSpeed = dot(second.velocity - first.velocity, normal);
+        contact.velocityBias = approachSpeed < -RestitutionThreshold ? -std::max(first.restitution, second.restitution) * approachSpeed : 0.f;
+        sf::Vector2f impulse = normal * contact.normalImpulse + tangent * contact.tangentImpulse;
+        first.velocity -= impulse * inverseMassA;
+        second.velocity += impulse * inverseMassB;
+    }
+
+    for (uint32_t iteration = 0; iteration < m_iterations; iteration++)
+    {
+        for (Contact &contact : m_contacts)
+        {
+            Body &first = m_bodies[contact.first];
+            Body &second = m_bodies[contact.second];
+            float inverseMassA = getSolverInverseMass(contact.first);
+            float inverseMassB = getSolverInverseMass(contact.second);
+            float inverseMassSum = inverseMassA + inverseMassB;
+            if (inverseMassSum == 0.f)
+            {
+                continue;
+            }
+            sf::Vector2f normal = contact.manifold.normal;
+            // accumulated impulse is clamped rather than each applied impulse, so that later iterations can take back what earlier ones overdid
+            float lambda = -(dot(second.velocity - first.velocity, normal) - contact.velocityBias) / inverseMassSum;
+            float normalImpulse = std::max(contact.normalImpulse + lambda, 0.f);
+            sf::Vector2f impulse = normal * (normalImpulse - contact.normalImpulse);
+            contact.normalImpulse = normalImpulse;
+            first.velocity -= impulse * inverseMassA;
+            second.velocity += impulse * inverseMassB;
+
+            sf::Vector2f tangent(-normal.y, normal.x);
+            float maxFriction = std::sqrt(first.friction * second.friction) * contact.normalImpulse;
+            lambda = -dot(second.velocity - first.velocity, tangent) / inverseMassSum;
+            float tangentImpulse = std::clamp(contact.tangentImpulse + lambda, -maxFriction, maxFriction);
+            impulse = tangent * (tangentImpulse - contact.tangentImpulse);
+            contact.tangentImpulse = tangentImpulse;
+            first.velocity -= impulse * inverseMassA;
+            second.velocity += impulse * inverseMassB;
+        }
+    }
+}
+
+void Engine::PhysicsWorld::correctPositions()
+{
+    for (Contact const &contact : m_contacts)
+    {
+        float inverseMassA = getSolverInverseMass(contact.first);
+        float inverseMassB = getSolverInverseMass(contact.second);
+        float inverseMassSum = inverseMassA + inverseMassB;
+        if (inverseMassSum == 0.f)
+        {
+            continue;
+        }
+        sf::Vector2f correction = contact.manifold.normal * (std::max(contact.manifold.penetration - PenetrationSlop, 0.f) / inverseMassSum * CorrectionFactor);
+        m_bodies[contact.first].position -= correction * inverseMassA;
+        m_bodies[contact.second].position += correction * inverseMassB;
+    }
+}
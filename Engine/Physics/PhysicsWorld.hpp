@@ -0,0 +1,202 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "PhysicsShape.hpp"
+#include "../Spatial/SpatialGrid.hpp"
+
+namespace Engine
+{
+    enum class BodyType
+    {
+        /// @brief Never moves and is not affected by anything
+        Static,
+        /// @brief Moves only with the velocity it was given, pushes dynamic bodies but is not pushed back
+        Kinematic,
+        /// @brief Affected by gravity, impulses and contacts
+        Dynamic
+    };
+
+    /// @brief Settings of a new physics body
+    struct BodyDefinition
+    {
+        BodyType type = BodyType::Dynamic;
+        PhysicsShape shape = PhysicsShape::createBox(sf::Vector2f(0.5f, 0.5f));
+        sf::Vector2f position = sf::Vector2f();
+        sf::Vector2f velocity = sf::Vector2f();
+        /// @brief Mass per unit of area
+        float density = 1.f;
+        float friction = 0.2f;
+        /// @brief How much of the velocity is kept after bouncing off, 0 means no bounce
+        float restitution = 0.f;
+        float gravityScale = 1.f;
+        /// @brief Fraction of velocity lost per second
+        float linearDamping = 0.f;
+        /// @brief Bit mask of collision layers the body belongs to
+        uint32_t layer = 1;
+        /// @brief Bit mask of collision layers the body collides with
+        uint32_t mask = 0xffffffff;
+    };
+
+    /// @brief Contact between two bodies that started or ended during the step
+    struct ContactEvent
+    {
+        uint32_t first;
+        uint32_t second;
+        /// @brief True if bodies started touching, false if they stopped touching or one of them was destroyed
+        bool began;
+    };
+
+    /// @brief Rigid body simulation that runs at a fixed time step independent of the frame rate.
+    /// Bodies don't rotate, contacts are resolved with sequential impulses and groups of touching bodies that stopped moving are put to sleep together.
+    /// Simulation is deterministic: same bodies and same calls always produce the same results
+    class PhysicsWorld
+    {
+    public:
+        /// @brief Create empty world
+        /// @param fixedStep Duration of a single simulation step in seconds
+        explicit PhysicsWorld(float fixedStep = 1.f / 120.f);
+
+        /// @brief Add new body to the world
+        /// @return Id of the body. Ids of destroyed bodies are reused
+        uint32_t createBody(BodyDefinition const &definition);
+
+        /// @brief Remove body from the world, reporting end of all its contacts
+        void destroyBody(uint32_t id);
+
+        bool hasBody(uint32_t id) const { return id < m_bodies.size() && m_bodies[id].alive; }
+
+        BodyType getBodyType(uint32_t id) const { return m_bodies[id].type; }
+
+        PhysicsShape const &getShape(uint32_t id) const { return m_bodies[id].shape; }
+
+        /// @brief Replace shape of the body, recalculating its mass
+        void setShape(uint32_t id, PhysicsShape const &shape);
+
+        sf::Vector2f getPosition(uint32_t id) const { return m_bodies[id].position; }
+
+        /// @brief Move body to a new position without sweeping through things on the way
+        void setPosition(uint32_t id, sf::Vector2f position);
+
+        sf::Vector2f getVelocity(uint32_t id) const { return m_bodies[id].velocity; }
+
+        void setVelocity(uint32_t id, sf::Vector2f velocity);
+
+        /// @brief Instantly change velocity of a dynamic body as if it was hit
+        /// @param impulse Impulse, velocity changes by impulse divided by mass
+        void applyImpulse(uint32_t id, sf::Vector2f impulse);
+
+        bool isSleeping(uint32_t id) const { return !m_bodies[id].awake; }
+
+        void wake(uint32_t id);
+
+        void setGravity(sf::Vector2f gravity) { m_gravity = gravity; }
+
+        sf::Vector2f getGravity() const { return m_gravity; }
+
+        float getFixedStep() const { return m_fixedStep; }
+
+        /// @brief Set amount of times every contact is solved per step. More iterations make stacks more stable
+        void setIterations(uint32_t iterations) { m_iterations = iterations; }
+
+        /// @brief Advance simulation by the given time. Time that doesn't fill a whole step is carried over to the next call
+        /// @param delta Time passed since last call
+        /// @return Amount of steps that were run
+        size_t step(float delta);
+
+        /// @brief Run a single simulation step of fixed duration
+        void runStep();
+
+        /// @brief Get contacts that began or ended since the last call and forget them
+        std::vector<ContactEvent> takeContactEvents();
+
+        size_t getBodyCount() const { return m_bodyCount; }
+
+        size_t getAwakeBodyCount() const;
+
+        size_t getContactCount() const { return m_contacts.size(); }
+
+        /// @brief Steps that can run in a single call to step, time beyond that is dropped so that a slow frame doesn't make the next one even slower
+        static constexpr size_t MaxStepsPerCall = 8;
+
+    private:
+        struct Body
+        {
+            BodyType type;
+            PhysicsShape shape;
+            sf::Vector2f position;
+            sf::Vector2f velocity;
+            float density;
+            float inverseMass;
+            float friction;
+            float restitution;
+            float gravityScale;
+            float linearDamping;
+            uint32_t layer;
+            uint32_t mask;
+            bool awake = true;
+            bool alive = true;
+            /// @brief How long the body has been moving slowly enough to sleep
+            float sleepTime = 0.f;
+        };
+
+        struct Contact
+        {
+            uint32_t first;
+            uint32_t second;
+            ContactManifold manifold;
+            float normalImpulse = 0.f;
+            float tangentImpulse = 0.f;
+            /// @brief Velocity along the normal the contact should end with, used for bouncing
+            float velocityBias = 0.f;
+
+            bool operator<(Contact const &other) const { return first < other.first || (first == other.first && second < other.second); }
+        };
+
+        /// @brief Compute inverse mass of the body from its shape, density and type
+        static void updateMass(Body &body);
+
+        /// @brief Should the body move on its own during the step
+        static bool isMoving(Body const &body) { return body.alive && body.awake && body.type != BodyType::Static; }
+
+        /// @brief Find all touching pairs that include at least one moving body. Contacts of sleeping bodies are kept as they were
+        std::vector<Contact> findContacts() const;
+
+        /// @brief Group dynamic bodies connected by contacts into islands and wake every island that has at least one awake body in it
+        void buildIslands();
+
+        /// @brief Put islands in which every body has been moving slowly for long enough to sleep
+        /// @param delta Duration of the step
+        void updateSleep(float delta);
+
+        /// @brief Wake every body touching the given one, used when body changes in a way that sleeping neighbours can't notice
+        void wakeContacts(uint32_t id);
+
+        /// @brief Get inverse mass of the body as seen by the solver, bodies that can't be moved during the step have infinite mass
+        float getSolverInverseMass(uint32_t id) const;
+
+        /// @brief Find island id of the body, compressing the path on the way
+        uint32_t findIsland(uint32_t id);
+
+        /// @brief Apply impulses until contacts stop pushing bodies into each other
+        void solveContacts();
+
+        /// @brief Push overlapping bodies apart to remove penetration left after solving velocities
+        void correctPositions();
+
+        float m_fixedStep;
+        float m_accumulator = 0.f;
+        uint32_t m_iterations = 8;
+        sf::Vector2f m_gravity;
+        std::vector<Body> m_bodies;
+        std::vector<uint32_t> m_freeBodies;
+        size_t m_bodyCount = 0;
+        /// @brief Broadphase index of the body bounds, using body ids
+        SpatialGrid m_grid;
+        /// @brief Contacts found during the last step, sorted by ids of the bodies
+        std::vector<Contact> m_contacts;
+        std::vector<ContactEvent> m_events;
+        /// @brief Parent of each body in the island structure built every step
+        std::vector<uint32_t> m_islandParents;
+        mutable std::vector<uint32_t> m_queryResult;
+    };
+}
@@ -5,10 +5,15 @@
 #include "System/Input.hpp"
 #include "System/Random.hpp"
 #include "Object/TextObject.hpp"
+#include "Object/TilemapObject.hpp"
+#include "Object/ParticleEmitterObject.hpp"
 #include "Object/ArrayObject.hpp"
 #include "TypeManager.hpp"
 
+#include <cmath>
 #include <numbers>
+#include <algorithm>
+#include <iterator>
 
 Engine::Scene::Scene(Runnable::RunnableCode const &code) : m_strings(code.strings), m_functions(code.functions), m_debugInfo(code.debugInfo)
 {
@@ -16,6 +21,9 @@ Engine::Scene::Scene(Runnable::RunnableCode const &code) : m_strings(code.string
 
 Engine::Scene::Scene(SceneDescription const &scene, Runnable::RunnableCode const &code) : m_strings(code.strings), m_functions(code.functions), m_debugInfo(code.debugInfo)
 {
+    m_updateRegion = scene.getUpdateRegion();
+    // policies have to be known before objects are created
+    m_typeUpdatePolicies.insert(scene.getTypeUpdatePolicies().begin(), scene.getTypeUpdatePolicies().end());
     for (auto const &obj : scene.getObjects())
     {
         GameObject *gameObj = nullptr;
@@ -30,6 +38,29 @@ Engine::Scene::Scene(SceneDescription const &scene, Runnable::RunnableCode const
             label->setText(labelData->getText());
             gameObj = label;
         }
+        else if (SceneDescriptionTilemapObject const *tilemapData = dynamic_cast<SceneDescriptionTilemapObject const *>(obj.get()); tilemapData != nullptr)
+        {
+            TilemapObject *tilemap = createObject<TilemapObject>(TypeManager::getInstance().getType(obj->getTypeName()),
+                                                                 obj->getName(),
+                                                                 tilemapData->getTilesetName(),
+                                                                 tilemapData->getMapSize(),
+                                                                 tilemapData->getTileSize());
+            tilemap->setTiles(tilemapData->getTiles());
+            for (auto const &[tile, solid] : tilemapData->getSolidTiles())
+            {
+                tilemap->setTileSolid(tile, solid);
+            }
+            gameObj = tilemap;
+        }
+        else if (SceneDescriptionParticleEmitterObject const *emitterData = dynamic_cast<SceneDescriptionParticleEmitterObject const *>(obj.get()); emitterData != nullptr)
+        {
+            ParticleEmitterObject *emitter = createObject<ParticleEmitterObject>(TypeManager::getInstance().getType(obj->getTypeName()), obj->getName(), emitterData->getEffectName());
+            if (emitterData->isEmitting())
+            {
+                emitter->emit();
+            }
+            gameObj = emitter;
+        }
         else
         {
             if (ObjectType const *type = TypeManager::getInstance().getType(obj->getTypeName()); type != nullptr)
@@ -51,6 +82,10 @@ Engine::Scene::Scene(SceneDescription const &scene, Runnable::RunnableCode const
             }
         }
         gameObj->setPosition(obj->getStartPosition());
+        if (obj->getUpdatePolicy().has_value())
+        {
+            applyUpdatePolicy(gameObj, obj->getUpdatePolicy().value());
+        }
         for (auto const &[name, val] : obj->getDefaultValues())
         {
             switch ((SceneDescriptionPropValueType)val.index())
@@ -77,58 +112,90 @@ Engine::Scene::Scene(SceneDescription const &scene, Runnable::RunnableCode const
 
 void Engine::Scene::update(float delta)
 {
-    for (auto const &obj : m_objects)
+    m_updatedObjectCount = 0;
+    // movement is applied before scripts so that they see where objects are on this frame
+    integrateKinematics(delta);
+    stepPhysics(delta);
+    dispatchFinishedPaths();
+    dispatchTimers(delta);
+    updateTweens(delta);
+    // iterate using slot indices since scripts can create new objects and that can cause storage to grow
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
     {
-        if (obj->isDestroyed())
+        GameObject *obj = m_objects.getAt(i);
+        if (obj == nullptr)
         {
             continue;
         }
-        obj->update(delta);
+        std::optional<float> objectDelta = obj->advanceUpdateClock(delta, m_updateRegion);
+        if (!objectDelta.has_value())
+        {
+            continue;
+        }
+        m_updatedObjectCount++;
+        obj->update(objectDelta.value());
         if (obj->getType()->hasMethod("update"))
         {
-            runMethod(obj.get(), "update");
+            runMethod(obj, "update");
         }
         if (obj->hasAnimationJustFinished() && !obj->isDestroyed())
         {
             obj->setAnimationJustFinished(false);
             if (obj->getType()->hasMethod("on_animation_ended"))
             {
-                runMethod(obj.get(), "on_animation_ended");
+                runMethod(obj, "on_animation_ended");
             }
         }
     }
+    updateCollisions();
     if (hasFunction("update"))
     {
         runFunctionByName("update");
     }
-
-    for (int64_t i = m_objects.size() - 1; i >= 0; i--)
+    // no code is running at this point so nothing can be using destroyed objects anymore
+    m_destroyedObjects.clear();
+    // temporary values can only be referenced by operation stacks and local variables, which are all gone once no code is running
+    m_garbageCollector.releaseTemporaries();
+    collectGarbage();
+    if (m_garbageCollector.isTraceNeeded())
     {
-        // to destroy objects we have to make sure they are marked as destroyed
-        // and not referenced
-        if (m_objects[i]->isDestroyed() && m_objects[i]->isDead())
-        {
-            m_objects.erase(m_objects.begin() + i);
-        }
+        collectCycles();
     }
-    collectGarbage();
+    // only report once per overflow so that log and handlers are not flooded every frame
+    bool overBudget = isOverMemoryBudget();
+    if (overBudget && !m_memoryBudgetWarned)
+    {
+        m_memoryBudgetWarned = true;
+        size_t liveBytes = m_garbageCollector.getStatistics().liveBytes;
+        std::cerr << "Warning: managed memory usage (" << liveBytes << " bytes) exceeds the budget of " << m_memoryBudget << " bytes" << std::endl;
+        // handlers get a chance to drop caches or change scenes, anything they allocate is handled by the next frame.
+        // arguments are popped from the end, so handler receives used bytes first and the budget second
+        callSceneAndObjectScriptFunctionHandlers("on_memory_budget_exceeded", {(IntType)m_memoryBudget, (IntType)liveBytes});
+    }
+    m_memoryBudgetWarned = overBudget;
 }
 
 void Engine::Scene::draw(sf::RenderWindow &window)
 {
-    for (std::unique_ptr<GameObject> const &obj : m_objects)
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
     {
-        obj->draw(window);
+        if (GameObject *obj = m_objects.getAt(i); obj != nullptr)
+        {
+            obj->draw(window);
+        }
     }
 }
 void Engine::Scene::callSceneAndObjectScriptFunctionHandlers(std::string const &eventName, std::vector<Value> const &arguments)
 {
-    for (auto const &obj : m_objects)
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
     {
-        if (obj->getType()->hasMethod(eventName))
+        GameObject *obj = m_objects.getAt(i);
+        if (obj != nullptr && obj->getType()->hasMethod(eventName))
         {
+            // objects that listen to the event are woken up by it
+            obj->wake();
             appendArrayToStack(arguments);
-            runMethod(obj.get(), eventName);
+            runMethod(obj, eventName);
         }
     }
     if (hasFunction(eventName))
@@ -146,16 +213,161 @@ void Engine::Scene::handleMouseMove(sf::Vector2f position)
     callSceneAndObjectScriptFunctionHandlers("on_mouse_move", {position});
 }
 
-Engine::StringObject *Engine::Scene::createString(std::string const &str)
+Engine::StringObject *Engine::Scene::createString(std::string_view str)
 {
-    m_memory.push_back(std::make_unique<StringObject>(str));
-    return (Engine::StringObject *)m_memory.back().get();
+    return m_garbageCollector.create<StringObject>(str);
 }
 
 Engine::ArrayObject *Engine::Scene::createArray(std::vector<Value> const &values)
 {
-    m_memory.push_back(std::make_unique<ArrayObject>(values));
-    return (Engine::ArrayObject *)m_memory.back().get();
+    return m_garbageCollector.create<ArrayObject>(values);
+}
+
+Engine::StringObject *Engine::Scene::createTemporaryString(std::string_view str)
+{
+    return m_garbageCollector.createTemporary<StringObject>(str);
+}
+
+Engine::ArrayObject *Engine::Scene::createTemporaryArray(std::vector<Value> const &values)
+{
+    return m_garbageCollector.createTemporary<ArrayObject>(values);
+}
+
+Engine::ArrayObject *Engine::Scene::createRayHitArray(std::vector<ObjectRayHit> const &hits)
+{
+    std::vector<Value> items;
+    items.reserve(hits.size());
+    for (ObjectRayHit const &hit : hits)
+    {
+        items.push_back(createTemporaryArray({hit.object->getHandle(), hit.point, (FloatType)hit.distance}));
+    }
+    return createTemporaryArray(items);
+}
+
+Engine::ArrayObject *Engine::Scene::createHandleArray(std::span<GameObject *const> objects)
+{
+    ArrayObject *arr = m_garbageCollector.createTemporary<ArrayObject>(objects.size());
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        arr->setItem(i, objects[i]->getHandle());
+    }
+    return arr;
+}
+
+Engine::ArrayObject *Engine::Scene::shareArray(ArrayObject const *source)
+{
+    // temporary and regular arrays never share buffers, otherwise regular array could end up with temporary items
+    if (GarbageCollector::isTemporary(source))
+    {
+        return m_garbageCollector.createTemporary<ArrayObject>(*source);
+    }
+    return m_garbageCollector.create<ArrayObject>(*source);
+}
+
+Engine::MapObject *Engine::Scene::createMap()
+{
+    return m_garbageCollector.create<MapObject>();
+}
+
+Engine::StructObject *Engine::Scene::createStruct(StructType const *type)
+{
+    return m_garbageCollector.createSized<StructObject>(StructObject::getAllocationSize(type), type);
+}
+
+std::optional<size_t> Engine::Scene::findFieldSlot(Runnable::RunnableFunction const &func, size_t cacheId, StructType const *type, std::string_view name)
+{
+    if (cacheId >= func.fieldSlotCaches.size())
+    {
+        return type->getFieldSlot(std::string(name));
+    }
+    // names of get_field and set_field never change, so for them this is only a type check after the first access
+    Runnable::FieldSlotCache &cache = func.fieldSlotCaches[cacheId];
+    if (cache.type != type || cache.name != name)
+    {
+        cache.name = name;
+        cache.slot = type->getFieldSlot(cache.name);
+        cache.type = type;
+    }
+    return cache.slot;
+}
+
+Engine::StructObject *Engine::Scene::tryPopStruct()
+{
+    if (m_operationStack.empty() || m_operationStack.back().empty() || m_operationStack.back().back().index() != ValueType::Struct)
+    {
+        return nullptr;
+    }
+    StructObject *obj = std::get<StructObject *>(m_operationStack.back().back());
+    m_operationStack.back().pop_back();
+    return obj;
+}
+
+Engine::GameObject const *Engine::Scene::tryPopIgnoredObject()
+{
+    if (m_operationStack.empty() || m_operationStack.back().empty() || m_operationStack.back().back().index() != ValueType::Object)
+    {
+        return nullptr;
+    }
+    ObjectHandle handle = std::get<ObjectHandle>(m_operationStack.back().back());
+    m_operationStack.back().pop_back();
+    // destroyed object can not be hit anyway, so there is nothing to ignore
+    return getObject(handle);
+}
+
+void Engine::Scene::setMapItem(MapObject *map, Value const &key, Value const &value)
+{
+    Value storedKey = key;
+    if (key.index() == ValueType::String && !std::get<StringObject *>(key)->isInterned() && !map->has(key))
+    {
+        storedKey = createString(std::get<StringObject *>(key)->getString());
+    }
+    map->set(storedKey, getPersistentValue(value));
+}
+
+Engine::Value Engine::Scene::getAssignableValue(Value const &v)
+{
+    // arrays that are already stored somewhere get a new array object sharing the items
+    // this way changing array through one variable never changes it for the other one
+    if (v.index() == ValueType::Array && (std::get<ArrayObject *>(v)->getRefCount() > 0 || std::get<ArrayObject *>(v)->isStoredInVariable()))
+    {
+        return shareArray(std::get<ArrayObject *>(v));
+    }
+    return v;
+}
+
+Engine::Value Engine::Scene::getPersistentValue(Value const &v)
+{
+    MemoryObject const *obj = getValueMemoryObject(v);
+    if (obj == nullptr || !GarbageCollector::isTemporary(obj))
+    {
+        return getAssignableValue(v);
+    }
+    switch (v.index())
+    {
+    case ValueType::String:
+        return createString(std::get<StringObject *>(v)->getString());
+    case ValueType::Array:
+    {
+        std::vector<Value> items;
+        items.reserve(std::get<ArrayObject *>(v)->getLength());
+        for (Value const &item : std::get<ArrayObject *>(v)->getItems())
+        {
+            items.push_back(getPersistentValue(item));
+        }
+        return createArray(items);
+    }
+    }
+    return v;
+}
+
+Engine::Value Engine::Scene::getArrayItemValue(ArrayObject const *arr, Value const &v)
+{
+    return GarbageCollector::isTemporary(arr) ? getAssignableValue(v) : getPersistentValue(v);
+}
+
+Engine::TypedArrayObject *Engine::Scene::createTypedArray(TypedArrayObject::ElementType type, size_t size)
+{
+    return m_garbageCollector.create<TypedArrayObject>(type, size);
 }
 
 std::string const &Engine::Scene::getConstantStringById(size_t id) const
@@ -168,11 +380,28 @@ std::string const &Engine::Scene::getConstantStringById(size_t id) const
         }
         return m_executedTypes.back()->getStringAt(id);
     }
-    if (id >= m_strings.size())
+    if (!m_strings.has(id))
     {
         throw Errors::RuntimeMemoryError("Unable to find string constant with id " + std::to_string(id));
     }
-    return m_strings[id];
+    return m_strings.getText(id);
+}
+
+Engine::StringObject *Engine::Scene::getConstantStringObjectById(size_t id) const
+{
+    if (!m_executedTypes.empty())
+    {
+        if (!m_executedTypes.back()->hasStringAt(id))
+        {
+            throw Errors::RuntimeMemoryError("Unable to find string constant with id " + std::to_string(id) + " in current class");
+        }
+        return m_executedTypes.back()->getStringObjectAt(id);
+    }
+    if (!m_strings.has(id))
+    {
+        throw Errors::RuntimeMemoryError("Unable to find string constant with id " + std::to_string(id));
+    }
+    return m_strings.get(id);
 }
 
 Engine::Value Engine::Scene::popFromStackOrError()
@@ -186,27 +415,128 @@ Engine::Value Engine::Scene::popFromStackOrError()
     return r;
 }
 
-void Engine::Scene::setVariableValue(size_t id, Value const &val)
+void Engine::Scene::setVariableValue(size_t id, Value const &value)
 {
     if (m_variables.empty())
     {
         throw Errors::RuntimeMemoryError("No variable block is present");
     }
-    std::vector<Value> &frame = m_variables.back();
+    // value moved out of a variable that is never read again is only held by this store now, so it's kept as is together with the reference of that variable
+    bool adopted = adoptMovedReference(value);
+    Value val = adopted ? value : getAssignableValue(value);
+    std::pmr::vector<Value> &frame = m_variables.back();
     if (id >= frame.size())
     {
         // this should give us enough space
         // fill it with nil values
         frame.resize(id + 1, NilType());
     }
+    if (m_deferVariableReferences)
+    {
+        // variables are scanned as roots at safe points, the only thing that needs to be tracked is which arrays are not free to reuse
+        if (val.index() == ValueType::Array && !adopted)
+        {
+            std::get<ArrayObject *>(val)->addVariableReference();
+        }
+        if (frame[id].index() == ValueType::Array)
+        {
+            std::get<ArrayObject *>(frame[id])->removeVariableReference();
+        }
+    }
     else
     {
-        // if we didn't have to resize that means we might have already used the slot
-        // so to prepare to override we mark the object in it as unused
+        // slot might have been used already, so the object in it is marked as unused
+        if (!adopted)
+        {
+            increaseValueRefCount(val);
+        }
         decreaseValueRefCount(frame[id]);
     }
     frame[id] = val;
-    increaseValueRefCount(val);
+}
+
+void Engine::Scene::moveArgumentsToVariables(size_t count)
+{
+    if (m_variables.empty())
+    {
+        throw Errors::RuntimeMemoryError("No variable block is present");
+    }
+    std::pmr::vector<Value> &frame = m_variables.back();
+    // block was just created, so slots hold nothing that would need to be released
+    frame.resize(count, NilType());
+    for (size_t i = 0; i < count; i++)
+    {
+        // value leaves the operation stack, which never counts as a reference, so it only has to be retained by the variable
+        // unless the caller moved it out of its own variable
+        Value arg = popFromStackOrError();
+        bool adopted = adoptMovedReference(arg);
+        Value val = adopted ? arg : getAssignableValue(arg);
+        if (!adopted && !m_deferVariableReferences)
+        {
+            increaseValueRefCount(val);
+        }
+        else if (!adopted && val.index() == ValueType::Array)
+        {
+            std::get<ArrayObject *>(val)->addVariableReference();
+        }
+        frame[i] = val;
+    }
+}
+
+std::optional<Engine::Value> Engine::Scene::takeVariableValue(size_t id)
+{
+    if (m_variables.empty() || id >= m_variables.back().size())
+    {
+        return {};
+    }
+    Value val = std::exchange(m_variables.back()[id], NilType());
+    // deferred variables only hold references of arrays, anything else is kept alive by the operation stack it is pushed to
+    if (m_deferVariableReferences ? val.index() == ValueType::Array : isManagedValue(val))
+    {
+        if (m_movedReferenceCount == m_movedReferences.size())
+        {
+            releaseMovedReferences();
+        }
+        m_movedReferences[m_movedReferenceCount++] = val;
+    }
+    return val;
+}
+
+bool Engine::Scene::adoptMovedReference(Value const &v)
+{
+    if (m_movedReferenceCount == 0)
+    {
+        return false;
+    }
+    // moved reference is not tied to any location, so any store of the same object can take it
+    MemoryObject const *obj = getValueMemoryObject(v);
+    for (size_t i = 0; i < m_movedReferenceCount; i++)
+    {
+        if (obj != nullptr && getValueMemoryObject(m_movedReferences[i]) == obj)
+        {
+            m_movedReferences[i] = m_movedReferences[--m_movedReferenceCount];
+            m_movedReferences[m_movedReferenceCount] = NilType();
+            return true;
+        }
+    }
+    return false;
+}
+
+void Engine::Scene::releaseMovedReferences()
+{
+    for (size_t i = 0; i < m_movedReferenceCount; i++)
+    {
+        if (!m_deferVariableReferences)
+        {
+            decreaseValueRefCount(m_movedReferences[i]);
+        }
+        else if (m_movedReferences[i].index() == ValueType::Array)
+        {
+            std::get<ArrayObject *>(m_movedReferences[i])->removeVariableReference();
+        }
+        m_movedReferences[i] = NilType();
+    }
+    m_movedReferenceCount = 0;
 }
 
 std::optional<Engine::Value> Engine::Scene::getVariableValue(size_t id) const
@@ -220,7 +550,7 @@ std::optional<Engine::Value> Engine::Scene::getVariableValue(size_t id) const
 
 void Engine::Scene::createVariableBlock()
 {
-    m_variables.push_back({});
+    m_variables.emplace_back();
 }
 
 void Engine::Scene::popVariableBlock()
@@ -228,7 +558,14 @@ void Engine::Scene::popVariableBlock()
     // once variable block is free the values should also be freed
     for (Value const &v : m_variables.back())
     {
-        decreaseValueRefCount(v);
+        if (!m_deferVariableReferences)
+        {
+            decreaseValueRefCount(v);
+        }
+        else if (v.index() == ValueType::Array)
+        {
+            std::get<ArrayObject *>(v)->removeVariableReference();
+        }
     }
     m_variables.pop_back();
 }
@@ -268,56 +605,697 @@ void Engine::Scene::error(std::optional<Runnable::RunnableFunctionDebugInfo> con
     }
 }
 
-Engine::GameObject *Engine::Scene::getObjectByName(std::string const &name) const
+Engine::GameObject *Engine::Scene::getObjectByName(std::string const &name) const
+{
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
+    {
+        if (GameObject *obj = m_objects.getAt(i); obj != nullptr && obj->getName() == name)
+        {
+            return obj;
+        }
+    }
+    return nullptr;
+}
+
+void Engine::Scene::destroyObject(GameObject *obj)
+{
+    obj->destroy();
+    if (std::unique_ptr<GameObject> removed = m_objects.remove(obj->getHandle()); removed != nullptr)
+    {
+        unregisterDestroyedObject(removed.get());
+        m_destroyedObjects.push_back(std::move(removed));
+    }
+}
+
+void Engine::Scene::registerCreatedObject(GameObject *obj, UpdatePolicy const &policy)
+{
+    obj->setSpatialIndex(&m_spatialGrid);
+    createObjectBody(obj);
+    applyUpdatePolicy(obj, policy);
+    size_t size = obj->getAllocatedSize();
+    obj->setAccountedSize(size);
+    m_objectUsage.add(size);
+    m_objectUsageByType[obj->getType()->getName()].add(size);
+}
+
+void Engine::Scene::applyUpdatePolicy(GameObject *obj, UpdatePolicy const &policy)
+{
+    obj->setUpdatePolicy(policy);
+    if (policy.startAsleep)
+    {
+        obj->sleep();
+    }
+    else
+    {
+        obj->wake();
+    }
+}
+
+Engine::UpdatePolicy Engine::Scene::getTypeUpdatePolicy(ObjectType const *type) const
+{
+    if (auto it = m_typeUpdatePolicies.find(type->getName()); it != m_typeUpdatePolicies.end())
+    {
+        return it->second;
+    }
+    return type->getDefaultUpdatePolicy();
+}
+
+void Engine::Scene::setTypeUpdatePolicy(ObjectType const *type, UpdatePolicy const &policy)
+{
+    m_typeUpdatePolicies[type->getName()] = policy;
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
+    {
+        // objects that are already running are not put to sleep by the new policy
+        if (GameObject *obj = m_objects.getAt(i); obj != nullptr && obj->getType() == type)
+        {
+            obj->setUpdatePolicy(policy);
+        }
+    }
+}
+
+void Engine::Scene::unregisterDestroyedObject(GameObject *obj)
+{
+    obj->setSpatialIndex(nullptr);
+    m_spatialGrid.remove(obj->getHandle().index);
+    m_kinematics.remove(obj->getHandle().index);
+    if (std::optional<uint32_t> body = getObjectBody(obj); body.has_value())
+    {
+        m_physics->destroyBody(body.value());
+        // objects that touched this one get their end events on the next physics update
+        collectContactEvents();
+        m_physicsLinks[body.value()].reset();
+        m_objectBodies[obj->getHandle().index].reset();
+    }
+    m_objectUsage.remove(obj->getAccountedSize());
+    m_objectUsageByType[obj->getType()->getName()].remove(obj->getAccountedSize());
+}
+
+std::span<Engine::GameObject *const> Engine::Scene::getObjectsInArea(sf::FloatRect const &area, GameObject const *ignored, ObjectType const *type) const
+{
+    m_spatialGrid.query(area, m_spatialQueryResult);
+    m_objectQueryResult.clear();
+    for (uint32_t id : m_spatialQueryResult)
+    {
+        GameObject *obj = m_objects.getAt(id);
+        if (obj != nullptr && obj != ignored && (type == nullptr || obj->getType() == type))
+        {
+            m_objectQueryResult.push_back(obj);
+        }
+    }
+    return m_objectQueryResult;
+}
+
+std::vector<Engine::ObjectRayHit> Engine::Scene::castRay(sf::Vector2f origin, sf::Vector2f direction, float maxDistance, GameObject const *ignored, ObjectType const *type) const
+{
+    m_spatialGrid.raycast(origin, direction, maxDistance, m_rayHits);
+    std::vector<ObjectRayHit> result;
+    result.reserve(m_rayHits.size());
+    for (RayHit const &hit : m_rayHits)
+    {
+        GameObject *obj = m_objects.getAt(hit.id);
+        if (obj != nullptr && obj != ignored && (type == nullptr || obj->getType() == type))
+        {
+            result.push_back(ObjectRayHit{.object = obj, .point = origin + direction * hit.distance, .distance = hit.distance});
+        }
+    }
+    return result;
+}
+
+std::span<Engine::GameObject *const> Engine::Scene::getObjectsAtPoint(sf::Vector2f point) const
+{
+    m_spatialGrid.queryPoint(point, m_spatialQueryResult);
+    m_objectQueryResult.clear();
+    for (uint32_t id : m_spatialQueryResult)
+    {
+        if (GameObject *obj = m_objects.getAt(id); obj != nullptr)
+        {
+            m_objectQueryResult.push_back(obj);
+        }
+    }
+    return m_objectQueryResult;
+}
+
+void Engine::Scene::integrateKinematics(float delta)
+{
+    std::span<uint32_t const> ids = m_kinematics.getIds();
+    // positions are copied in every frame since scripts can move objects directly
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        m_kinematics.setPosition(i, m_objects.getAt(ids[i])->getPosition());
+    }
+    m_kinematics.integrate(delta);
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        if (m_kinematics.hasMoved(i))
+        {
+            m_objects.getAt(ids[i])->setPosition(m_kinematics.getPosition(i));
+        }
+    }
+}
+
+/// @brief Get number stored in a type constant
+static std::optional<float> getNumberConstant(Engine::ObjectType const *type, std::string const &name)
+{
+    std::optional<Engine::Value> val = type->getConstant(name);
+    if (val.has_value() && val->index() == Engine::ValueType::Float)
+    {
+        return (float)std::get<Engine::FloatType>(val.value());
+    }
+    if (val.has_value() && val->index() == Engine::ValueType::Integer)
+    {
+        return (float)std::get<Engine::IntType>(val.value());
+    }
+    return {};
+}
+
+/// @brief Build shape of the body that covers the whole object
+static Engine::PhysicsShape createShapeFromSize(Engine::ObjectType const *type, sf::Vector2f size)
+{
+    std::optional<Engine::Value> shape = type->getConstant("shape");
+    if (shape.has_value() && shape->index() == Engine::ValueType::String && std::get<Engine::StringObject *>(shape.value())->getString() == "circle")
+    {
+        return Engine::PhysicsShape::createCircle(getNumberConstant(type, "radius").value_or(std::min(size.x, size.y) / 2.f));
+    }
+    return Engine::PhysicsShape::createBox(size / 2.f);
+}
+
+Engine::PhysicsWorld &Engine::Scene::getPhysics()
+{
+    if (m_physics == nullptr)
+    {
+        m_physics = std::make_unique<PhysicsWorld>();
+    }
+    return *m_physics;
+}
+
+std::optional<uint32_t> Engine::Scene::getObjectBody(GameObject const *obj) const
+{
+    if (obj->getHandle().index < m_objectBodies.size())
+    {
+        return m_objectBodies[obj->getHandle().index];
+    }
+    return {};
+}
+
+void Engine::Scene::setObjectShape(GameObject const *obj, PhysicsShape const &shape)
+{
+    std::optional<uint32_t> body = getObjectBody(obj);
+    if (!body.has_value())
+    {
+        throw Errors::ExecutionError("Object " + obj->getName() + " has no physics body");
+    }
+    m_physics->setShape(body.value(), shape);
+    m_physicsLinks[body.value()]->shapeFromSize = false;
+}
+
+void Engine::Scene::createObjectBody(GameObject *obj)
+{
+    ObjectType const *type = obj->getType();
+    std::optional<BodyType> bodyType = type->getBodyType();
+    if (!bodyType.has_value())
+    {
+        return;
+    }
+    BodyDefinition definition{
+        .type = bodyType.value(),
+        .shape = createShapeFromSize(type, obj->getSize()),
+        .position = obj->getPosition() + obj->getSize() / 2.f,
+        .density = getNumberConstant(type, "density").value_or(1.f),
+        .friction = getNumberConstant(type, "friction").value_or(0.2f),
+        .restitution = getNumberConstant(type, "restitution").value_or(0.f),
+        .gravityScale = getNumberConstant(type, "gravity_scale").value_or(1.f),
+        .linearDamping = getNumberConstant(type, "damping").value_or(0.f),
+        .layer = type->getCollisionLayer(),
+        .mask = type->getCollisionMask()};
+
+    uint32_t body = getPhysics().createBody(definition);
+    if (body >= m_physicsLinks.size())
+    {
+        m_physicsLinks.resize(body + 1);
+    }
+    m_physicsLinks[body] = PhysicsLink{.object = obj->getHandle(), .syncedPosition = obj->getPosition(), .syncedSize = obj->getSize(), .shapeFromSize = true};
+    if (obj->getHandle().index >= m_objectBodies.size())
+    {
+        m_objectBodies.resize(obj->getHandle().index + 1);
+    }
+    m_objectBodies[obj->getHandle().index] = body;
+}
+
+void Engine::Scene::stepPhysics(float delta)
+{
+    if (m_physics == nullptr)
+    {
+        return;
+    }
+    for (uint32_t body = 0; body < m_physicsLinks.size(); body++)
+    {
+        if (!m_physicsLinks[body].has_value())
+        {
+            continue;
+        }
+        PhysicsLink &link = m_physicsLinks[body].value();
+        GameObject *obj = getObject(link.object);
+        if (link.shapeFromSize && obj->getSize() != link.syncedSize)
+        {
+            m_physics->setShape(body, createShapeFromSize(obj->getType(), obj->getSize()));
+            link.syncedSize = obj->getSize();
+        }
+        // objects moved by scripts teleport their bodies
+        if (obj->getPosition() != link.syncedPosition)
+        {
+            m_physics->setPosition(body, obj->getPosition() + obj->getSize() / 2.f);
+            link.syncedPosition = obj->getPosition();
+        }
+    }
+    if (m_physics->step(delta) > 0)
+    {
+        for (uint32_t body = 0; body < m_physicsLinks.size(); body++)
+        {
+            if (m_physicsLinks[body].has_value() && m_physics->getBodyType(body) != BodyType::Static && !m_physics->isSleeping(body))
+            {
+                PhysicsLink &link = m_physicsLinks[body].value();
+                GameObject *obj = getObject(link.object);
+                link.syncedPosition = m_physics->getPosition(body) - obj->getSize() / 2.f;
+                obj->setPosition(link.syncedPosition);
+            }
+        }
+    }
+    collectContactEvents();
+    // handlers can destroy objects, which adds new events to the list
+    std::vector<ObjectContactEvent> events = std::move(m_contactEvents);
+    m_contactEvents.clear();
+    for (ObjectContactEvent const &event : events)
+    {
+        std::string const handler = event.began ? "on_contact_begin" : "on_contact_end";
+        runCollisionHandler(event.first, event.second, handler);
+        runCollisionHandler(event.second, event.first, handler);
+    }
+}
+
+Engine::NavigationGrid &Engine::Scene::createNavigation(sf::Vector2f origin, sf::Vector2i size, float cellSize)
+{
+    m_pathRequests.clear();
+    m_navigation = std::make_unique<NavigationGrid>(origin, size, cellSize);
+    return *m_navigation;
+}
+
+void Engine::Scene::addNavigationObstacles(ObjectType const *type)
+{
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
+    {
+        if (GameObject *obj = m_objects.getAt(i); obj != nullptr && obj->getType() == type)
+        {
+            m_navigation->setAreaBlocked(obj->getBounds(), true);
+        }
+    }
+}
+
+void Engine::Scene::requestPath(GameObject const *obj, sf::Vector2f from, sf::Vector2f to)
+{
+    m_pathRequests.push_back(PathRequest{m_navigation->requestPath(from, to, PathAlgorithm::JumpPoint), obj->getHandle()});
+}
+
+void Engine::Scene::dispatchFinishedPaths()
+{
+    if (m_navigation == nullptr || m_pathRequests.empty())
+    {
+        return;
+    }
+    for (FinishedPath const &path : m_navigation->takeFinishedPaths())
+    {
+        // results come in the order of requests, so the matching request is always the oldest one
+        auto it = std::find_if(m_pathRequests.begin(), m_pathRequests.end(), [&path](PathRequest const &request)
+                               { return request.id == path.request; });
+        if (it == m_pathRequests.end())
+        {
+            continue;
+        }
+        ObjectHandle handle = it->object;
+        m_pathRequests.erase(it);
+        GameObject *obj = getObject(handle);
+        if (obj == nullptr || obj->isDestroyed() || !obj->getType()->hasMethod("on_path_found"))
+        {
+            continue;
+        }
+        std::vector<Value> points;
+        for (sf::Vector2f const &point : path.points.value_or(std::vector<sf::Vector2f>()))
+        {
+            points.push_back(point);
+        }
+        obj->wake();
+        pushToStack(createTemporaryArray(points));
+        runMethod(obj, "on_path_found");
+    }
+}
+
+void Engine::Scene::dispatchTimers(float delta)
+{
+    m_timers.advance(delta, m_expiredTimers);
+    for (TimerWheel::TimerId id : m_expiredTimers)
+    {
+        // earlier callbacks in the same batch can cancel timers that already expired
+        std::optional<TimerTarget> target = m_timers.fire(id);
+        if (!target.has_value())
+        {
+            continue;
+        }
+        GameObject *obj = getObject(target->object);
+        if (obj == nullptr || obj->isDestroyed() || !obj->getType()->hasMethod(target->method))
+        {
+            // object that is gone can never receive calls of a repeating timer
+            m_timers.cancel(id);
+            continue;
+        }
+        obj->wake();
+        runMethod(obj, target->method);
+    }
+}
+
+void Engine::Scene::updateTweens(float delta)
+{
+    if (m_tweens.getCount() == 0)
+    {
+        return;
+    }
+    m_tweens.advance(delta);
+    for (size_t i = 0; i < m_tweens.getCount(); i++)
+    {
+        TweenTarget const &target = m_tweens.getTarget(i);
+        GameObject *obj = getObject(target.object);
+        if (obj == nullptr || obj->isDestroyed())
+        {
+            m_tweens.discard(i);
+            continue;
+        }
+        sf::Vector2f value = m_tweens.getValue(i);
+        switch (target.property)
+        {
+        case TweenProperty::Position:
+            obj->setPosition(value);
+            break;
+        case TweenProperty::Size:
+            obj->setSize(value);
+            break;
+        case TweenProperty::FloatField:
+            obj->setFieldValue(m_tweens.getFieldName(target.field), (FloatType)value.x);
+            break;
+        case TweenProperty::IntField:
+            obj->setFieldValue(m_tweens.getFieldName(target.field), (IntType)std::lround(value.x));
+            break;
+        case TweenProperty::FontSize:
+            // curves that overshoot can go below zero for a moment
+            static_cast<TextObject *>(obj)->setFontSize(std::max<IntType>(std::lround(value.x), 0));
+            break;
+        }
+    }
+    m_tweens.removeFinished(m_finishedTweens);
+    for (FinishedTween const &tween : m_finishedTweens)
+    {
+        GameObject *obj = getObject(tween.object);
+        if (obj == nullptr || obj->isDestroyed() || !obj->getType()->hasMethod("on_tween_finished"))
+        {
+            continue;
+        }
+        obj->wake();
+        pushToStack((IntType)tween.id);
+        runMethod(obj, "on_tween_finished");
+    }
+}
+
+void Engine::Scene::collectContactEvents()
+{
+    for (ContactEvent const &event : m_physics->takeContactEvents())
+    {
+        m_contactEvents.push_back(ObjectContactEvent{m_physicsLinks[event.first]->object, m_physicsLinks[event.second]->object, event.began});
+    }
+}
+
+void Engine::Scene::updateCollisions()
+{
+    std::vector<Contact> contacts;
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
+    {
+        GameObject *obj = m_objects.getAt(i);
+        // pairs are only generated from objects that can react to them, the other object of the pair is found by the query
+        if (obj == nullptr || !obj->getType()->hasCollisionHandlers() || obj->getType()->getCollisionMask() == 0)
+        {
+            continue;
+        }
+        m_spatialGrid.query(obj->getBounds(), m_spatialQueryResult, obj->getType()->getCollisionMask());
+        for (uint32_t id : m_spatialQueryResult)
+        {
+            GameObject *other = m_objects.getAt(id);
+            if (other == nullptr || other == obj || !obj->getType()->canCollideWith(other->getType()))
+            {
+                continue;
+            }
+            contacts.push_back(i < id ? Contact{obj->getHandle(), other->getHandle()} : Contact{other->getHandle(), obj->getHandle()});
+        }
+    }
+    // pair where both objects listen to collisions is found twice
+    std::sort(contacts.begin(), contacts.end());
+    contacts.erase(std::unique(contacts.begin(), contacts.end()), contacts.end());
+
+    std::vector<Contact> started;
+    std::vector<Contact> ended;
+    std::set_difference(contacts.begin(), contacts.end(), m_contacts.begin(), m_contacts.end(), std::back_inserter(started));
+    std::set_difference(m_contacts.begin(), m_contacts.end(), contacts.begin(), contacts.end(), std::back_inserter(ended));
+    // contacts are stored before running handlers since handlers can move or destroy objects, which is only noticed on the next update
+    m_contacts = std::move(contacts);
+    for (Contact const &contact : ended)
+    {
+        runCollisionHandler(contact.first, contact.second, "on_collision_exit");
+        runCollisionHandler(contact.second, contact.first, "on_collision_exit");
+    }
+    for (Contact const &contact : started)
+    {
+        runCollisionHandler(contact.first, contact.second, "on_collision_enter");
+        runCollisionHandler(contact.second, contact.first, "on_collision_enter");
+    }
+}
+
+void Engine::Scene::runCollisionHandler(ObjectHandle self, ObjectHandle other, std::string const &handler)
+{
+    GameObject *obj = getObject(self);
+    if (obj == nullptr || obj->isDestroyed() || !obj->getType()->hasMethod(handler))
+    {
+        return;
+    }
+    // collisions wake sleeping objects the same way events do
+    obj->wake();
+    pushToStack(other);
+    runMethod(obj, handler);
+}
+
+bool Engine::Scene::isOverMemoryBudget() const
+{
+    if (m_memoryBudget == 0)
+    {
+        return false;
+    }
+    // objects record their own growth, so live bytes are current without measuring the heap
+    return m_garbageCollector.getStatistics().liveBytes > m_memoryBudget;
+}
+
+Engine::MemoryReport Engine::Scene::getMemoryReport()
+{
+    m_garbageCollector.updateAccountedSizes();
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
+    {
+        GameObject *obj = m_objects.getAt(i);
+        if (obj == nullptr)
+        {
+            continue;
+        }
+        size_t size = obj->getAllocatedSize();
+        m_objectUsage.resize(obj->getAccountedSize(), size);
+        m_objectUsageByType[obj->getType()->getName()].resize(obj->getAccountedSize(), size);
+        obj->setAccountedSize(size);
+    }
+
+    MemoryReport report;
+    report.managed = m_garbageCollector.getUsage();
+    for (size_t i = 0; i < report.managedByKind.size(); i++)
+    {
+        report.managedByKind[i] = m_garbageCollector.getUsage((MemoryObjectKind)i);
+    }
+    report.temporary = m_garbageCollector.getTemporaryUsage();
+    report.gameObjects = m_objectUsage;
+    report.gameObjectsByType = m_objectUsageByType;
+    report.content = ContentManager::getInstance().getMemoryUsage();
+    report.budget = m_memoryBudget;
+    report.collector = m_garbageCollector.getStatistics();
+    report.collectionBudget = m_garbageCollector.getAllocationBudget();
+    report.collectionSliceSize = m_garbageCollector.getSliceSize();
+    report.traceInterval = m_garbageCollector.getTraceInterval();
+    return report;
+}
+
+Engine::Value Engine::Scene::getGlobalVariable(std::string const &name) const
+{
+    if (m_globals.contains(name))
+    {
+        return m_globals.at(name);
+    }
+    throw Errors::RuntimeMemoryError("Unable to find scene variable named '" + name + "'");
+    return 0;
+}
+
+void Engine::Scene::setGlobalVariable(std::string const &name, Value const &value)
+{
+    Value v = getPersistentValue(value);
+    increaseValueRefCount(v);
+    if (m_globals.contains(name))
+    {
+        decreaseValueRefCount(m_globals[name]);
+    }
+    m_globals[name] = v;
+}
+
+void Engine::Scene::changeScene(std::string const &targetScene)
+{
+    m_nextScene = targetScene;
+    endScene();
+}
+
+void Engine::Scene::endScene()
+{
+    m_quitting = true;
+}
+
+void Engine::Scene::collectGarbage()
+{
+    // moved values are not roots, so their references have to be settled before anything can be freed
+    releaseMovedReferences();
+    if (!m_garbageCollector.isCollectionNeeded())
+    {
+        return;
+    }
+    // values on the operation stacks don't count as references so they have to be protected manually
+    for (std::pmr::vector<Value> const &frame : m_operationStack)
+    {
+        for (Value const &v : frame)
+        {
+            m_garbageCollector.markRoot(v);
+        }
+    }
+    // same goes for variables if their references are deferred, this is where their counts are reconciled
+    if (m_deferVariableReferences)
+    {
+        for (std::pmr::vector<Value> const &frame : m_variables)
+        {
+            for (Value const &v : frame)
+            {
+                m_garbageCollector.markRoot(v);
+            }
+        }
+    }
+    m_garbageCollector.collect();
+}
+
+size_t Engine::Scene::collectCycles()
+{
+    releaseMovedReferences();
+    for (std::pmr::vector<Value> const &frame : m_operationStack)
+    {
+        for (Value const &v : frame)
+        {
+            m_garbageCollector.markReachable(v);
+        }
+    }
+    for (std::pmr::vector<Value> const &frame : m_variables)
+    {
+        for (Value const &v : frame)
+        {
+            m_garbageCollector.markReachable(v);
+        }
+    }
+    for (auto const &[name, v] : m_globals)
+    {
+        m_garbageCollector.markReachable(v);
+    }
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
+    {
+        if (GameObject *obj = m_objects.getAt(i); obj != nullptr)
+        {
+            for (auto const &[name, v] : obj->getFields())
+            {
+                m_garbageCollector.markReachable(v);
+            }
+        }
+    }
+    size_t freed = m_garbageCollector.sweepUnreachable();
+    // sweep goes over every object anyway, so sizes that changed through other objects are settled here without an extra pass every frame
+    m_garbageCollector.updateAccountedSizes();
+    return freed;
+}
+
+void Engine::Scene::setVariableReferencesDeferred(bool deferred)
+{
+    if (deferred == m_deferVariableReferences)
+    {
+        return;
+    }
+    // moved references are released the same way they were taken
+    releaseMovedReferences();
+    m_deferVariableReferences = deferred;
+    for (std::pmr::vector<Value> const &frame : m_variables)
+    {
+        for (Value const &v : frame)
+        {
+            if (deferred)
+            {
+                if (v.index() == ValueType::Array)
+                {
+                    std::get<ArrayObject *>(v)->addVariableReference();
+                }
+                decreaseValueRefCount(v);
+            }
+            else
+            {
+                if (v.index() == ValueType::Array)
+                {
+                    std::get<ArrayObject *>(v)->removeVariableReference();
+                }
+                increaseValueRefCount(v);
+            }
+        }
+    }
+}
+
+void Engine::Scene::visitRoots(std::function<void(std::string const &, Value const &, bool)> const &visitor) const
 {
-    if (std::vector<std::unique_ptr<GameObject>>::const_iterator it = std::find_if(m_objects.begin(), m_objects.end(), [name](std::unique_ptr<GameObject> const &o)
-                                                                                   { return o->getName() == name; });
-        it != m_objects.end())
+    // operation stacks and deferred variables don't touch reference counters, everything else does
+    for (size_t frame = 0; frame < m_operationStack.size(); frame++)
     {
-        return it->get();
+        for (size_t i = 0; i < m_operationStack[frame].size(); i++)
+        {
+            visitor("stack " + std::to_string(frame) + ":" + std::to_string(i), m_operationStack[frame][i], false);
+        }
     }
-
-    return nullptr;
-}
-
-Engine::Value Engine::Scene::getGlobalVariable(std::string const &name) const
-{
-    if (m_globals.contains(name))
+    for (size_t frame = 0; frame < m_variables.size(); frame++)
     {
-        return m_globals.at(name);
+        for (size_t i = 0; i < m_variables[frame].size(); i++)
+        {
+            visitor("local " + std::to_string(frame) + ":" + std::to_string(i), m_variables[frame][i], !m_deferVariableReferences);
+        }
     }
-    throw Errors::RuntimeMemoryError("Unable to find scene variable named '" + name + "'");
-    return 0;
-}
-
-void Engine::Scene::setGlobalVariable(std::string const &name, Value const &v)
-{
-    if (m_globals.contains(name))
+    for (size_t i = 0; i < m_movedReferenceCount; i++)
     {
-        decreaseValueRefCount(v);
+        visitor("moved " + std::to_string(i), m_movedReferences[i], !m_deferVariableReferences);
     }
-    m_globals[name] = v;
-    increaseValueRefCount(v);
-}
-
-void Engine::Scene::changeScene(std::string const &targetScene)
-{
-    m_nextScene = targetScene;
-    endScene();
-}
-
-void Engine::Scene::endScene()
-{
-    m_quitting = true;
-}
-
-void Engine::Scene::collectGarbage()
-{
-    for (int64_t i = m_memory.size() - 1; i >= 0; i--)
+    for (auto const &[name, v] : m_globals)
+    {
+        visitor("global " + name, v, true);
+    }
+    for (size_t i = 0; i < m_objects.getSlotCount(); i++)
     {
-        if (m_memory[i]->isDead())
+        if (GameObject *obj = m_objects.getAt(i); obj != nullptr)
         {
-            m_memory.erase(m_memory.begin() + i);
+            for (auto const &[name, v] : obj->getFields())
+            {
+                visitor("object " + obj->getName() + "." + name, v, true);
+            }
         }
     }
 }
@@ -331,20 +1309,71 @@ void Engine::Scene::runFunctionByName(std::string const &name)
     }
 }
 
+/// @brief Compare two values of the same type for `eq` and `neq`. Strings and arrays are copied on assignment, so they are compared by contents,
+/// arrays being equal when they have the same length and every pair of items is equal. Other managed values are compared by identity
+/// @return Result of the comparison or nothing if values of this type can't be compared
+static std::optional<bool> areValuesEqual(Engine::Value const &a, Engine::Value const &b)
+{
+    switch (a.index())
+    {
+    case Engine::ValueType::Nil:
+        return true;
+    case Engine::ValueType::Bool:
+        return std::get<bool>(a) == std::get<bool>(b);
+    case Engine::ValueType::Integer:
+        return std::get<Engine::IntType>(a) == std::get<Engine::IntType>(b);
+    case Engine::ValueType::Float:
+        return std::get<Engine::FloatType>(a) == std::get<Engine::FloatType>(b);
+    case Engine::ValueType::Vector:
+        return std::get<Engine::VectorType>(a) == std::get<Engine::VectorType>(b);
+    case Engine::ValueType::Object:
+        return std::get<Engine::ObjectHandle>(a) == std::get<Engine::ObjectHandle>(b);
+    case Engine::ValueType::String:
+        return std::get<Engine::StringObject *>(a)->equals(std::get<Engine::StringObject *>(b));
+    case Engine::ValueType::Array:
+    {
+        // items are compared even for arrays sharing a buffer, so the result never depends on whether a copy was made yet
+        std::span<Engine::Value const> first = std::get<Engine::ArrayObject *>(a)->getItems();
+        std::span<Engine::Value const> second = std::get<Engine::ArrayObject *>(b)->getItems();
+        if (first.size() != second.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < first.size(); i++)
+        {
+            if (first[i].index() != second[i].index())
+            {
+                return false;
+            }
+            // items can't be arrays containing the array itself, since storing an array always stores a copy
+            if (std::optional<bool> equal = areValuesEqual(first[i], second[i]); !equal.value_or(false))
+            {
+                return equal;
+            }
+        }
+        return true;
+    }
+    case Engine::ValueType::TypedArray:
+        return std::get<Engine::TypedArrayObject *>(a) == std::get<Engine::TypedArrayObject *>(b);
+    case Engine::ValueType::Map:
+        return std::get<Engine::MapObject *>(a) == std::get<Engine::MapObject *>(b);
+    case Engine::ValueType::Struct:
+        return std::get<Engine::StructObject *>(a) == std::get<Engine::StructObject *>(b);
+    }
+    return {};
+}
+
 void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::optional<Runnable::RunnableFunctionDebugInfo> const &debugInfo)
 {
     size_t pos = 0;
     createVariableBlock();
-    for (size_t i = 0; i < func.argumentCount; i++)
-    {
-        // approach copied from goblang because it worked
-        // does mean that these could be overriden during execution
-        // but i am fine with it because c lets you do it and it works fine
-        setVariableValue(i, popFromStackOrError());
-    }
+    // approach copied from goblang because it worked
+    // does mean that these could be overriden during execution
+    // but i am fine with it because c lets you do it and it works fine
+    moveArgumentsToVariables(func.argumentCount);
     try
     {
-        m_operationStack.push_back({});
+        m_operationStack.emplace_back();
         bool returning = false;
         while (pos < func.bytes.size() && !returning && !m_quitting)
         {
@@ -361,32 +1390,33 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
             {
                 size_t typeId = parseOperationConstant<int64_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
                 pos += sizeof(size_t);
-                StringObject *a = createString(getConstantStringById(typeId));
-                m_operationStack.back().push_back(a);
+                // constant strings are shared, so pushing a literal never allocates
+                m_operationStack.back().push_back(getConstantStringObjectById(typeId));
             }
             break;
             case Instructions::CreateInstance:
             {
-                std::string const &name = popFromStackAsType<StringObject *>("Expected string for object name")->getString();
+                std::string name(popFromStackAsType<StringObject *>("Expected string for object name")->getString());
                 size_t typeId = parseOperationConstant<int64_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
                 pos += sizeof(size_t);
                 GameObject *inst = createObject<GameObject>(TypeManager::getInstance().getType(getConstantStringById(typeId)), name);
-                if (m_objects.back()->getType()->hasMethod("init"))
+                ObjectHandle handle = inst->getHandle();
+                if (inst->getType()->hasMethod("init"))
                 {
-                    pushToStack(inst);
-                    runMethod(m_objects.back().get(), "init");
-                    // runFunction(m_objects.back()->getType()->getMethod("init"), Runnable::RunnableFunctionDebugInfo(typeId, "init"));
+                    // `init` only receives self pushed by runMethod. Instance is no longer pushed a second time before the call,
+                    // which used to leave an extra handle on the stack of the caller when `init` only took self
+                    runMethod(inst, "init");
                 }
 
-                pushToStack(inst);
+                pushToStack(handle);
             }
             break;
             case Instructions::GetInstanceByName:
             {
-                std::string const &name = popFromStackAsType<StringObject *>("Expected string for object name")->getString();
+                std::string name(popFromStackAsType<StringObject *>("Expected string for object name")->getString());
                 if (GameObject *obj = getObjectByName(name); obj != nullptr)
                 {
-                    pushToStack(obj);
+                    pushToStack(obj->getHandle());
                 }
                 else
                 {
@@ -447,6 +1477,20 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 }
             }
             break;
+            case Instructions::MoveLocal:
+            {
+                size_t id = parseOperationConstant<size_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
+                pos += sizeof(size_t);
+                if (std::optional<Value> var = takeVariableValue(id); var.has_value())
+                {
+                    pushToStack(var.value());
+                }
+                else
+                {
+                    error(debugInfo, pos, "No variable with id '" + std::to_string(id) + "'is present in current context");
+                }
+            }
+            break;
             case Instructions::Add:
             {
                 Value a = popFromStackOrError();
@@ -570,6 +1614,57 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 pushToStack(obj->getPosition());
             }
             break;
+            case Instructions::SetVelocity:
+            {
+                sf::Vector2f velocity = popFromStackAsType<sf::Vector2f>("Expected vector for velocity on stack");
+                GameObject *obj = popFromStackAsType<GameObject *>("Expected object on stack");
+                // objects with physics bodies are moved by the simulation instead
+                if (std::optional<uint32_t> body = getObjectBody(obj); body.has_value())
+                {
+                    m_physics->setVelocity(body.value(), velocity);
+                }
+                else
+                {
+                    m_kinematics.setVelocity(obj->getHandle().index, velocity);
+                }
+            }
+            break;
+            case Instructions::GetVelocity:
+            {
+                GameObject *obj = popFromStackAsType<GameObject *>("Expected object on stack");
+                if (std::optional<uint32_t> body = getObjectBody(obj); body.has_value())
+                {
+                    pushToStack(m_physics->getVelocity(body.value()));
+                }
+                else
+                {
+                    pushToStack(m_kinematics.getVelocity(obj->getHandle().index));
+                }
+            }
+            break;
+            case Instructions::SetAcceleration:
+            {
+                sf::Vector2f acceleration = popFromStackAsType<sf::Vector2f>("Expected vector for acceleration on stack");
+                m_kinematics.setAcceleration(popFromStackAsType<GameObject *>("Expected object on stack")->getHandle().index, acceleration);
+            }
+            break;
+            case Instructions::GetAcceleration:
+                pushToStack(m_kinematics.getAcceleration(popFromStackAsType<GameObject *>("Expected object on stack")->getHandle().index));
+                break;
+            case Instructions::SetDrag:
+            {
+                Value drag = popFromStackOrError();
+                if (drag.index() != ValueType::Float && drag.index() != ValueType::Integer)
+                {
+                    error(debugInfo, pos, "Expected number for drag on stack");
+                }
+                GameObject *obj = popFromStackAsType<GameObject *>("Expected object on stack");
+                m_kinematics.setDrag(obj->getHandle().index, drag.index() == ValueType::Float ? (float)std::get<FloatType>(drag) : (float)std::get<IntType>(drag));
+            }
+            break;
+            case Instructions::GetDrag:
+                pushToStack((FloatType)m_kinematics.getDrag(popFromStackAsType<GameObject *>("Expected object on stack")->getHandle().index));
+                break;
             case Instructions::MakeVector:
             {
                 Value y = popFromStackAsType<double>("Expected float on stack for y");
@@ -586,7 +1681,7 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 break;
             case Instructions::Print:
             {
-                std::cout << valueToString(popFromStackOrError()) << '\n';
+                std::cout << valueToString(popFromStackOrError(), *this) << '\n';
             }
             break;
             case Instructions::JumpBy:
@@ -609,65 +1704,22 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
             }
             break;
             case Instructions::Equals:
-            {
-                Value a = popFromStackOrError();
-                Value b = popFromStackOrError();
-                if (a.index() != b.index())
-                {
-                    pushToStack(false);
-                }
-                switch (a.index())
-                {
-                case ValueType::Bool:
-                    pushToStack(std::get<bool>(a) == std::get<bool>(b));
-                    break;
-                case ValueType::Integer:
-                    pushToStack(std::get<int64_t>(a) == std::get<int64_t>(b));
-                    break;
-                case ValueType::Float:
-                    pushToStack(std::get<double>(a) == std::get<double>(b));
-                    break;
-                case ValueType::Vector:
-                    pushToStack(std::get<sf::Vector2f>(a) == std::get<sf::Vector2f>(b));
-                    break;
-                case ValueType::Object:
-                    pushToStack(std::get<GameObject *>(a) == std::get<GameObject *>(b));
-                    break;
-                case ValueType::String:
-                    pushToStack(std::get<StringObject *>(a)->getString() == std::get<StringObject *>(b)->getString());
-                    break;
-                }
-            }
-            break;
             case Instructions::NotEquals:
             {
+                bool negate = (Instructions)func.bytes.at(pos) == Instructions::NotEquals;
                 Value a = popFromStackOrError();
                 Value b = popFromStackOrError();
                 if (a.index() != b.index())
                 {
-                    pushToStack(true);
+                    pushToStack(negate);
+                    break;
                 }
-                switch (a.index())
+                std::optional<bool> equal = areValuesEqual(a, b);
+                if (!equal.has_value())
                 {
-                case ValueType::Bool:
-                    pushToStack(std::get<bool>(a) != std::get<bool>(b));
-                    break;
-                case ValueType::Integer:
-                    pushToStack(std::get<int64_t>(a) != std::get<int64_t>(b));
-                    break;
-                case ValueType::Float:
-                    pushToStack(std::get<double>(a) != std::get<double>(b));
-                    break;
-                case ValueType::Vector:
-                    pushToStack(std::get<sf::Vector2f>(a) != std::get<sf::Vector2f>(b));
-                    break;
-                case ValueType::Object:
-                    pushToStack(std::get<GameObject *>(a) != std::get<GameObject *>(b));
-                    break;
-                case ValueType::String:
-                    pushToStack(std::get<StringObject *>(a)->getString() != std::get<StringObject *>(b)->getString());
-                    break;
+                    error(debugInfo, pos, std::string("Attempted to compare values of unsupported type: ") + typeToString((ValueType)a.index()));
                 }
+                pushToStack(equal.value() != negate);
             }
             break;
             case Instructions::More:
@@ -736,7 +1788,7 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 std::string const &name = getConstantStringById(id);
                 if (obj->getType()->isNativeMethod(name))
                 {
-                    pushToStack(obj);
+                    pushToStack(obj->getHandle());
                     obj->getType()->callNativeMethod(name, *this);
                 }
                 else if (obj->getType()->hasMethod(name))
@@ -801,10 +1853,9 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 // otherwise it's one of the root functions and we can discard the value
                 if (m_operationStack.size() > 1)
                 {
-                    Value res = popFromStackOrError();
-                    increaseValueRefCount(res);
                     // "returning" is simply letting the value live outside of the original call stack
-                    (m_operationStack.rbegin() + 1)->push_back(res);
+                    // stacks are scanned by the garbage collector so the value stays alive without touching the reference counter
+                    (m_operationStack.rbegin() + 1)->push_back(popFromStackOrError());
                 }
                 returning = true;
                 break;
@@ -812,6 +1863,20 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
             case Instructions::GetField:
             {
                 std::string const &fieldName = parseByteOperandToString(pos, func.bytes);
+                size_t cacheId = parseOperationConstant<size_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
+                pos += sizeof(size_t);
+                if (StructObject *obj = tryPopStruct(); obj != nullptr)
+                {
+                    if (std::optional<size_t> slot = findFieldSlot(func, cacheId, obj->getType(), fieldName); slot.has_value())
+                    {
+                        pushToStack(obj->getField(slot.value()));
+                    }
+                    else
+                    {
+                        error(debugInfo, pos, "No field named '" + fieldName + "' in struct '" + obj->getType()->getName() + "'");
+                    }
+                    break;
+                }
                 GameObject *obj = popFromStackAsType<GameObject *>("Expected game object on stack");
                 if (std::optional<Value> val = obj->getFieldValue(fieldName); val.has_value())
                 {
@@ -826,14 +1891,36 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
             case Instructions::SetField:
             {
                 std::string const &fieldName = parseByteOperandToString(pos, func.bytes);
-                Value v = popFromStackOrError();
+                size_t cacheId = parseOperationConstant<size_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
+                pos += sizeof(size_t);
+                Value v = getPersistentValue(popFromStackOrError());
+                if (StructObject *obj = tryPopStruct(); obj != nullptr)
+                {
+                    // unlike game objects structs have fixed layout, so new fields can't be added
+                    if (std::optional<size_t> slot = findFieldSlot(func, cacheId, obj->getType(), fieldName); slot.has_value())
+                    {
+                        obj->setField(slot.value(), v);
+                    }
+                    else
+                    {
+                        error(debugInfo, pos, "No field named '" + fieldName + "' in struct '" + obj->getType()->getName() + "'");
+                    }
+                    break;
+                }
                 popFromStackAsType<GameObject *>("Expected game object on stack")->setFieldValue(fieldName, v);
             }
             break;
             case Instructions::HasField:
             {
-                std::string const &fieldName = popFromStackAsType<StringObject *>("Expected field name on stack")->getString();
-                pushToStack(popFromStackAsType<GameObject *>("Expected game object on stack")->hasField(fieldName));
+                size_t cacheId = parseOperationConstant<size_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
+                pos += sizeof(size_t);
+                std::string_view fieldName = popFromStackAsType<StringObject *>("Expected field name on stack")->getString();
+                if (StructObject *obj = tryPopStruct(); obj != nullptr)
+                {
+                    pushToStack(findFieldSlot(func, cacheId, obj->getType(), fieldName).has_value());
+                    break;
+                }
+                pushToStack(popFromStackAsType<GameObject *>("Expected game object on stack")->hasField(std::string(fieldName)));
             }
             break;
             case Instructions::GetConst:
@@ -848,7 +1935,7 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 {
                     error(debugInfo, pos, "Invalid type name. No type with name '" + typeName + "' exists");
                 }
-                if (std::optional<Value> v = t->getConstant(getConstantStringById(id), *this); v.has_value())
+                if (std::optional<Value> v = t->getConstant(getConstantStringById(id)); v.has_value())
                 {
                     pushToStack(v.value());
                 }
@@ -861,9 +1948,10 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
 
             case Instructions::CreateSoundPlayer:
             {
-                std::string const &assetName = popFromStackAsType<StringObject *>("Expected audio asset name")->getString();
+                std::string assetName(popFromStackAsType<StringObject *>("Expected audio asset name")->getString());
                 pushToStack(createObject<AudioObject>(TypeManager::getInstance().getType("AudioPlayer"),
-                                                      popFromStackAsType<StringObject *>("Expected object name")->getString(), assetName));
+                                                      std::string(popFromStackAsType<StringObject *>("Expected object name")->getString()), assetName)
+                                ->getHandle());
             }
             break;
             case Instructions::PlaySound:
@@ -889,16 +1977,89 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 pushToStack(sf::FloatRect(obj->getPosition(), obj->getSize()).findIntersection(sf::FloatRect(obj2->getPosition(), obj2->getSize())).has_value());
             }
             break;
+            case Instructions::GetOverlapping:
+            {
+                GameObject *obj = popFromStackAsType<GameObject *>("Expected object on stack");
+                pushToStack(createHandleArray(getObjectsInArea(obj->getBounds(), obj)));
+            }
+            break;
+            case Instructions::GetOverlappingOfType:
+            {
+                size_t typeId = parseOperationConstant<int64_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
+                pos += sizeof(size_t);
+                ObjectType const *type = TypeManager::getInstance().getType(getConstantStringById(typeId));
+                if (type == nullptr)
+                {
+                    error(debugInfo, pos, "Invalid type name. No type with name '" + getConstantStringById(typeId) + "' exists");
+                }
+                GameObject *obj = popFromStackAsType<GameObject *>("Expected object on stack");
+                pushToStack(createHandleArray(getObjectsInArea(obj->getBounds(), obj, type)));
+            }
+            break;
+            case Instructions::QueryRect:
+            {
+                sf::Vector2f size = popFromStackAsType<sf::Vector2f>("Expected size on stack");
+                sf::Vector2f position = popFromStackAsType<sf::Vector2f>("Expected position on stack");
+                pushToStack(createHandleArray(getObjectsInArea(sf::FloatRect(position, size))));
+            }
+            break;
+            case Instructions::Raycast:
+            case Instructions::RaycastOfType:
+            {
+                ObjectType const *type = nullptr;
+                if ((Instructions)func.bytes.at(pos) == Instructions::RaycastOfType)
+                {
+                    size_t typeId = parseOperationConstant<int64_t>(func.bytes.begin() + (pos + 1), func.bytes.end());
+                    pos += sizeof(size_t);
+                    type = TypeManager::getInstance().getType(getConstantStringById(typeId));
+                    if (type == nullptr)
+                    {
+                        error(debugInfo, pos, "Invalid type name. No type with name '" + getConstantStringById(typeId) + "' exists");
+                    }
+                }
+                // passed explicitly since rays cast from inside an object would always hit it first, but some callers want exactly that
+                GameObject const *ignored = tryPopIgnoredObject();
+                Value maxDistance = popFromStackOrError();
+                if (maxDistance.index() != ValueType::Float && maxDistance.index() != ValueType::Integer)
+                {
+                    error(debugInfo, pos, "Expected number for max distance on stack");
+                }
+                sf::Vector2f direction = popFromStackAsType<sf::Vector2f>("Expected vector for direction on stack");
+                sf::Vector2f origin = popFromStackAsType<sf::Vector2f>("Expected vector for origin on stack");
+                if (direction == sf::Vector2f())
+                {
+                    error(debugInfo, pos, "Ray direction can not be zero");
+                }
+                float distance = maxDistance.index() == ValueType::Float ? (float)std::get<FloatType>(maxDistance) : (float)std::get<IntType>(maxDistance);
+                pushToStack(createRayHitArray(castRay(origin, direction.normalized(), distance, ignored, type)));
+            }
+            break;
+            case Instructions::SegmentCast:
+            {
+                GameObject const *ignored = tryPopIgnoredObject();
+                sf::Vector2f end = popFromStackAsType<sf::Vector2f>("Expected vector for segment end on stack");
+                sf::Vector2f start = popFromStackAsType<sf::Vector2f>("Expected vector for segment start on stack");
+                float length = (end - start).length();
+                // segment of zero length still hits everything at its start
+                sf::Vector2f direction = length > 0.f ? (end - start) / length : sf::Vector2f();
+                pushToStack(createRayHitArray(castRay(start, direction, length, ignored)));
+            }
+            break;
+            case Instructions::ObjectsAtPoint:
+            {
+                pushToStack(createHandleArray(getObjectsAtPoint(popFromStackAsType<sf::Vector2f>("Expected vector for point on stack"))));
+            }
+            break;
             case Instructions::CreateLabel:
             {
-                std::string const &assetName = popFromStackAsType<StringObject *>("Expected font name")->getString();
-                pushToStack(createObject<TextObject>(TypeManager::getInstance().getType("Label"), popFromStackAsType<StringObject *>("Expected object name")->getString(), assetName));
+                std::string assetName(popFromStackAsType<StringObject *>("Expected font name")->getString());
+                pushToStack(createObject<TextObject>(TypeManager::getInstance().getType("Label"), std::string(popFromStackAsType<StringObject *>("Expected object name")->getString()), assetName)->getHandle());
             }
             break;
             case Instructions::ToString:
             {
                 Value v = popFromStackOrError();
-                pushToStack(createString(valueToString(v)));
+                pushToStack(createTemporaryString(valueToString(v, *this)));
             }
             break;
             case Instructions::ToInt:
@@ -921,7 +2082,7 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 case ValueType::String:
                     try
                     {
-                        pushToStack(std::stol(std::get<StringObject *>(v)->getString()));
+                        pushToStack(std::stol(std::string(std::get<StringObject *>(v)->getString())));
                     }
                     catch (std::out_of_range const &e)
                     {
@@ -960,7 +2121,7 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 case ValueType::String:
                     try
                     {
-                        pushToStack(std::stod(std::get<StringObject *>(v)->getString()));
+                        pushToStack(std::stod(std::string(std::get<StringObject *>(v)->getString())));
                     }
                     catch (std::out_of_range const &e)
                     {
@@ -993,7 +2154,7 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
             break;
             case Instructions::ChangeScene:
             {
-                std::string const &path = popFromStackAsType<StringObject *>("Expected path string on stack")->getString();
+                std::string path(popFromStackAsType<StringObject *>("Expected path string on stack")->getString());
                 changeScene(path);
                 returning = true;
             }
@@ -1004,10 +2165,10 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 // for user to decide if any other objects should be destroyed. For example, objects stored in fields
                 if (obj->getType()->hasMethod("on_destroy"))
                 {
-                    pushToStack(obj);
+                    pushToStack(obj->getHandle());
                     obj->getType()->callNativeMethod("on_destroy", *this);
                 }
-                obj->destroy();
+                destroyObject(obj);
             }
             break;
             case Instructions::IsDestroyed:
@@ -1015,7 +2176,7 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 Value v = popFromStackOrError();
                 if (v.index() == ValueType::Object)
                 {
-                    pushToStack(std::get<GameObject *>(v)->isDestroyed());
+                    pushToStack(!isObjectAlive(std::get<ObjectHandle>(v)));
                 }
                 else
                 {
@@ -1028,12 +2189,13 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 Value v = popFromStackOrError();
                 if (v.index() == ValueType::String)
                 {
-                    pushToStack(createString(std::get<StringObject *>(v)->getString() + popFromStackAsType<StringObject *>("Expected string on stack")->getString()));
+                    pushToStack(createTemporaryString(std::get<StringObject *>(v)->getString() + popFromStackAsType<StringObject *>("Expected string on stack")->getString()));
                 }
                 else if (v.index() == ValueType::Array)
                 {
-                    ArrayObject *arr = createArray(popFromStackAsType<ArrayObject *>("Expected array on stack")->getItems());
-                    arr->appendItem(v);
+                    // new array shares items with the old one, so unless old array was already appended to this doesn't copy anything
+                    ArrayObject *arr = shareArray(popFromStackAsType<ArrayObject *>("Expected array on stack"));
+                    arr->appendItem(getArrayItemValue(arr, v));
                     pushToStack(arr);
                 }
                 else
@@ -1053,6 +2215,14 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 {
                     pushToStack((IntType)std::get<ArrayObject *>(v)->getLength());
                 }
+                else if (v.index() == ValueType::TypedArray)
+                {
+                    pushToStack((IntType)std::get<TypedArrayObject *>(v)->getLength());
+                }
+                else if (v.index() == ValueType::Map)
+                {
+                    pushToStack((IntType)std::get<MapObject *>(v)->getCount());
+                }
                 else
                 {
                     error(debugInfo, pos, "Expected array or string on stack for length operation ");
@@ -1068,12 +2238,25 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 {
                     items.push_back(popFromStackOrError());
                 }
-                pushToStack(createArray(items));
+                pushToStack(createTemporaryArray(items));
             }
             break;
             case Instructions::GetItem:
             {
                 Value v = popFromStackOrError();
+                if (v.index() == ValueType::Map)
+                {
+                    Value key = popFromStackOrError();
+                    if (std::optional<Value> item = std::get<MapObject *>(v)->get(key); item.has_value())
+                    {
+                        pushToStack(item.value());
+                    }
+                    else
+                    {
+                        error(debugInfo, pos, "No item with key '" + valueToString(key, *this) + "' in map");
+                    }
+                    break;
+                }
                 IntType index = popFromStackAsType<IntType>("Expected index on stack");
                 if (v.index() == ValueType::String)
                 {
@@ -1084,6 +2267,10 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 {
                     pushToStack(std::get<ArrayObject *>(v)->getItem(index));
                 }
+                else if (v.index() == ValueType::TypedArray)
+                {
+                    pushToStack(std::get<TypedArrayObject *>(v)->getItem(index));
+                }
                 else
                 {
                     error(debugInfo, pos, "Attempted to access item in a non-list type");
@@ -1094,20 +2281,39 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
             {
 
                 Value v = popFromStackOrError();
+                if (v.index() == ValueType::Map)
+                {
+                    Value key = popFromStackOrError();
+                    setMapItem(std::get<MapObject *>(v), key, popFromStackOrError());
+                    break;
+                }
                 IntType index = popFromStackAsType<IntType>("Expected index on stack");
                 Value item = popFromStackOrError();
                 if (v.index() == ValueType::String)
                 {
-                    if (v.index() != ValueType::Integer)
+                    StringObject *str = std::get<StringObject *>(v);
+                    if (item.index() != ValueType::Integer)
                     {
                         error(debugInfo, pos, "Only integer type can be assigned as character value in the string");
                     }
+                    if (str->isInterned())
+                    {
+                        error(debugInfo, pos, "Attempted to modify constant string");
+                    }
+                    if (index < 0 || (size_t)index >= str->getString().size())
+                    {
+                        error(debugInfo, pos, "Attempted to set character at position " + std::to_string(index) + " in string of size " + std::to_string(str->getString().size()));
+                    }
                     // TODO: Maybe add char type? Or use python approach of 1 sized string
-                    std::get<StringObject *>(v)->getString()[index] = (char)std::get<IntType>(v);
+                    str->getString()[index] = (char)std::get<IntType>(item);
                 }
                 else if (v.index() == ValueType::Array)
                 {
-                    std::get<ArrayObject *>(v)->setItem(index, item);
+                    std::get<ArrayObject *>(v)->setItem(index, getArrayItemValue(std::get<ArrayObject *>(v), item));
+                }
+                else if (v.index() == ValueType::TypedArray)
+                {
+                    std::get<TypedArrayObject *>(v)->setItem(index, item);
                 }
                 else
                 {
@@ -1115,6 +2321,80 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
                 }
             }
             break;
+            case Instructions::AppendInPlace:
+            {
+                Value v = popFromStackOrError();
+                Value target = popFromStackOrError();
+                if (target.index() == ValueType::String)
+                {
+                    StringObject *str = std::get<StringObject *>(target);
+                    if (str->isInterned())
+                    {
+                        error(debugInfo, pos, "Attempted to modify constant string");
+                    }
+                    if (v.index() == ValueType::String)
+                    {
+                        str->getString() += std::get<StringObject *>(v)->getString();
+                    }
+                    else
+                    {
+                        str->getString() += valueToString(v, *this);
+                    }
+                    str->updateAccountedSize();
+                }
+                else if (target.index() == ValueType::Array)
+                {
+                    std::get<ArrayObject *>(target)->appendItem(getArrayItemValue(std::get<ArrayObject *>(target), v));
+                }
+                else
+                {
+                    error(debugInfo, pos, "Expected array or string on stack for append operation");
+                }
+            }
+            break;
+            case Instructions::ExtendInPlace:
+            {
+                Value v = popFromStackOrError();
+                Value target = popFromStackOrError();
+                if (target.index() == ValueType::String && v.index() == ValueType::String)
+                {
+                    StringObject *str = std::get<StringObject *>(target);
+                    if (str->isInterned())
+                    {
+                        error(debugInfo, pos, "Attempted to modify constant string");
+                    }
+                    str->getString() += std::get<StringObject *>(v)->getString();
+                    str->updateAccountedSize();
+                }
+                else if (target.index() == ValueType::Array && v.index() == ValueType::Array)
+                {
+                    ArrayObject *arr = std::get<ArrayObject *>(target);
+                    // copy items first in case array is extended with itself
+                    std::vector<Value> items(std::get<ArrayObject *>(v)->getItems().begin(), std::get<ArrayObject *>(v)->getItems().end());
+                    for (Value const &item : items)
+                    {
+                        arr->appendItem(getArrayItemValue(arr, item));
+                    }
+                }
+                else
+                {
+                    error(debugInfo, pos, "Expected two arrays or two strings on stack for extend operation");
+                }
+            }
+            break;
+            case Instructions::CreateStruct:
+            {
+                std::string const &name = parseByteOperandToString(pos, func.bytes);
+                if (StructType const *type = TypeManager::getInstance().getStructType(name); type != nullptr)
+                {
+                    pushToStack(createStruct(type));
+                }
+                else
+                {
+                    error(debugInfo, pos, "No struct with name '" + name + "' exists");
+                }
+            }
+            break;
             default:
                 error(debugInfo, pos, std::string("Unknown instruction with value ") + std::to_string(func.bytes.at(pos)));
             }
@@ -1129,11 +2409,10 @@ void Engine::Scene::runFunction(Runnable::RunnableFunction const &func, std::opt
     {
         error(debugInfo, pos, e.what());
     }
-    // TODO: do garbage collection here
-
-    collectGarbage();
     m_operationStack.pop_back();
     popVariableBlock();
+    // end of the function is a safe point, nothing outside of the stacks and variables references temporary values
+    collectGarbage();
 }
 
 template <>
@@ -1143,12 +2422,15 @@ Engine::GameObject *Engine::Scene::popFromStackAsType(std::string const &errorMe
     {
         throw Errors::RuntimeMemoryError("Can not pop from stack because stack is empty");
     }
-    if (!std::holds_alternative<GameObject *>(m_operationStack.back().back()))
+    if (!std::holds_alternative<ObjectHandle>(m_operationStack.back().back()))
     {
         throw Errors::RuntimeMemoryError(errorMessage);
     }
-    GameObject *v = std::get<GameObject *>(m_operationStack.back().back());
+    GameObject *v = getObject(std::get<ObjectHandle>(m_operationStack.back().back()));
     m_operationStack.back().pop_back();
-    validateObject(v);
+    if (v == nullptr)
+    {
+        throw Errors::RuntimeMemoryError("Attempted to access destroyed object's data");
+    }
     return v;
 }
@@ -3,19 +3,45 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <tuple>
+#include <array>
 #include <SFML/Graphics.hpp>
 #include "Object/GameObject.hpp"
+#include "Object/ObjectSlotMap.hpp"
 #include <iostream>
 #include "Execution/Value.hpp"
 #include "Execution/Instructions.hpp"
 #include "../Code/CodeBuilder.hpp"
 #include "Object/MemoryObject.hpp"
+#include "Object/TypedArrayObject.hpp"
+#include "Object/MapObject.hpp"
+#include "Object/StructObject.hpp"
+#include "Memory/GarbageCollector.hpp"
+#include "Memory/InternedStringTable.hpp"
+#include "Memory/MemoryStatistics.hpp"
+#include "Memory/HeapInspector.hpp"
+#include "Physics/Kinematics.hpp"
+#include "Physics/PhysicsWorld.hpp"
+#include "Navigation/NavigationGrid.hpp"
+#include "System/TimerWheel.hpp"
+#include "Animation/TweenSystem.hpp"
 #include "Error.hpp"
 #include "Content/SceneDescriptor.hpp"
 
 namespace Engine
 {
 
+    /// @brief Game object crossed by a ray
+    struct ObjectRayHit
+    {
+        GameObject *object;
+        /// @brief Point where the ray enters bounds of the object
+        sf::Vector2f point;
+        float distance;
+    };
+
     /// @brief Scene represents a collection of objects with it's own script, which loads requires assets and types for preset object
     class Scene
     {
@@ -63,7 +89,7 @@ namespace Engine
         inline void runMethod(GameObject *instance, std::string const &methodName)
         {
             // methods should all technically expect self as first argument
-            pushToStack(instance);
+            pushToStack(instance->getHandle());
             m_executedTypes.push_back(instance->getType());
             runFunction(instance->getType()->getMethod(methodName), Runnable::RunnableFunctionDebugInfo{.typeName = instance->getType()->getName(), .functionName = methodName});
             m_executedTypes.pop_back();
@@ -93,13 +119,68 @@ namespace Engine
         /// @brief Create a new string object and store it in the memory list
         /// @param str String to create the object from
         /// @return Pointer to the managed string object
-        StringObject *createString(std::string const &str);
+        StringObject *createString(std::string_view str);
 
         /// @brief Create a new managed array instance and store it in the memory list
         /// @param values Values to populate array with
         /// @return Pointer to the managed array object
         ArrayObject *createArray(std::vector<Value> const &values);
 
+        /// @brief Create a new string in the frame storage. String is freed at the end of the frame unless it's stored somewhere that outlives the frame,
+        /// in which case a regular copy is stored instead
+        /// @param str String to create the object from
+        /// @return Pointer to the temporary string object
+        StringObject *createTemporaryString(std::string_view str);
+
+        /// @brief Create a new array in the frame storage. Array is freed at the end of the frame unless it's stored somewhere that outlives the frame,
+        /// in which case a regular copy is stored instead
+        /// @param values Values to populate array with
+        /// @return Pointer to the temporary array object
+        ArrayObject *createTemporaryArray(std::vector<Value> const &values);
+
+        /// @brief Create a temporary array of ray hits where every hit is a temporary array of object handle, point and distance
+        ArrayObject *createRayHitArray(std::vector<ObjectRayHit> const &hits);
+
+        /// @brief Create a temporary array with handles of the objects
+        ArrayObject *createHandleArray(std::span<GameObject *const> objects);
+
+        /// @brief Create a new array that shares items with the given one. Items are copied only once either of the arrays is modified.
+        /// Temporary arrays are shared using a temporary array
+        /// @param source Array to share items with
+        /// @return Pointer to the new array
+        ArrayObject *shareArray(ArrayObject const *source);
+
+        /// @brief Create a new empty map
+        MapObject *createMap();
+
+        /// @brief Create a new instance of the struct with fields set to default values
+        /// @param type Layout of the struct
+        StructObject *createStruct(StructType const *type);
+
+        /// @brief Store value in the map. String keys that can still be modified by scripts are copied so that changing the original string does not break the map
+        /// @param map Map to store value in
+        /// @param key Key of the value
+        /// @param value Value to store
+        void setMapItem(MapObject *map, Value const &key, Value const &value);
+
+        /// @brief Get version of the value that can be stored in a variable, field or array item.
+        /// Arrays that are already stored somewhere, including local variables, are replaced with a new array sharing the same items to avoid two variables referencing the same array
+        /// @param v Value to store
+        /// @return Value that should be stored
+        Value getAssignableValue(Value const &v);
+
+        /// @brief Get version of the value that can be stored in something that outlives the current frame, like global, field or map item.
+        /// Temporary values are replaced with regular copies, other values are handled same way as in `getAssignableValue`
+        /// @param v Value to store
+        /// @return Value that should be stored
+        Value getPersistentValue(Value const &v);
+
+        /// @brief Create a new typed array filled with zeros
+        /// @param type Type of the elements
+        /// @param size Amount of elements
+        /// @return Pointer to the new array
+        TypedArrayObject *createTypedArray(TypedArrayObject::ElementType type, size_t size);
+
         /// @brief Parse next `sizeof(T)` bytes into a T value using bitshifts and reinterpret cast
         /// @tparam T Type of the value to convert into
         /// @param start Where in the byte code to start from
@@ -122,6 +203,11 @@ namespace Engine
         /// @return String value
         std::string const &getConstantStringById(size_t id) const;
 
+        /// @brief Attempt to get shared string object for the string constant of currently executed code and throw memory error if no string uses given id
+        /// @param id Id of the string constant
+        /// @return Interned string object that lives as long as the code it belongs to
+        StringObject *getConstantStringObjectById(size_t id) const;
+
         /// @brief Pop value from current stack frame or throw error if no stack frame exists or stack is empty
         Value popFromStackOrError();
 
@@ -155,26 +241,52 @@ namespace Engine
         template <class T, typename... Args>
         T *createObject(ObjectType const *scriptType, std::string const &name, Args... args)
         {
-            if (std::vector<std::unique_ptr<GameObject>>::const_iterator it = std::find_if(m_objects.begin(), m_objects.end(), [name](auto &obj)
-                                                                                           { return obj->getName() == name; });
-                it != m_objects.end())
+            if (getObjectByName(name) != nullptr)
             {
                 throw Errors::RuntimeMemoryError("Tried to create object with name '" + name + "' but name is already in use");
             }
-            m_objects.push_back(std::make_unique<T>(scriptType, name, *this, args...));
-            return (T *)m_objects.back().get();
+            // everything that can fail is done before the object is inserted, so a failed creation leaves nothing behind
+            UpdatePolicy policy = getTypeUpdatePolicy(scriptType);
+            T *obj = (T *)m_objects.insert(std::make_unique<T>(scriptType, name, *this, args...));
+            registerCreatedObject(obj, policy);
+            return obj;
         }
 
-        /// @brief Set value of the variable in the current block
+        /// @brief Get object that the handle points to
+        /// @param handle Handle of the object
+        /// @return Pointer to the object or null if object was destroyed
+        GameObject *getObject(ObjectHandle handle) const { return m_objects.get(handle); }
+
+        /// @brief Check if object that handle points to is still alive
+        /// @param handle Handle of the object
+        /// @return True if object was not destroyed
+        bool isObjectAlive(ObjectHandle handle) const { return m_objects.isAlive(handle); }
+
+        /// @brief Destroy the object and invalidate all handles that point to it. Memory of the object is freed at the end of the current update
+        /// @param obj Object to destroy
+        void destroyObject(GameObject *obj);
+
+        /// @brief Set value of the variable in the current block. Values moved out of other variables take over their reference instead of being retained again
         /// @param id Id of the variable(block will be resized to fit)
-        /// @param val Value to assign
-        void setVariableValue(size_t id, Value const &val);
+        /// @param value Value to assign
+        void setVariableValue(size_t id, Value const &value);
+
+        /// @brief Pop function arguments from the stack into the first variables of the current block, which must be empty.
+        /// Unlike regular assignment nothing is released, since the new block holds no values yet, and arguments moved out of variables of the caller are not retained again
+        /// @param count Amount of arguments
+        void moveArgumentsToVariables(size_t count);
 
         /// @brief Get value of variable with given id in current block
         /// @param id Id of the variable
         /// @return Value or None if no block or variable is present
         std::optional<Value> getVariableValue(size_t id) const;
 
+        /// @brief Take value of a variable that is never read again, leaving nil in its place. Reference held by the variable is kept as a moved reference
+        /// until a variable or an argument storing the same value adopts it, or until the next safe point releases it
+        /// @param id Id of the variable
+        /// @return Value or None if no block or variable is present
+        std::optional<Value> takeVariableValue(size_t id);
+
         void createVariableBlock();
 
         void popVariableBlock();
@@ -204,8 +316,8 @@ namespace Engine
 
         /// @brief Set "global" variable by name or throw error if no variable uses that name. "Global" variable is still local to the scene
         /// @param name Name of the variable
-        /// @param v Value to set
-        void setGlobalVariable(std::string const &name, Value const &v);
+        /// @param value Value to set
+        void setGlobalVariable(std::string const &name, Value const &value);
 
         void changeScene(std::string const &targetScene);
 
@@ -215,23 +327,306 @@ namespace Engine
 
         std::optional<std::string> getNextScene() const { return m_nextScene; }
 
+        /// @brief Run a slice of garbage collection if enough memory was allocated since the last collection. Must only be called at points where no native code holds on to temporary values
         void collectGarbage();
 
+        /// @brief Find and free all memory objects that are not reachable from stacks, variables, globals or object fields.
+        /// Unlike regular collection this also frees objects that reference each other. Must only be called at points where no native code holds on to temporary values
+        /// @return Amount of freed objects
+        size_t collectCycles();
+
+        /// @brief Get memory resource that lives as long as the scene. Containers allocated from it are freed together with the scene
+        std::pmr::memory_resource *getMemoryResource() { return &m_sceneMemory; }
+
+        GarbageCollector &getGarbageCollector() { return m_garbageCollector; }
+
+        GarbageCollector const &getGarbageCollector() const { return m_garbageCollector; }
+
+        /// @brief Collect current memory usage of managed objects, game objects and loaded content.
+        /// Sizes of objects that grew since creation are recalculated, so this is not meant to be called every frame
+        /// @return Memory usage report
+        MemoryReport getMemoryReport();
+
+        /// @brief Set max amount of bytes managed objects can use. Zero disables the check.
+        /// Once usage goes over the budget a warning is printed and `on_memory_budget_exceeded` of the scene and every object is called with the used bytes and the budget
+        void setMemoryBudget(size_t bytes) { m_memoryBudget = bytes; }
+
+        size_t getMemoryBudget() const { return m_memoryBudget; }
+
+        /// @brief Pass every value that is used directly by the scene to the visitor. Used by debugging tools that need to walk the heap
+        /// @param visitor Function that receives name of the root, the value and whether the root counts towards reference counter of the value
+        void visitRoots(std::function<void(std::string const &, Value const &, bool)> const &visitor) const;
+
+        HeapInspector &getHeapInspector() { return m_heapInspector; }
+
+        /// @brief Get broadphase index containing bounds of every game object in the scene
+        SpatialGrid const &getSpatialGrid() const { return m_spatialGrid; }
+
+        /// @brief Find every game object that overlaps the area using the broadphase index
+        /// @param area Area to check, objects that only touch its edge are not included
+        /// @param ignored Object that should be left out of the result, usually the one whose bounds are used as the area
+        /// @param type If set only objects of exactly this type are included
+        /// @return Found objects in the order of their slots, only valid until the next query
+        std::span<GameObject *const> getObjectsInArea(sf::FloatRect const &area, GameObject const *ignored = nullptr, ObjectType const *type = nullptr) const;
+
+        /// @brief Find every game object whose bounds are crossed by the ray using the broadphase index
+        /// @param origin Point the ray starts from, objects containing it are hit at distance 0
+        /// @param direction Normalized direction of the ray
+        /// @param maxDistance Length of the ray
+        /// @param ignored Object that should be left out of the result, usually the one casting the ray
+        /// @param type If set only objects of exactly this type are included
+        /// @return Hits ordered from the nearest to the furthest
+        std::vector<ObjectRayHit> castRay(sf::Vector2f origin, sf::Vector2f direction, float maxDistance, GameObject const *ignored = nullptr, ObjectType const *type = nullptr) const;
+
+        /// @brief Find every game object whose bounds contain the point using the broadphase index
+        /// @return Found objects in the order of their slots, only valid until the next query
+        std::span<GameObject *const> getObjectsAtPoint(sf::Vector2f point) const;
+
+        /// @brief Get movement state of game objects, objects are identified by slot index of their handle
+        Kinematics &getKinematics() { return m_kinematics; }
+
+        /// @brief Get physics simulation of the scene, creating it if scene had no physics bodies so far
+        PhysicsWorld &getPhysics();
+
+        bool hasPhysics() const { return m_physics != nullptr; }
+
+        /// @brief Get id of the physics body of the object
+        /// @return Id of the body or nothing if object has no body
+        std::optional<uint32_t> getObjectBody(GameObject const *obj) const;
+
+        /// @brief Replace shape of the body of the object. Shape no longer follows the size of the object afterwards
+        /// @param obj Object with a physics body
+        /// @param shape New shape, positioned relative to the center of the object
+        void setObjectShape(GameObject const *obj, PhysicsShape const &shape);
+
+        /// @brief Replace navigation grid of the scene with a new one where every cell is walkable. Paths that were still being searched are dropped
+        /// @param origin World position of the top left corner of the grid
+        /// @param size Amount of cells along each axis
+        /// @param cellSize Width and height of a single cell
+        NavigationGrid &createNavigation(sf::Vector2f origin, sf::Vector2i size, float cellSize);
+
+        /// @brief Get navigation grid of the scene or nullptr if it wasn't created yet
+        NavigationGrid *getNavigation() { return m_navigation.get(); }
+
+        /// @brief Block every navigation cell covered by an object of the given type
+        void addNavigationObstacles(ObjectType const *type);
+
+        /// @brief Search for path on the worker thread, `on_path_found` of the object will be called with the path once search is finished
+        /// @param obj Object that receives the path
+        /// @param from Start of the path
+        /// @param to End of the path
+        void requestPath(GameObject const *obj, sf::Vector2f from, sf::Vector2f to);
+
+        /// @brief Get timers that call object methods after a delay
+        TimerWheel &getTimers() { return m_timers; }
+
+        /// @brief Get tweens that animate properties of objects
+        TweenSystem &getTweens() { return m_tweens; }
+
+        /// @brief Get amount of object pairs that were touching during the last collision update
+        size_t getContactCount() const { return m_contacts.size(); }
+
+        /// @brief Set area of the scene in which objects using region update mode are updated, usually the visible part of the scene.
+        /// If region is not set objects using region mode are updated every frame
+        void setUpdateRegion(std::optional<sf::FloatRect> const &region) { m_updateRegion = region; }
+
+        std::optional<sf::FloatRect> const &getUpdateRegion() const { return m_updateRegion; }
+
+        /// @brief Get update policy new objects of the given type will use
+        UpdatePolicy getTypeUpdatePolicy(ObjectType const *type) const;
+
+        /// @brief Override update policy of the type for this scene. Policy is applied both to new and existing objects of the type
+        /// @param type Type to change the policy for
+        /// @param policy New policy
+        void setTypeUpdatePolicy(ObjectType const *type, UpdatePolicy const &policy);
+
+        /// @brief Get amount of objects that ran their update during the last frame
+        size_t getUpdatedObjectCount() const { return m_updatedObjectCount; }
+
+        /// @brief Set whether local variables count towards reference counters of the values stored in them.
+        /// Deferred variables are treated as roots by the garbage collector instead, which removes reference counting from every variable assignment, argument and return.
+        /// Counters of the values currently stored in variables are reconciled when mode changes
+        /// @param deferred True if variables should not count towards reference counters
+        void setVariableReferencesDeferred(bool deferred);
+
+        bool areVariableReferencesDeferred() const { return m_deferVariableReferences; }
+
+        /// @brief Check if managed objects currently use more memory than the budget allows.
+        /// Strings, arrays and maps record their growth as it happens, so this only compares the counters
+        bool isOverMemoryBudget() const;
+
     private:
+        /// @brief Pair of objects whose bounds overlap. Handles are ordered so that the same two objects always form the same pair
+        struct Contact
+        {
+            ObjectHandle first;
+            ObjectHandle second;
+
+            bool operator==(Contact const &other) const = default;
+
+            bool operator<(Contact const &other) const
+            {
+                return std::tie(first.index, first.generation, second.index, second.generation) <
+                       std::tie(other.first.index, other.first.generation, other.second.index, other.second.generation);
+            }
+        };
+
+        /// @brief Move all objects that have velocity or acceleration and apply drag to them
+        /// @param delta Time passed since last frame
+        void integrateKinematics(float delta);
+
+        /// @brief Create physics body for the object if its type describes one
+        void createObjectBody(GameObject *obj);
+
+        /// @brief Copy changes made by scripts into the physics simulation, advance it and copy resulting positions back into the objects
+        /// @param delta Time passed since last frame
+        void stepPhysics(float delta);
+
+        /// @brief Move contact events of the physics simulation into the list of events waiting to be passed to scripts
+        void collectContactEvents();
+
+        /// @brief Pass paths found by the worker thread to `on_path_found` of objects that requested them
+        void dispatchFinishedPaths();
+
+        /// @brief Move timers forward and call methods of every timer that expired, in the order they expired
+        /// @param delta Time passed since last frame
+        void dispatchTimers(float delta);
+
+        /// @brief Advance every tween, write their values into objects and call `on_tween_finished` of objects whose tweens reached their end
+        /// @param delta Time passed since last frame
+        void updateTweens(float delta);
+
+        /// @brief Find all touching pairs of objects that listen to collisions and call `on_collision_enter` and `on_collision_exit` for pairs that started or stopped touching since the last update
+        void updateCollisions();
+
+        /// @brief Call collision handler of the object if it's still alive and defines the handler
+        /// @param self Object to call handler of
+        /// @param other Object it collided with, may already be destroyed when handling exit
+        /// @param handler Name of the handler method
+        void runCollisionHandler(ObjectHandle self, ObjectHandle other, std::string const &handler);
+
+        /// @brief Add newly created game object to memory statistics and the broadphase index and apply update policy of its type
+        /// @param policy Update policy of the type, read before the object was inserted
+        void registerCreatedObject(GameObject *obj, UpdatePolicy const &policy);
+
+        /// @brief Set update policy of the object, putting it to sleep or waking it up depending on the policy
+        void applyUpdatePolicy(GameObject *obj, UpdatePolicy const &policy);
+
+        /// @brief Remove destroyed game object from memory statistics, the broadphase index, movement state and physics simulation
+        void unregisterDestroyedObject(GameObject *obj);
+
+        /// @brief Get version of the value that can be stored as an item of the given array.
+        /// Items of regular arrays must outlive the frame, while temporary arrays can store temporary values
+        Value getArrayItemValue(ArrayObject const *arr, Value const &v);
+
+        /// @brief Take over the moved reference to the object stored in the value if there is one
+        /// @return True if value was moved out of a variable, in which case the reference of that variable now belongs to the caller
+        bool adoptMovedReference(Value const &v);
+
+        /// @brief Release every moved reference that no store adopted. Called at safe points, since moved values are not scanned as roots
+        void releaseMovedReferences();
+
+        /// @brief Get slot of the struct field accessed by a field instruction. Slot is looked up by name only if the instruction last saw a different struct type or name
+        /// @param func Function the instruction belongs to
+        /// @param cacheId Index of the slot cache of the instruction
+        /// @return Slot index or None if struct has no such field
+        std::optional<size_t> findFieldSlot(Runnable::RunnableFunction const &func, size_t cacheId, StructType const *type, std::string_view name);
+
+        /// @brief Pop struct from the top of the stack if there is one
+        /// @return Popped struct or null if top value is not a struct, in which case stack is left unchanged
+        StructObject *tryPopStruct();
+
+        /// @brief Pop object that a ray should ignore if one was passed. Such object is an optional last argument of ray instructions
+        /// @return Object to ignore or null if top value is not an object, in which case stack is left unchanged. Destroyed objects are popped but null is returned
+        GameObject const *tryPopIgnoredObject();
+
+        /// @brief Memory for everything that lives only as long as the scene: managed objects, object fields, stacks and variables.
+        /// Declared first so that it's destroyed last, giving all memory back in a few large blocks instead of one allocation at a time
+        std::pmr::unsynchronized_pool_resource m_sceneMemory;
         std::optional<std::string> m_nextScene;
         /// @brief Operation stack for each function frame
-        std::vector<std::vector<Value>> m_operationStack = {{}};
+        std::pmr::vector<std::pmr::vector<Value>> m_operationStack = std::pmr::vector<std::pmr::vector<Value>>(1, &m_sceneMemory);
         /// @brief All the variables of the currently executed function
-        std::vector<std::vector<Value>> m_variables;
+        std::pmr::vector<std::pmr::vector<Value>> m_variables = std::pmr::vector<std::pmr::vector<Value>>(&m_sceneMemory);
         /// @brief Data for the all the objects for which methods are executed
         std::vector<ObjectType const *> m_executedTypes;
-        std::unordered_map<std::string, Value> m_globals;
-        std::vector<std::string> m_strings;
+        std::pmr::unordered_map<std::string, Value> m_globals = std::pmr::unordered_map<std::string, Value>(&m_sceneMemory);
+        /// @brief String constants of the scene code
+        InternedStringTable m_strings;
         std::unordered_map<std::string, Runnable::RunnableFunction> m_functions;
+        /// @brief Broadphase index of the game objects, declared before the objects since they keep a pointer to it
+        SpatialGrid m_spatialGrid;
+        /// @brief Reused storage for the ids found by broadphase queries
+        mutable std::vector<uint32_t> m_spatialQueryResult;
+        /// @brief Reused storage for the objects returned by area and point queries
+        mutable std::vector<GameObject *> m_objectQueryResult;
+        mutable std::vector<RayHit> m_rayHits;
         /// @brief Various game objects that have various game logic. Exists separate from other memory objects as they are controlled by player and exist "globally"
-        std::vector<std::unique_ptr<GameObject>> m_objects;
-        /// @brief List of all memory tracked objects such as strings and arrays
-        std::vector<std::unique_ptr<MemoryObject>> m_memory;
+        ObjectSlotMap m_objects;
+        /// @brief Objects that were destroyed during this frame. They are no longer reachable via handles but are kept until the end of the update in case they are still in use by native code
+        std::vector<std::unique_ptr<GameObject>> m_destroyedObjects;
+        /// @brief Owner of all memory tracked objects such as strings and arrays
+        GarbageCollector m_garbageCollector{&m_sceneMemory};
+        /// @brief Memory used by all game objects
+        MemoryUsage m_objectUsage;
+        /// @brief Memory used by game objects of each script type
+        std::map<std::string, MemoryUsage> m_objectUsageByType;
+        size_t m_memoryBudget = 0;
+        /// @brief Was the budget warning printed since the scene went over the budget
+        bool m_memoryBudgetWarned = false;
+        HeapInspector m_heapInspector{*this};
+        /// @brief Are local variables excluded from reference counting and scanned as roots at safe points instead
+        bool m_deferVariableReferences = true;
+        /// @brief Values taken out of variables by moves whose references were not adopted yet. Moves are almost always consumed by the next few instructions, so only a few are kept
+        std::array<Value, 4> m_movedReferences;
+        size_t m_movedReferenceCount = 0;
+        std::optional<sf::FloatRect> m_updateRegion;
+        /// @brief Update policies overriding the ones defined by types, by name of the type
+        std::unordered_map<std::string, UpdatePolicy> m_typeUpdatePolicies;
+        size_t m_updatedObjectCount = 0;
+        Kinematics m_kinematics;
+        /// @brief Connection between a physics body and the object it moves
+        struct PhysicsLink
+        {
+            ObjectHandle object;
+            /// @brief Position of the object as it was last written by the simulation, any other position means that a script moved the object
+            sf::Vector2f syncedPosition;
+            /// @brief Size of the object the shape was last built for
+            sf::Vector2f syncedSize;
+            /// @brief Should shape be rebuilt when object changes size
+            bool shapeFromSize;
+        };
+        /// @brief Physics simulation, only created once some object needs it
+        std::unique_ptr<PhysicsWorld> m_physics;
+        /// @brief Link of every physics body by body id
+        std::vector<std::optional<PhysicsLink>> m_physicsLinks;
+        /// @brief Body id of every object by slot index
+        std::vector<std::optional<uint32_t>> m_objectBodies;
+        struct ObjectContactEvent
+        {
+            ObjectHandle first;
+            ObjectHandle second;
+            bool began;
+        };
+        /// @brief Contact events waiting for their handlers to run. Bodies are replaced with handles right away since body ids are reused after destruction
+        std::vector<ObjectContactEvent> m_contactEvents;
+        /// @brief Navigation grid, only created once a script asks for it
+        std::unique_ptr<NavigationGrid> m_navigation;
+        struct PathRequest
+        {
+            uint64_t id;
+            ObjectHandle object;
+        };
+        /// @brief Background path searches that did not pass their results to objects yet, in the order they were requested
+        std::vector<PathRequest> m_pathRequests;
+        TimerWheel m_timers;
+        /// @brief Timers that expired during the current update, kept to reuse its storage
+        std::vector<TimerWheel::TimerId> m_expiredTimers;
+        TweenSystem m_tweens;
+        /// @brief Tweens that finished during the current update, kept to reuse its storage
+        std::vector<FinishedTween> m_finishedTweens;
+        /// @brief Touching pairs found during the last collision update sorted by handles
+        std::vector<Contact> m_contacts;
 
         Code::Debug::DebugInfo m_debugInfo;
 
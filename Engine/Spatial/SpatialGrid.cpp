@@ -0,0 +1,337 @@
+#include "SpatialGrid.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include "../System/Simd.hpp"
+
+/// @brief Get rectangle with the same area but without negative size, the same way sfml treats such rectangles when looking for intersections
+static sf::FloatRect normalizeRect(sf::FloatRect const &rect)
+{
+    sf::Vector2f min(std::min(rect.position.x, rect.position.x + rect.size.x), std::min(rect.position.y, rect.position.y + rect.size.y));
+    sf::Vector2f max(std::max(rect.position.x, rect.position.x + rect.size.x), std::max(rect.position.y, rect.position.y + rect.size.y));
+    return sf::FloatRect(min, max - min);
+}
+
+Engine::SpatialGrid::SpatialGrid(float cellSize) : m_cellSize(cellSize)
+{
+}
+
+int32_t Engine::SpatialGrid::getCell(float coord) const
+{
+    // clamp before converting so that huge or broken coordinates don't overflow the cell index
+    constexpr float limit = (float)(std::numeric_limits<int32_t>::max() / 2);
+    float cell = std::floor(coord / m_cellSize);
+    return std::isnan(cell) ? 0 : (int32_t)std::clamp(cell, -limit, limit);
+}
+
+Engine::SpatialGrid::CellRange Engine::SpatialGrid::getCellRange(sf::FloatRect const &bounds) const
+{
+    return CellRange{
+        .left = getCell(bounds.position.x),
+        .top = getCell(bounds.position.y),
+        .right = getCell(bounds.position.x + bounds.size.x),
+        .bottom = getCell(bounds.position.y + bounds.size.y)};
+}
+
+void Engine::SpatialGrid::link(uint32_t id, Proxy const &proxy)
+{
+    if (proxy.large)
+    {
+        m_largeBoxes.push_back(id);
+        return;
+    }
+    for (int32_t y = proxy.cells.top; y <= proxy.cells.bottom; y++)
+    {
+        for (int32_t x = proxy.cells.left; x <= proxy.cells.right; x++)
+        {
+            m_cells[getCellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void Engine::SpatialGrid::unlink(uint32_t id, Proxy const &proxy)
+{
+    auto eraseId = [id](std::vector<uint32_t> &list)
+    {
+        // order of ids in the list doesn't matter so the last id takes the place of the removed one
+        if (auto it = std::find(list.begin(), list.end(), id); it != list.end())
+        {
+            *it = list.back();
+            list.pop_back();
+        }
+    };
+    if (proxy.large)
+    {
+        eraseId(m_largeBoxes);
+        return;
+    }
+    for (int32_t y = proxy.cells.top; y <= proxy.cells.bottom; y++)
+    {
+        for (int32_t x = proxy.cells.left; x <= proxy.cells.right; x++)
+        {
+            if (auto it = m_cells.find(getCellKey(x, y)); it != m_cells.end())
+            {
+                eraseId(it->second);
+                if (it->second.empty())
+                {
+                    m_cells.erase(it);
+                }
+            }
+        }
+    }
+}
+
+void Engine::SpatialGrid::update(uint32_t id, sf::FloatRect const &rect, uint32_t layers)
+{
+    sf::FloatRect bounds = normalizeRect(rect);
+    if (id >= m_proxies.size())
+    {
+        m_proxies.resize(id + 1);
+        m_minX.resize(id + 1);
+        m_minY.resize(id + 1);
+        m_maxX.resize(id + 1);
+        m_maxY.resize(id + 1);
+        m_layers.resize(id + 1);
+        m_queryStamps.resize(id + 1, 0);
+    }
+    m_minX[id] = bounds.position.x;
+    m_minY[id] = bounds.position.y;
+    m_maxX[id] = bounds.position.x + bounds.size.x;
+    m_maxY[id] = bounds.position.y + bounds.size.y;
+    m_layers[id] = layers;
+
+    CellRange cells = getCellRange(bounds);
+    Proxy &proxy = m_proxies[id];
+    // most moves happen inside the same cells, in which case only the stored bounds have to change
+    if (proxy.active && proxy.cells == cells)
+    {
+        return;
+    }
+    if (proxy.active)
+    {
+        unlink(id, proxy);
+    }
+    else
+    {
+        m_count++;
+    }
+    proxy = Proxy{.cells = cells, .large = cells.getCellCount() > MaxCellsPerBox, .active = true};
+    link(id, proxy);
+}
+
+void Engine::SpatialGrid::remove(uint32_t id)
+{
+    if (!contains(id))
+    {
+        return;
+    }
+    unlink(id, m_proxies[id]);
+    m_proxies[id].active = false;
+    m_count--;
+}
+
+void Engine::SpatialGrid::beginQuery() const
+{
+    m_candidates.clear();
+    if (++m_currentStamp == 0)
+    {
+        std::fill(m_queryStamps.begin(), m_queryStamps.end(), 0);
+        m_currentStamp = 1;
+    }
+}
+
+void Engine::SpatialGrid::addCandidates(std::vector<uint32_t> const &ids, std::optional<uint32_t> layerMask) const
+{
+    for (uint32_t id : ids)
+    {
+        if (m_queryStamps[id] != m_currentStamp)
+        {
+            m_queryStamps[id] = m_currentStamp;
+            // boxes on other layers are dropped before the bounds test
+            if (!layerMask.has_value() || (m_layers[id] & layerMask.value()) != 0)
+            {
+                m_candidates.push_back(id);
+            }
+        }
+    }
+}
+
+void Engine::SpatialGrid::query(sf::FloatRect const &rect, std::vector<uint32_t> &result, std::optional<uint32_t> layerMask) const
+{
+    sf::FloatRect area = normalizeRect(rect);
+    result.clear();
+    if (m_count == 0)
+    {
+        return;
+    }
+    beginQuery();
+    CellRange cells = getCellRange(area);
+    if (cells.getCellCount() > m_cells.size())
+    {
+        // area covers more cells than there are occupied cells, so it's cheaper to look at every occupied cell
+        for (auto const &[key, ids] : m_cells)
+        {
+            addCandidates(ids, layerMask);
+        }
+    }
+    else
+    {
+        for (int32_t y = cells.top; y <= cells.bottom; y++)
+        {
+            for (int32_t x = cells.left; x <= cells.right; x++)
+            {
+                if (auto it = m_cells.find(getCellKey(x, y)); it != m_cells.end())
+                {
+                    addCandidates(it->second, layerMask);
+                }
+            }
+        }
+    }
+    addCandidates(m_largeBoxes, layerMask);
+
+    // candidates are packed into contiguous lists so that all of them could be tested in bulk
+    size_t count = m_candidates.size();
+    m_candidateMinX.resize(count);
+    m_candidateMinY.resize(count);
+    m_candidateMaxX.resize(count);
+    m_candidateMaxY.resize(count);
+    m_candidateResults.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t id = m_candidates[i];
+        m_candidateMinX[i] = m_minX[id];
+        m_candidateMinY[i] = m_minY[id];
+        m_candidateMaxX[i] = m_maxX[id];
+        m_candidateMaxY[i] = m_maxY[id];
+    }
+    Simd::overlapRect(m_candidateMinX.data(), m_candidateMinY.data(), m_candidateMaxX.data(), m_candidateMaxY.data(), count,
+                      area.position.x, area.position.y, area.position.x + area.size.x, area.position.y + area.size.y, m_candidateResults.data());
+    for (size_t i = 0; i < count; i++)
+    {
+        if (m_candidateResults[i])
+        {
+            result.push_back(m_candidates[i]);
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+/// @brief Find distance at which the ray enters the box using the slab method
+/// @return Distance or nothing if ray misses the box or enters it further than the max distance
+static std::optional<float> intersectRayBox(sf::Vector2f origin, sf::Vector2f direction, float maxDistance, sf::Vector2f min, sf::Vector2f max)
+{
+    float enter = 0.f;
+    float exit = maxDistance;
+    for (size_t axis = 0; axis < 2; axis++)
+    {
+        float o = axis == 0 ? origin.x : origin.y;
+        float d = axis == 0 ? direction.x : direction.y;
+        float low = axis == 0 ? min.x : min.y;
+        float high = axis == 0 ? max.x : max.y;
+        // parallel ray either always stays between the planes of this axis or never reaches them
+        if (d == 0.f)
+        {
+            if (o < low || o >= high)
+            {
+                return {};
+            }
+            continue;
+        }
+        float t1 = (low - o) / d;
+        float t2 = (high - o) / d;
+        enter = std::max(enter, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+    }
+    if (enter > exit)
+    {
+        return {};
+    }
+    return enter;
+}
+
+void Engine::SpatialGrid::raycast(sf::Vector2f origin, sf::Vector2f direction, float maxDistance, std::vector<RayHit> &result, std::optional<uint32_t> layerMask) const
+{
+    result.clear();
+    if (m_count == 0 || maxDistance < 0.f)
+    {
+        return;
+    }
+    beginQuery();
+    // cells crossed by the ray are visited in order by stepping to whichever cell border is closer
+    float cellsCrossed = (std::abs(direction.x) + std::abs(direction.y)) * maxDistance / m_cellSize + 2.f;
+    if (!(cellsCrossed <= (float)m_cells.size()))
+    {
+        // long rays are cheaper to check against every occupied cell
+        for (auto const &[key, ids] : m_cells)
+        {
+            addCandidates(ids, layerMask);
+        }
+    }
+    else
+    {
+        int32_t x = getCell(origin.x);
+        int32_t y = getCell(origin.y);
+        int32_t stepX = direction.x > 0.f ? 1 : -1;
+        int32_t stepY = direction.y > 0.f ? 1 : -1;
+        constexpr float infinity = std::numeric_limits<float>::infinity();
+        float nextX = direction.x != 0.f ? ((float)(x + (stepX > 0 ? 1 : 0)) * m_cellSize - origin.x) / direction.x : infinity;
+        float nextY = direction.y != 0.f ? ((float)(y + (stepY > 0 ? 1 : 0)) * m_cellSize - origin.y) / direction.y : infinity;
+        float deltaX = direction.x != 0.f ? m_cellSize / std::abs(direction.x) : infinity;
+        float deltaY = direction.y != 0.f ? m_cellSize / std::abs(direction.y) : infinity;
+        while (true)
+        {
+            if (auto it = m_cells.find(getCellKey(x, y)); it != m_cells.end())
+            {
+                addCandidates(it->second, layerMask);
+            }
+            if (std::min(nextX, nextY) > maxDistance)
+            {
+                break;
+            }
+            if (nextX < nextY)
+            {
+                x += stepX;
+                nextX += deltaX;
+            }
+            else
+            {
+                y += stepY;
+                nextY += deltaY;
+            }
+        }
+    }
+    addCandidates(m_largeBoxes, layerMask);
+
+    for (uint32_t id : m_candidates)
+    {
+        if (std::optional<float> distance = intersectRayBox(origin, direction, maxDistance, sf::Vector2f(m_minX[id], m_minY[id]), sf::Vector2f(m_maxX[id], m_maxY[id])))
+        {
+            result.push_back(RayHit{id, distance.value()});
+        }
+    }
+    std::sort(result.begin(), result.end(), [](RayHit const &a, RayHit const &b)
+              { return a.distance < b.distance || (a.distance == b.distance && a.id < b.id); });
+}
+
+void Engine::SpatialGrid::queryPoint(sf::Vector2f point, std::vector<uint32_t> &result) const
+{
+    result.clear();
+    if (m_count == 0)
+    {
+        return;
+    }
+    beginQuery();
+    if (auto it = m_cells.find(getCellKey(getCell(point.x), getCell(point.y))); it != m_cells.end())
+    {
+        addCandidates(it->second, {});
+    }
+    addCandidates(m_largeBoxes, {});
+    for (uint32_t id : m_candidates)
+    {
+        if (point.x >= m_minX[id] && point.x < m_maxX[id] && point.y >= m_minY[id] && point.y < m_maxY[id])
+        {
+            result.push_back(id);
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <optional>
+#include <SFML/Graphics.hpp>
+
+namespace Engine
+{
+    /// @brief Box hit by a ray
+    struct RayHit
+    {
+        uint32_t id;
+        /// @brief Distance along the ray at which it enters the box, zero if ray starts inside the box
+        float distance;
+    };
+
+    /// @brief Broadphase index that splits the space into uniform square cells and remembers which boxes touch each cell.
+    /// Lets overlap queries check only boxes that are near the queried area instead of every box in the scene.
+    /// Boxes are identified by small integer ids, such as the slot index of the object in the object storage
+    class SpatialGrid
+    {
+    public:
+        /// @brief Create empty grid
+        /// @param cellSize Width and height of a single cell. Works best when it's a bit larger than a typical box
+        explicit SpatialGrid(float cellSize = 64.f);
+
+        /// @brief Add box to the grid or move it if it's already present
+        /// @param id Id of the box
+        /// @param bounds New bounds of the box
+        /// @param layers Bit mask of the layers box belongs to, used to filter boxes during queries
+        void update(uint32_t id, sf::FloatRect const &bounds, uint32_t layers = 0xffffffff);
+
+        /// @brief Remove box from the grid. Does nothing if box is not present
+        /// @param id Id of the box
+        void remove(uint32_t id);
+
+        bool contains(uint32_t id) const { return id < m_proxies.size() && m_proxies[id].active; }
+
+        /// @brief Find every box that overlaps the area. Boxes that only touch the edge of the area are not included
+        /// @param area Area to check
+        /// @param result List that receives ids of the found boxes in ascending order. List is cleared before the search
+        /// @param layerMask If set only boxes belonging to at least one of these layers are checked
+        void query(sf::FloatRect const &area, std::vector<uint32_t> &result, std::optional<uint32_t> layerMask = {}) const;
+
+        /// @brief Find every box that the ray passes through
+        /// @param origin Start of the ray
+        /// @param direction Direction of the ray, must be normalized
+        /// @param maxDistance Length of the ray
+        /// @param result List that receives hits sorted by distance. List is cleared before the search
+        /// @param layerMask If set only boxes belonging to at least one of these layers are checked
+        void raycast(sf::Vector2f origin, sf::Vector2f direction, float maxDistance, std::vector<RayHit> &result, std::optional<uint32_t> layerMask = {}) const;
+
+        /// @brief Find every box that contains the point. Points on the left and top edges are inside the box, points on the right and bottom edges are not
+        /// @param point Point to check
+        /// @param result List that receives ids of the found boxes in ascending order. List is cleared before the search
+        void queryPoint(sf::Vector2f point, std::vector<uint32_t> &result) const;
+
+        /// @brief Get amount of boxes in the grid
+        size_t getCount() const { return m_count; }
+
+        float getCellSize() const { return m_cellSize; }
+
+    private:
+        /// @brief Inclusive range of cells covered by a box
+        struct CellRange
+        {
+            int32_t left;
+            int32_t top;
+            int32_t right;
+            int32_t bottom;
+
+            bool operator==(CellRange const &other) const = default;
+
+            size_t getCellCount() const { return (size_t)(right - left + 1) * (size_t)(bottom - top + 1); }
+        };
+
+        struct Proxy
+        {
+            CellRange cells;
+            /// @brief Box covers too many cells and is stored in the list of large boxes instead
+            bool large;
+            bool active = false;
+        };
+
+        CellRange getCellRange(sf::FloatRect const &bounds) const;
+
+        /// @brief Get index of the cell that contains the coordinate along one of the axes
+        int32_t getCell(float coord) const;
+
+        /// @brief Start new query, so that boxes seen by previous queries can be seen again
+        void beginQuery() const;
+
+        /// @brief Add boxes that were not seen by the current query yet to the list of candidates
+        void addCandidates(std::vector<uint32_t> const &ids, std::optional<uint32_t> layerMask) const;
+
+        static uint64_t getCellKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+
+        void link(uint32_t id, Proxy const &proxy);
+
+        void unlink(uint32_t id, Proxy const &proxy);
+
+        /// @brief Boxes covering more cells than this are not split between cells, since inserting them would cost more than checking them on every query
+        static constexpr size_t MaxCellsPerBox = 64;
+
+        float m_cellSize;
+        size_t m_count = 0;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+        std::vector<uint32_t> m_largeBoxes;
+        std::vector<Proxy> m_proxies;
+        // bounds are stored as separate arrays of edges so that candidates can be copied into lists that bulk tests can process
+        std::vector<float> m_minX;
+        std::vector<float> m_minY;
+        std::vector<float> m_maxX;
+        std::vector<float> m_maxY;
+        std::vector<uint32_t> m_layers;
+
+        // query state is reused between calls to avoid allocating on every query
+        /// @brief Id of the last query that has seen each box, used to skip boxes stored in multiple cells
+        mutable std::vector<uint32_t> m_queryStamps;
+        mutable uint32_t m_currentStamp = 0;
+        mutable std::vector<uint32_t> m_candidates;
+        mutable std::vector<float> m_candidateMinX;
+        mutable std::vector<float> m_candidateMinY;
+        mutable std::vector<float> m_candidateMaxX;
+        mutable std::vector<float> m_candidateMaxY;
+        mutable std::vector<uint8_t> m_candidateResults;
+    };
+}
@@ -0,0 +1,665 @@
+#include "Simd.hpp"
+#include <algorithm>
+#include <limits>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Every function processes as many elements as possible using the widest available registers
+// and then handles the remaining elements one by one
+
+void Engine::Simd::addScalar(double *data, size_t count, double value)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256d v = _mm256_set1_pd(value);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(data + i, _mm256_add_pd(_mm256_loadu_pd(data + i), v));
+    }
+#elif defined(__SSE2__)
+    __m128d v = _mm_set1_pd(value);
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(data + i, _mm_add_pd(_mm_loadu_pd(data + i), v));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        data[i] += value;
+    }
+}
+
+void Engine::Simd::mulScalar(double *data, size_t count, double value)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256d v = _mm256_set1_pd(value);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), v));
+    }
+#elif defined(__SSE2__)
+    __m128d v = _mm_set1_pd(value);
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(data + i, _mm_mul_pd(_mm_loadu_pd(data + i), v));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        data[i] *= value;
+    }
+}
+
+void Engine::Simd::add(double *destination, double const *source, size_t count)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(destination + i, _mm256_add_pd(_mm256_loadu_pd(destination + i), _mm256_loadu_pd(source + i)));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(destination + i, _mm_add_pd(_mm_loadu_pd(destination + i), _mm_loadu_pd(source + i)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[i] += source[i];
+    }
+}
+
+void Engine::Simd::mul(double *destination, double const *source, size_t count)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(destination + i, _mm256_mul_pd(_mm256_loadu_pd(destination + i), _mm256_loadu_pd(source + i)));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(destination + i, _mm_mul_pd(_mm_loadu_pd(destination + i), _mm_loadu_pd(source + i)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[i] *= source[i];
+    }
+}
+
+double Engine::Simd::sum(double const *data, size_t count)
+{
+    size_t i = 0;
+    double result = 0.0;
+#if defined(__AVX__)
+    __m256d acc = _mm256_setzero_pd();
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(data + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+    __m128d acc = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2)
+    {
+        acc = _mm_add_pd(acc, _mm_loadu_pd(data + i));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    result = lanes[0] + lanes[1];
+#endif
+    for (; i < count; i++)
+    {
+        result += data[i];
+    }
+    return result;
+}
+
+double Engine::Simd::min(double const *data, size_t count)
+{
+    size_t i = 0;
+    double result = std::numeric_limits<double>::infinity();
+#if defined(__AVX__)
+    __m256d acc = _mm256_set1_pd(result);
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm256_min_pd(acc, _mm256_loadu_pd(data + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    result = std::min({lanes[0], lanes[1], lanes[2], lanes[3]});
+#elif defined(__SSE2__)
+    __m128d acc = _mm_set1_pd(result);
+    for (; i + 2 <= count; i += 2)
+    {
+        acc = _mm_min_pd(acc, _mm_loadu_pd(data + i));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    result = std::min(lanes[0], lanes[1]);
+#endif
+    for (; i < count; i++)
+    {
+        result = std::min(result, data[i]);
+    }
+    return result;
+}
+
+double Engine::Simd::max(double const *data, size_t count)
+{
+    size_t i = 0;
+    double result = -std::numeric_limits<double>::infinity();
+#if defined(__AVX__)
+    __m256d acc = _mm256_set1_pd(result);
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm256_max_pd(acc, _mm256_loadu_pd(data + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    result = std::max({lanes[0], lanes[1], lanes[2], lanes[3]});
+#elif defined(__SSE2__)
+    __m128d acc = _mm_set1_pd(result);
+    for (; i + 2 <= count; i += 2)
+    {
+        acc = _mm_max_pd(acc, _mm_loadu_pd(data + i));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    result = std::max(lanes[0], lanes[1]);
+#endif
+    for (; i < count; i++)
+    {
+        result = std::max(result, data[i]);
+    }
+    return result;
+}
+
+double Engine::Simd::dot(double const *a, double const *b, size_t count)
+{
+    size_t i = 0;
+    double result = 0.0;
+#if defined(__AVX__)
+    __m256d acc = _mm256_setzero_pd();
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+    __m128d acc = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2)
+    {
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    result = lanes[0] + lanes[1];
+#endif
+    for (; i < count; i++)
+    {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+void Engine::Simd::clamp(double *data, size_t count, double low, double high)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256d lowV = _mm256_set1_pd(low);
+    __m256d highV = _mm256_set1_pd(high);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(data + i, _mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(data + i), lowV), highV));
+    }
+#elif defined(__SSE2__)
+    __m128d lowV = _mm_set1_pd(low);
+    __m128d highV = _mm_set1_pd(high);
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(data + i, _mm_min_pd(_mm_max_pd(_mm_loadu_pd(data + i), lowV), highV));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        data[i] = std::min(std::max(data[i], low), high);
+    }
+}
+
+void Engine::Simd::addPairs(float *data, size_t count, float x, float y)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256 v = _mm256_setr_ps(x, y, x, y, x, y, x, y);
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), v));
+    }
+#elif defined(__SSE2__)
+    __m128 v = _mm_setr_ps(x, y, x, y);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(data + i, _mm_add_ps(_mm_loadu_ps(data + i), v));
+    }
+#endif
+    for (; i + 2 <= count; i += 2)
+    {
+        data[i] += x;
+        data[i + 1] += y;
+    }
+}
+
+void Engine::Simd::mulPairs(float *data, size_t count, float x, float y)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256 v = _mm256_setr_ps(x, y, x, y, x, y, x, y);
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), v));
+    }
+#elif defined(__SSE2__)
+    __m128 v = _mm_setr_ps(x, y, x, y);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), v));
+    }
+#endif
+    for (; i + 2 <= count; i += 2)
+    {
+        data[i] *= x;
+        data[i + 1] *= y;
+    }
+}
+
+void Engine::Simd::add(float *destination, float const *source, size_t count)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(destination + i, _mm256_add_ps(_mm256_loadu_ps(destination + i), _mm256_loadu_ps(source + i)));
+    }
+#elif defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(destination + i), _mm_loadu_ps(source + i)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[i] += source[i];
+    }
+}
+
+void Engine::Simd::mul(float *destination, float const *source, size_t count)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(destination + i, _mm256_mul_ps(_mm256_loadu_ps(destination + i), _mm256_loadu_ps(source + i)));
+    }
+#elif defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_loadu_ps(destination + i), _mm_loadu_ps(source + i)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[i] *= source[i];
+    }
+}
+
+void Engine::Simd::sumPairs(float const *data, size_t count, float &x, float &y)
+{
+    size_t i = 0;
+    x = 0.f;
+    y = 0.f;
+#if defined(__AVX__)
+    __m256 acc = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8)
+    {
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(data + i));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    x = lanes[0] + lanes[2] + lanes[4] + lanes[6];
+    y = lanes[1] + lanes[3] + lanes[5] + lanes[7];
+#elif defined(__SSE2__)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    x = lanes[0] + lanes[2];
+    y = lanes[1] + lanes[3];
+#endif
+    for (; i + 2 <= count; i += 2)
+    {
+        x += data[i];
+        y += data[i + 1];
+    }
+}
+
+void Engine::Simd::minPairs(float const *data, size_t count, float &x, float &y)
+{
+    size_t i = 0;
+    x = std::numeric_limits<float>::infinity();
+    y = std::numeric_limits<float>::infinity();
+#if defined(__AVX__)
+    __m256 acc = _mm256_set1_ps(x);
+    for (; i + 8 <= count; i += 8)
+    {
+        acc = _mm256_min_ps(acc, _mm256_loadu_ps(data + i));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    x = std::min({lanes[0], lanes[2], lanes[4], lanes[6]});
+    y = std::min({lanes[1], lanes[3], lanes[5], lanes[7]});
+#elif defined(__SSE2__)
+    __m128 acc = _mm_set1_ps(x);
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm_min_ps(acc, _mm_loadu_ps(data + i));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    x = std::min(lanes[0], lanes[2]);
+    y = std::min(lanes[1], lanes[3]);
+#endif
+    for (; i + 2 <= count; i += 2)
+    {
+        x = std::min(x, data[i]);
+        y = std::min(y, data[i + 1]);
+    }
+}
+
+void Engine::Simd::maxPairs(float const *data, size_t count, float &x, float &y)
+{
+    size_t i = 0;
+    x = -std::numeric_limits<float>::infinity();
+    y = -std::numeric_limits<float>::infinity();
+#if defined(__AVX__)
+    __m256 acc = _mm256_set1_ps(x);
+    for (; i + 8 <= count; i += 8)
+    {
+        acc = _mm256_max_ps(acc, _mm256_loadu_ps(data + i));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    x = std::max({lanes[0], lanes[2], lanes[4], lanes[6]});
+    y = std::max({lanes[1], lanes[3], lanes[5], lanes[7]});
+#elif defined(__SSE2__)
+    __m128 acc = _mm_set1_ps(x);
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm_max_ps(acc, _mm_loadu_ps(data + i));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    x = std::max(lanes[0], lanes[2]);
+    y = std::max(lanes[1], lanes[3]);
+#endif
+    for (; i + 2 <= count; i += 2)
+    {
+        x = std::max(x, data[i]);
+        y = std::max(y, data[i + 1]);
+    }
+}
+
+float Engine::Simd::dot(float const *a, float const *b, size_t count)
+{
+    size_t i = 0;
+    float result = 0.f;
+#if defined(__AVX__)
+    __m256 acc = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8)
+    {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    for (float lane : lanes)
+    {
+        result += lane;
+    }
+#elif defined(__SSE2__)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < count; i++)
+    {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+void Engine::Simd::clampPairs(float *data, size_t count, float lowX, float lowY, float highX, float highY)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256 lowV = _mm256_setr_ps(lowX, lowY, lowX, lowY, lowX, lowY, lowX, lowY);
+    __m256 highV = _mm256_setr_ps(highX, highY, highX, highY, highX, highY, highX, highY);
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(data + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), lowV), highV));
+    }
+#elif defined(__SSE2__)
+    __m128 lowV = _mm_setr_ps(lowX, lowY, lowX, lowY);
+    __m128 highV = _mm_setr_ps(highX, highY, highX, highY);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(data + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(data + i), lowV), highV));
+    }
+#endif
+    for (; i + 2 <= count; i += 2)
+    {
+        data[i] = std::min(std::max(data[i], lowX), highX);
+        data[i + 1] = std::min(std::max(data[i + 1], lowY), highY);
+    }
+}
+
+void Engine::Simd::overlapRect(float const *minX, float const *minY, float const *maxX, float const *maxY, size_t count,
+                               float left, float top, float right, float bottom, uint8_t *result)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256 leftV = _mm256_set1_ps(left);
+    __m256 topV = _mm256_set1_ps(top);
+    __m256 rightV = _mm256_set1_ps(right);
+    __m256 bottomV = _mm256_set1_ps(bottom);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 x = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minX + i), rightV, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(maxX + i), leftV, _CMP_GT_OQ));
+        __m256 y = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minY + i), bottomV, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(maxY + i), topV, _CMP_GT_OQ));
+        int mask = _mm256_movemask_ps(_mm256_and_ps(x, y));
+        for (size_t j = 0; j < 8; j++)
+        {
+            result[i + j] = (mask >> j) & 1;
+        }
+    }
+#elif defined(__SSE2__)
+    __m128 leftV = _mm_set1_ps(left);
+    __m128 topV = _mm_set1_ps(top);
+    __m128 rightV = _mm_set1_ps(right);
+    __m128 bottomV = _mm_set1_ps(bottom);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minX + i), rightV), _mm_cmpgt_ps(_mm_loadu_ps(maxX + i), leftV));
+        __m128 y = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minY + i), bottomV), _mm_cmpgt_ps(_mm_loadu_ps(maxY + i), topV));
+        int mask = _mm_movemask_ps(_mm_and_ps(x, y));
+        for (size_t j = 0; j < 4; j++)
+        {
+            result[i + j] = (mask >> j) & 1;
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        result[i] = minX[i] < right && maxX[i] > left && minY[i] < bottom && maxY[i] > top;
+    }
+}
+
+void Engine::Simd::integrateMotion(float *positionX, float *positionY, float *velocityX, float *velocityY, size_t count,
+                                   float delta, float accelerationX, float accelerationY, float damping)
+{
+    size_t i = 0;
+    float stepX = accelerationX * delta;
+    float stepY = accelerationY * delta;
+#if defined(__AVX__)
+    __m256 stepXV = _mm256_set1_ps(stepX);
+    __m256 stepYV = _mm256_set1_ps(stepY);
+    __m256 dampingV = _mm256_set1_ps(damping);
+    __m256 deltaV = _mm256_set1_ps(delta);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 vx = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(velocityX + i), stepXV), dampingV);
+        __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(velocityY + i), stepYV), dampingV);
+        _mm256_storeu_ps(velocityX + i, vx);
+        _mm256_storeu_ps(velocityY + i, vy);
+        _mm256_storeu_ps(positionX + i, _mm256_add_ps(_mm256_loadu_ps(positionX + i), _mm256_mul_ps(vx, deltaV)));
+        _mm256_storeu_ps(positionY + i, _mm256_add_ps(_mm256_loadu_ps(positionY + i), _mm256_mul_ps(vy, deltaV)));
+    }
+#elif defined(__SSE2__)
+    __m128 stepXV = _mm_set1_ps(stepX);
+    __m128 stepYV = _mm_set1_ps(stepY);
+    __m128 dampingV = _mm_set1_ps(damping);
+    __m128 deltaV = _mm_set1_ps(delta);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(velocityX + i), stepXV), dampingV);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(velocityY + i), stepYV), dampingV);
+        _mm_storeu_ps(velocityX + i, vx);
+        _mm_storeu_ps(velocityY + i, vy);
+        _mm_storeu_ps(positionX + i, _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_mul_ps(vx, deltaV)));
+        _mm_storeu_ps(positionY + i, _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_mul_ps(vy, deltaV)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        velocityX[i] = (velocityX[i] + stepX) * damping;
+        velocityY[i] = (velocityY[i] + stepY) * damping;
+        positionX[i] += velocityX[i] * delta;
+        positionY[i] += velocityY[i] * delta;
+    }
+}
+
+void Engine::Simd::addScalar(float *data, size_t count, float value)
+{
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256 v = _mm256_set1_ps(value);
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), v));
+    }
+#elif defined(__SSE2__)
+    __m128 v = _mm_set1_ps(value);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(data + i, _mm_add_ps(_mm_loadu_ps(data + i), v));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        data[i] += value;
+    }
+}
+
+void Engine::Simd::addScalar(int64_t *data, size_t count, int64_t value)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i v = _mm256_set1_epi64x(value);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i *ptr = reinterpret_cast<__m256i *>(data + i);
+        _mm256_storeu_si256(ptr, _mm256_add_epi64(_mm256_loadu_si256(ptr), v));
+    }
+#elif defined(__SSE2__)
+    __m128i v = _mm_set1_epi64x(value);
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128i *ptr = reinterpret_cast<__m128i *>(data + i);
+        _mm_storeu_si128(ptr, _mm_add_epi64(_mm_loadu_si128(ptr), v));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        data[i] += value;
+    }
+}
+
+void Engine::Simd::add(int64_t *destination, int64_t const *source, size_t count)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i *dst = reinterpret_cast<__m256i *>(destination + i);
+        __m256i const *src = reinterpret_cast<__m256i const *>(source + i);
+        _mm256_storeu_si256(dst, _mm256_add_epi64(_mm256_loadu_si256(dst), _mm256_loadu_si256(src)));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128i *dst = reinterpret_cast<__m128i *>(destination + i);
+        __m128i const *src = reinterpret_cast<__m128i const *>(source + i);
+        _mm_storeu_si128(dst, _mm_add_epi64(_mm_loadu_si128(dst), _mm_loadu_si128(src)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[i] += source[i];
+    }
+}
+
+int64_t Engine::Simd::sum(int64_t const *data, size_t count)
+{
+    size_t i = 0;
+    int64_t result = 0;
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm256_add_epi64(acc, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2)
+    {
+        acc = _mm_add_epi64(acc, _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + i)));
+    }
+    alignas(16) int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+    result = lanes[0] + lanes[1];
+#endif
+    for (; i < count; i++)
+    {
+        result += data[i];
+    }
+    return result;
+}
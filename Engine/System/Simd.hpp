@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/// @brief Bulk math operations over contiguous numeric data.
+/// Uses AVX or SSE2 instructions if the compiler was allowed to use them, otherwise falls back to plain loops
+namespace Engine::Simd
+{
+    /// @brief Add value to every element
+    void addScalar(double *data, size_t count, double value);
+
+    /// @brief Multiply every element by the value
+    void mulScalar(double *data, size_t count, double value);
+
+    /// @brief Add elements of the source to the elements of the destination at the same positions
+    void add(double *destination, double const *source, size_t count);
+
+    /// @brief Multiply elements of the destination by the elements of the source at the same positions
+    void mul(double *destination, double const *source, size_t count);
+
+    double sum(double const *data, size_t count);
+
+    /// @brief Get smallest element. Data must not be empty
+    double min(double const *data, size_t count);
+
+    /// @brief Get largest element. Data must not be empty
+    double max(double const *data, size_t count);
+
+    double dot(double const *a, double const *b, size_t count);
+
+    /// @brief Limit every element to the [low, high] range
+    void clamp(double *data, size_t count, double low, double high);
+
+    /// @brief Add x to every even and y to every odd element. Used for treating array of 2d vectors as a flat array of floats
+    /// @param count Amount of floats, must be even
+    void addPairs(float *data, size_t count, float x, float y);
+
+    /// @brief Multiply every even element by x and every odd element by y
+    /// @param count Amount of floats, must be even
+    void mulPairs(float *data, size_t count, float x, float y);
+
+    void add(float *destination, float const *source, size_t count);
+
+    void mul(float *destination, float const *source, size_t count);
+
+    /// @brief Sum even and odd elements separately
+    /// @param count Amount of floats, must be even
+    void sumPairs(float const *data, size_t count, float &x, float &y);
+
+    /// @brief Get smallest even and odd elements separately. Data must not be empty
+    /// @param count Amount of floats, must be even
+    void minPairs(float const *data, size_t count, float &x, float &y);
+
+    /// @brief Get largest even and odd elements separately. Data must not be empty
+    /// @param count Amount of floats, must be even
+    void maxPairs(float const *data, size_t count, float &x, float &y);
+
+    float dot(float const *a, float const *b, size_t count);
+
+    /// @brief Limit even elements to the [lowX, highX] range and odd elements to the [lowY, highY] range
+    /// @param count Amount of floats, must be even
+    void clampPairs(float *data, size_t count, float lowX, float lowY, float highX, float highY);
+
+    /// @brief Check which boxes overlap the rectangle. Touching edges do not count as overlap. Boxes are passed as separate arrays of their edges
+    /// @param result Receives 1 for every box that overlaps the rectangle and 0 for every other box
+    void overlapRect(float const *minX, float const *minY, float const *maxX, float const *maxY, size_t count,
+                     float left, float top, float right, float bottom, uint8_t *result);
+
+    /// @brief Advance velocities and positions stored as separate arrays of components using semi-implicit Euler integration.
+    /// Every element gets the same acceleration and damping, velocity is damped after the acceleration is applied
+    /// @param damping Factor velocity is multiplied by during this step
+    void integrateMotion(float *positionX, float *positionY, float *velocityX, float *velocityY, size_t count,
+                         float delta, float accelerationX, float accelerationY, float damping);
+
+    void addScalar(float *data, size_t count, float value);
+
+    void addScalar(int64_t *data, size_t count, int64_t value);
+
+    void add(int64_t *destination, int64_t const *source, size_t count);
+
+    int64_t sum(int64_t const *data, size_t count);
+}
@@ -1,9 +1,19 @@
 #include "StandardLibrary.hpp"
 #include "../Error.hpp"
 #include <cmath>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <limits>
 #include "../Object/AudioObject.hpp"
 #include "../Object/TextObject.hpp"
+#include "../Object/ArrayObject.hpp"
+#include "../Object/TypedArrayObject.hpp"
+#include "../Object/MapObject.hpp"
+#include "../Object/TilemapObject.hpp"
+#include "../Object/ParticleEmitterObject.hpp"
 #include "Random.hpp"
+#include "../TypeManager.hpp"
 
 // TODO: Replace with better globally available system
 
@@ -64,7 +74,7 @@ void Engine::Standard::Label::setText(Scene &scene)
     if (TextObject *txt = dynamic_cast<TextObject *>(scene.popFromStackAsType<GameObject *>("Expected label on stack")); txt != nullptr)
     {
 
-        std::string const &str = scene.popFromStackAsType<StringObject *>("Expected string on stack")->getString();
+        std::string str(scene.popFromStackAsType<StringObject *>("Expected string on stack")->getString());
         txt->setText(str);
     }
     else
@@ -100,3 +110,962 @@ void Engine::Standard::Label::setFontSize(Scene &scene)
         throw Errors::RuntimeMemoryError("Expected label on stack but got wrong type");
     }
 }
+
+
+/// @brief Get builder string from the top of the stack, builders must never be shared constants
+static Engine::StringObject *popStringBuilder(Engine::Scene &scene)
+{
+    Engine::StringObject *builder = scene.popFromStackAsType<Engine::StringObject *>("Expected string builder on stack");
+    if (builder->isInterned())
+    {
+        throw Engine::Errors::RuntimeMemoryError("Constant string can not be used as string builder");
+    }
+    return builder;
+}
+
+void Engine::Standard::StringBuilder::create(Scene &scene)
+{
+    scene.pushToStack(scene.createString(""));
+}
+
+void Engine::Standard::StringBuilder::write(Scene &scene)
+{
+    StringObject *builder = popStringBuilder(scene);
+    Value v = scene.popFromStackOrError();
+    if (v.index() == ValueType::String)
+    {
+        builder->getString() += std::get<StringObject *>(v)->getString();
+    }
+    else
+    {
+        builder->getString() += valueToString(v, scene);
+    }
+    builder->updateAccountedSize();
+}
+
+void Engine::Standard::StringBuilder::clear(Scene &scene)
+{
+    popStringBuilder(scene)->getString().clear();
+}
+
+void Engine::Standard::StringBuilder::build(Scene &scene)
+{
+    scene.pushToStack(scene.createString(popStringBuilder(scene)->getString()));
+}
+
+void Engine::Standard::StringBuilder::getLength(Scene &scene)
+{
+    scene.pushToStack((IntType)popStringBuilder(scene)->getString().size());
+}
+
+void Engine::Standard::TypedArray::createInt(Scene &scene)
+{
+    IntType size = scene.popFromStackAsType<IntType>("Expected array size on stack");
+    scene.pushToStack(scene.createTypedArray(TypedArrayObject::ElementType::Int, (size_t)std::max<IntType>(size, 0)));
+}
+
+void Engine::Standard::TypedArray::createFloat(Scene &scene)
+{
+    IntType size = scene.popFromStackAsType<IntType>("Expected array size on stack");
+    scene.pushToStack(scene.createTypedArray(TypedArrayObject::ElementType::Float, (size_t)std::max<IntType>(size, 0)));
+}
+
+void Engine::Standard::TypedArray::createVector(Scene &scene)
+{
+    IntType size = scene.popFromStackAsType<IntType>("Expected array size on stack");
+    scene.pushToStack(scene.createTypedArray(TypedArrayObject::ElementType::Vector, (size_t)std::max<IntType>(size, 0)));
+}
+
+void Engine::Standard::TypedArray::fromArray(Scene &scene)
+{
+    std::span<Value const> items = scene.popFromStackAsType<ArrayObject *>("Expected array on stack")->getItems();
+    if (items.empty())
+    {
+        throw Errors::RuntimeMemoryError("Unable to pick element type for typed array from an empty array");
+    }
+    TypedArrayObject::ElementType type;
+    switch (items.front().index())
+    {
+    case ValueType::Integer:
+        type = TypedArrayObject::ElementType::Int;
+        break;
+    case ValueType::Float:
+        type = TypedArrayObject::ElementType::Float;
+        break;
+    case ValueType::Vector:
+        type = TypedArrayObject::ElementType::Vector;
+        break;
+    default:
+        throw Errors::RuntimeMemoryError(std::string("Typed arrays can not store values of type ") + typeToString((ValueType)items.front().index()));
+    }
+    TypedArrayObject *arr = scene.createTypedArray(type, items.size());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        arr->setItem(i, items[i]);
+    }
+    scene.pushToStack(arr);
+}
+
+void Engine::Standard::TypedArray::toArray(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    scene.pushToStack(scene.createArray(arr->toValues()));
+}
+
+void Engine::Standard::TypedArray::fill(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    arr->fill(scene.popFromStackOrError());
+}
+
+void Engine::Standard::TypedArray::addValue(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    arr->add(scene.popFromStackOrError());
+}
+
+void Engine::Standard::TypedArray::scale(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    arr->scale(scene.popFromStackOrError());
+}
+
+void Engine::Standard::TypedArray::addArray(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    arr->addArray(*scene.popFromStackAsType<TypedArrayObject *>("Expected typed array to add"));
+}
+
+void Engine::Standard::TypedArray::mulArray(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    arr->mulArray(*scene.popFromStackAsType<TypedArrayObject *>("Expected typed array to multiply by"));
+}
+
+void Engine::Standard::TypedArray::sum(Scene &scene)
+{
+    scene.pushToStack(scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack")->sum());
+}
+
+void Engine::Standard::TypedArray::min(Scene &scene)
+{
+    scene.pushToStack(scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack")->min());
+}
+
+void Engine::Standard::TypedArray::max(Scene &scene)
+{
+    scene.pushToStack(scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack")->max());
+}
+
+void Engine::Standard::TypedArray::dot(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    scene.pushToStack(arr->dot(*scene.popFromStackAsType<TypedArrayObject *>("Expected second typed array")));
+}
+
+void Engine::Standard::TypedArray::clamp(Scene &scene)
+{
+    TypedArrayObject *arr = scene.popFromStackAsType<TypedArrayObject *>("Expected typed array on stack");
+    Value high = scene.popFromStackOrError();
+    Value low = scene.popFromStackOrError();
+    arr->clamp(low, high);
+}
+
+void Engine::Standard::Map::create(Scene &scene)
+{
+    scene.pushToStack(scene.createMap());
+}
+
+void Engine::Standard::Map::lookup(Scene &scene)
+{
+    MapObject *map = scene.popFromStackAsType<MapObject *>("Expected map on stack");
+    scene.pushToStack(map->get(scene.popFromStackOrError()).value_or(NilValue));
+}
+
+void Engine::Standard::Map::insert(Scene &scene)
+{
+    MapObject *map = scene.popFromStackAsType<MapObject *>("Expected map on stack");
+    Value key = scene.popFromStackOrError();
+    scene.setMapItem(map, key, scene.popFromStackOrError());
+}
+
+void Engine::Standard::Map::contains(Scene &scene)
+{
+    MapObject *map = scene.popFromStackAsType<MapObject *>("Expected map on stack");
+    scene.pushToStack(map->has(scene.popFromStackOrError()));
+}
+
+void Engine::Standard::Map::remove(Scene &scene)
+{
+    MapObject *map = scene.popFromStackAsType<MapObject *>("Expected map on stack");
+    scene.pushToStack(map->remove(scene.popFromStackOrError()));
+}
+
+void Engine::Standard::Map::clear(Scene &scene)
+{
+    scene.popFromStackAsType<MapObject *>("Expected map on stack")->clear();
+}
+
+void Engine::Standard::Map::keys(Scene &scene)
+{
+    std::vector<Value> keys = scene.popFromStackAsType<MapObject *>("Expected map on stack")->getKeys();
+    for (Value &key : keys)
+    {
+        // keys owned by the map must never be modified, so scripts get their own copies
+        if (key.index() == ValueType::String && !std::get<StringObject *>(key)->isInterned())
+        {
+            key = scene.createString(std::get<StringObject *>(key)->getString());
+        }
+    }
+    scene.pushToStack(scene.createArray(keys));
+}
+
+void Engine::Standard::Map::values(Scene &scene)
+{
+    scene.pushToStack(scene.createArray(scene.popFromStackAsType<MapObject *>("Expected map on stack")->getValues()));
+}
+
+void Engine::Standard::Map::getLength(Scene &scene)
+{
+    scene.pushToStack((IntType)scene.popFromStackAsType<MapObject *>("Expected map on stack")->getCount());
+}
+void Engine::Standard::Memory::getLiveBytes(Scene &scene)
+{
+    scene.pushToStack((IntType)scene.getGarbageCollector().getUsage().bytes);
+}
+
+void Engine::Standard::Memory::getPeakBytes(Scene &scene)
+{
+    scene.pushToStack((IntType)scene.getGarbageCollector().getUsage().peakBytes);
+}
+
+void Engine::Standard::Memory::getObjectCount(Scene &scene)
+{
+    scene.pushToStack((IntType)scene.getGarbageCollector().getUsage().count);
+}
+
+static void setUsageStats(Engine::Scene &scene, Engine::MapObject *map, std::string const &name, Engine::MemoryUsage const &usage)
+{
+    scene.setMapItem(map, scene.createString(name + "_count"), (Engine::IntType)usage.count);
+    scene.setMapItem(map, scene.createString(name + "_bytes"), (Engine::IntType)usage.bytes);
+    scene.setMapItem(map, scene.createString(name + "_peak_bytes"), (Engine::IntType)usage.peakBytes);
+}
+
+void Engine::Standard::Memory::getStats(Scene &scene)
+{
+    MemoryReport report = scene.getMemoryReport();
+    MapObject *map = scene.createMap();
+    setUsageStats(scene, map, "managed", report.managed);
+    for (size_t i = 0; i < report.managedByKind.size(); i++)
+    {
+        std::string name = memoryObjectKindToString((MemoryObjectKind)i);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c)
+                       { return std::tolower(c); });
+        setUsageStats(scene, map, name, report.managedByKind[i]);
+    }
+    setUsageStats(scene, map, "temporary", report.temporary);
+    setUsageStats(scene, map, "object", report.gameObjects);
+    setUsageStats(scene, map, "texture", report.content.textures);
+    setUsageStats(scene, map, "sound", report.content.sounds);
+    setUsageStats(scene, map, "font", report.content.fonts);
+    scene.setMapItem(map, scene.createString("budget"), (IntType)report.budget);
+    scene.setMapItem(map, scene.createString("allocation_count"), (IntType)report.collector.allocationCount);
+    scene.setMapItem(map, scene.createString("allocated_bytes"), (IntType)report.collector.allocatedBytes);
+    scene.setMapItem(map, scene.createString("free_count"), (IntType)report.collector.freeCount);
+    scene.setMapItem(map, scene.createString("collection_count"), (IntType)report.collector.collectionCount);
+    scene.setMapItem(map, scene.createString("last_pause_us"), (IntType)report.collector.lastPauseMicroseconds);
+    scene.setMapItem(map, scene.createString("max_pause_us"), (IntType)report.collector.maxPauseMicroseconds);
+    scene.setMapItem(map, scene.createString("total_pause_us"), (IntType)report.collector.totalPauseMicroseconds);
+    scene.setMapItem(map, scene.createString("temporary_allocation_count"), (IntType)report.collector.temporaryAllocationCount);
+    scene.setMapItem(map, scene.createString("last_frame_temporary_count"), (IntType)report.collector.lastFrameTemporaryCount);
+    scene.setMapItem(map, scene.createString("collection_budget"), (IntType)report.collectionBudget);
+    scene.setMapItem(map, scene.createString("collection_slice_size"), (IntType)report.collectionSliceSize);
+    scene.setMapItem(map, scene.createString("trace_count"), (IntType)report.collector.traceCount);
+    scene.setMapItem(map, scene.createString("last_trace_free_count"), (IntType)report.collector.lastTraceFreeCount);
+    scene.setMapItem(map, scene.createString("trace_free_count"), (IntType)report.collector.traceFreeCount);
+    scene.setMapItem(map, scene.createString("trace_interval"), (IntType)report.traceInterval);
+    scene.pushToStack(map);
+}
+
+void Engine::Standard::Memory::setBudget(Scene &scene)
+{
+    IntType budget = scene.popFromStackAsType<IntType>("Expected int as memory budget");
+    if (budget < 0)
+    {
+        throw Errors::RuntimeMemoryError("Memory budget can not be negative");
+    }
+    scene.setMemoryBudget((size_t)budget);
+}
+
+void Engine::Standard::Memory::setCollectionBudget(Scene &scene)
+{
+    IntType budget = scene.popFromStackAsType<IntType>("Expected int as collection budget");
+    if (budget < 0)
+    {
+        throw Errors::RuntimeMemoryError("Collection budget can not be negative");
+    }
+    scene.getGarbageCollector().setAllocationBudget((size_t)budget);
+}
+
+void Engine::Standard::Memory::setCollectionSliceSize(Scene &scene)
+{
+    IntType size = scene.popFromStackAsType<IntType>("Expected int as collection slice size");
+    // collection with an empty slice would never finish
+    if (size <= 0)
+    {
+        throw Errors::RuntimeMemoryError("Collection slice size must be positive");
+    }
+    scene.getGarbageCollector().setSliceSize((size_t)size);
+}
+
+void Engine::Standard::Memory::setTraceInterval(Scene &scene)
+{
+    IntType cycles = scene.popFromStackAsType<IntType>("Expected int as trace interval");
+    if (cycles < 0)
+    {
+        throw Errors::RuntimeMemoryError("Trace interval can not be negative");
+    }
+    scene.getGarbageCollector().setTraceInterval((size_t)cycles);
+}
+
+void Engine::Standard::Memory::isOverBudget(Scene &scene)
+{
+    scene.pushToStack(scene.isOverMemoryBudget());
+}
+
+void Engine::Standard::Memory::setDeferredVariables(Scene &scene)
+{
+    scene.setVariableReferencesDeferred(scene.popFromStackAsType<bool>("Expected bool"));
+}
+
+void Engine::Standard::Memory::areVariablesDeferred(Scene &scene)
+{
+    scene.pushToStack(scene.areVariableReferencesDeferred());
+}
+
+void Engine::Standard::Memory::dump(Scene &scene)
+{
+    scene.getMemoryReport().print(std::cout);
+}
+
+static void writeJsonToFile(std::string const &path, nlohmann::json const &json)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        throw Engine::Errors::RuntimeMemoryError("Failed to open '" + path + "' for writing");
+    }
+    file << json.dump(2);
+}
+
+void Engine::Standard::Memory::writeHeapSnapshot(Scene &scene)
+{
+    std::string path(scene.popFromStackAsType<StringObject *>("Expected file path")->getString());
+    writeJsonToFile(path, scene.getHeapInspector().takeSnapshot().toJson());
+}
+
+void Engine::Standard::Memory::markHeap(Scene &scene)
+{
+    scene.getHeapInspector().markBaseline();
+}
+
+void Engine::Standard::Memory::writeHeapDiff(Scene &scene)
+{
+    std::string path(scene.popFromStackAsType<StringObject *>("Expected file path")->getString());
+    writeJsonToFile(path, scene.getHeapInspector().diffWithBaseline());
+}
+
+static Engine::GameObject *popUpdatedObject(Engine::Scene &scene)
+{
+    Engine::GameObject *obj = scene.popFromStackAsType<Engine::GameObject *>("Expected game object on stack");
+    Engine::validateObject(obj);
+    return obj;
+}
+
+static Engine::ObjectType const *popUpdatedType(Engine::Scene &scene)
+{
+    std::string name(scene.popFromStackAsType<Engine::StringObject *>("Expected type name on stack")->getString());
+    if (Engine::ObjectType const *type = Engine::TypeManager::getInstance().getType(name); type != nullptr)
+    {
+        return type;
+    }
+    throw Engine::Errors::RuntimeMemoryError("Unknown type '" + name + "'");
+}
+
+static float popNumber(Engine::Scene &scene, std::string const &errorMessage)
+{
+    Engine::Value val = scene.popFromStackOrError();
+    if (val.index() == Engine::ValueType::Float)
+    {
+        return (float)std::get<Engine::FloatType>(val);
+    }
+    if (val.index() == Engine::ValueType::Integer)
+    {
+        return (float)std::get<Engine::IntType>(val);
+    }
+    throw Engine::Errors::RuntimeMemoryError(errorMessage);
+}
+
+static Engine::UpdatePolicy createIntervalPolicy(Engine::Scene &scene)
+{
+    Engine::IntType interval = scene.popFromStackAsType<Engine::IntType>("Expected int as update interval");
+    if (interval < 1)
+    {
+        throw Engine::Errors::RuntimeMemoryError("Update interval must be at least 1");
+    }
+    return Engine::UpdatePolicy{.mode = Engine::UpdateMode::Interval, .interval = (uint32_t)interval};
+}
+
+static Engine::UpdatePolicy createRegionPolicy(Engine::Scene &scene)
+{
+    return Engine::UpdatePolicy{.mode = Engine::UpdateMode::InRegion, .margin = popNumber(scene, "Expected number as update region margin")};
+}
+
+void Engine::Standard::Updates::setAlways(Scene &scene)
+{
+    popUpdatedObject(scene)->setUpdatePolicy(UpdatePolicy{});
+}
+
+void Engine::Standard::Updates::setInterval(Scene &scene)
+{
+    GameObject *obj = popUpdatedObject(scene);
+    obj->setUpdatePolicy(createIntervalPolicy(scene));
+}
+
+void Engine::Standard::Updates::setRegionMargin(Scene &scene)
+{
+    GameObject *obj = popUpdatedObject(scene);
+    obj->setUpdatePolicy(createRegionPolicy(scene));
+}
+
+void Engine::Standard::Updates::sleep(Scene &scene)
+{
+    popUpdatedObject(scene)->sleep();
+}
+
+void Engine::Standard::Updates::sleepFor(Scene &scene)
+{
+    GameObject *obj = popUpdatedObject(scene);
+    float duration = popNumber(scene, "Expected number as sleep duration");
+    if (duration <= 0.f)
+    {
+        throw Errors::RuntimeMemoryError("Sleep duration must be positive");
+    }
+    obj->sleep(duration);
+}
+
+void Engine::Standard::Updates::wake(Scene &scene)
+{
+    popUpdatedObject(scene)->wake();
+}
+
+void Engine::Standard::Updates::isSleeping(Scene &scene)
+{
+    scene.pushToStack(popUpdatedObject(scene)->isSleeping());
+}
+
+void Engine::Standard::Updates::setRegion(Scene &scene)
+{
+    VectorType pos = scene.popFromStackAsType<VectorType>("Expected vector as region position");
+    VectorType size = scene.popFromStackAsType<VectorType>("Expected vector as region size");
+    scene.setUpdateRegion(sf::FloatRect(pos, size));
+}
+
+void Engine::Standard::Updates::clearRegion(Scene &scene)
+{
+    scene.setUpdateRegion({});
+}
+
+void Engine::Standard::Updates::setTypeAlways(Scene &scene)
+{
+    scene.setTypeUpdatePolicy(popUpdatedType(scene), UpdatePolicy{});
+}
+
+void Engine::Standard::Updates::setTypeInterval(Scene &scene)
+{
+    ObjectType const *type = popUpdatedType(scene);
+    scene.setTypeUpdatePolicy(type, createIntervalPolicy(scene));
+}
+
+void Engine::Standard::Updates::setTypeRegionMargin(Scene &scene)
+{
+    ObjectType const *type = popUpdatedType(scene);
+    scene.setTypeUpdatePolicy(type, createRegionPolicy(scene));
+}
+
+void Engine::Standard::Updates::getUpdatedCount(Scene &scene)
+{
+    scene.pushToStack((IntType)scene.getUpdatedObjectCount());
+}
+
+/// @brief Pop object and get id of its physics body, throwing error if object has none
+static uint32_t popBody(Engine::Scene &scene)
+{
+    Engine::GameObject *obj = popUpdatedObject(scene);
+    if (std::optional<uint32_t> body = scene.getObjectBody(obj); body.has_value())
+    {
+        return body.value();
+    }
+    throw Engine::Errors::RuntimeMemoryError("Object " + obj->getName() + " has no physics body, bodies are created for types with `body` constant");
+}
+
+void Engine::Standard::Physics::setGravity(Scene &scene)
+{
+    scene.getPhysics().setGravity(scene.popFromStackAsType<VectorType>("Expected vector as gravity"));
+}
+
+void Engine::Standard::Physics::getGravity(Scene &scene)
+{
+    scene.pushToStack(scene.getPhysics().getGravity());
+}
+
+void Engine::Standard::Physics::applyImpulse(Scene &scene)
+{
+    uint32_t body = popBody(scene);
+    scene.getPhysics().applyImpulse(body, scene.popFromStackAsType<VectorType>("Expected vector as impulse"));
+}
+
+void Engine::Standard::Physics::setPolygon(Scene &scene)
+{
+    GameObject *obj = popUpdatedObject(scene);
+    ArrayObject *arr = scene.popFromStackAsType<ArrayObject *>("Expected array of vertices");
+    std::vector<sf::Vector2f> vertices;
+    for (Value const &v : arr->getItems())
+    {
+        if (v.index() != ValueType::Vector)
+        {
+            throw Errors::RuntimeMemoryError("Polygon vertices must be vectors");
+        }
+        // shapes are placed relative to the center of the object
+        vertices.push_back(std::get<VectorType>(v) - obj->getSize() / 2.f);
+    }
+    std::optional<PhysicsShape> shape = PhysicsShape::createPolygon(vertices);
+    if (!shape.has_value())
+    {
+        throw Errors::RuntimeMemoryError("Polygon must be convex and have at least three vertices");
+    }
+    scene.setObjectShape(obj, shape.value());
+}
+
+void Engine::Standard::Physics::isSleeping(Scene &scene)
+{
+    uint32_t body = popBody(scene);
+    scene.pushToStack(scene.getPhysics().isSleeping(body));
+}
+
+void Engine::Standard::Physics::wake(Scene &scene)
+{
+    uint32_t body = popBody(scene);
+    scene.getPhysics().wake(body);
+}
+
+void Engine::Standard::Physics::getAwakeCount(Scene &scene)
+{
+    scene.pushToStack((IntType)(scene.hasPhysics() ? scene.getPhysics().getAwakeBodyCount() : 0));
+}
+
+void Engine::Standard::Physics::getContactCount(Scene &scene)
+{
+    scene.pushToStack((IntType)(scene.hasPhysics() ? scene.getPhysics().getContactCount() : 0));
+}
+
+/// @brief Get navigation grid of the scene, throwing error if it wasn't created
+static Engine::NavigationGrid &getNavigation(Engine::Scene &scene)
+{
+    if (Engine::NavigationGrid *navigation = scene.getNavigation(); navigation != nullptr)
+    {
+        return *navigation;
+    }
+    throw Engine::Errors::RuntimeMemoryError("Navigation grid was not created, use Navigation::create first");
+}
+
+/// @brief Convert path to array of positions, missing path becomes an empty array
+static Engine::Value createPathArray(Engine::Scene &scene, std::optional<std::vector<sf::Vector2f>> const &path)
+{
+    std::vector<Engine::Value> points;
+    for (sf::Vector2f const &point : path.value_or(std::vector<sf::Vector2f>()))
+    {
+        points.push_back(point);
+    }
+    return scene.createTemporaryArray(points);
+}
+
+void Engine::Standard::Navigation::create(Scene &scene)
+{
+    float cellSize = popNumber(scene, "Expected number as cell size");
+    VectorType size = scene.popFromStackAsType<VectorType>("Expected vector as grid size");
+    VectorType origin = scene.popFromStackAsType<VectorType>("Expected vector as grid position");
+    if (cellSize <= 0.f || size.x < 0.f || size.y < 0.f)
+    {
+        throw Errors::RuntimeMemoryError("Navigation grid must have positive cell size and non negative amount of cells");
+    }
+    scene.createNavigation(origin, sf::Vector2i((int32_t)size.x, (int32_t)size.y), cellSize);
+}
+
+void Engine::Standard::Navigation::setBlocked(Scene &scene)
+{
+    bool blocked = scene.popFromStackAsType<bool>("Expected bool");
+    NavigationGrid &navigation = getNavigation(scene);
+    navigation.setBlocked(navigation.getCell(scene.popFromStackAsType<VectorType>("Expected vector as position")), blocked);
+}
+
+void Engine::Standard::Navigation::setAreaBlocked(Scene &scene)
+{
+    bool blocked = scene.popFromStackAsType<bool>("Expected bool");
+    VectorType size = scene.popFromStackAsType<VectorType>("Expected vector as area size");
+    VectorType position = scene.popFromStackAsType<VectorType>("Expected vector as area position");
+    getNavigation(scene).setAreaBlocked(sf::FloatRect(position, size), blocked);
+}
+
+void Engine::Standard::Navigation::isBlocked(Scene &scene)
+{
+    NavigationGrid &navigation = getNavigation(scene);
+    scene.pushToStack(navigation.isBlocked(navigation.getCell(scene.popFromStackAsType<VectorType>("Expected vector as position"))));
+}
+
+void Engine::Standard::Navigation::blockType(Scene &scene)
+{
+    ObjectType const *type = popUpdatedType(scene);
+    getNavigation(scene);
+    scene.addNavigationObstacles(type);
+}
+
+void Engine::Standard::Navigation::findPath(Scene &scene)
+{
+    VectorType to = scene.popFromStackAsType<VectorType>("Expected vector as path end");
+    VectorType from = scene.popFromStackAsType<VectorType>("Expected vector as path start");
+    scene.pushToStack(createPathArray(scene, getNavigation(scene).findPath(from, to, PathAlgorithm::AStar)));
+}
+
+void Engine::Standard::Navigation::findPathJumpPoint(Scene &scene)
+{
+    VectorType to = scene.popFromStackAsType<VectorType>("Expected vector as path end");
+    VectorType from = scene.popFromStackAsType<VectorType>("Expected vector as path start");
+    scene.pushToStack(createPathArray(scene, getNavigation(scene).findPath(from, to, PathAlgorithm::JumpPoint)));
+}
+
+void Engine::Standard::Navigation::getFlowDirection(Scene &scene)
+{
+    VectorType position = scene.popFromStackAsType<VectorType>("Expected vector as position");
+    VectorType target = scene.popFromStackAsType<VectorType>("Expected vector as target");
+    scene.pushToStack(getNavigation(scene).getFlowDirection(target, position));
+}
+
+void Engine::Standard::Navigation::requestPath(Scene &scene)
+{
+    GameObject *obj = popUpdatedObject(scene);
+    VectorType to = scene.popFromStackAsType<VectorType>("Expected vector as path end");
+    VectorType from = scene.popFromStackAsType<VectorType>("Expected vector as path start");
+    getNavigation(scene);
+    scene.requestPath(obj, from, to);
+}
+
+/// @brief Get tilemap from the top of the stack
+static Engine::TilemapObject *popTilemap(Engine::Scene &scene)
+{
+    if (Engine::TilemapObject *tilemap = dynamic_cast<Engine::TilemapObject *>(popUpdatedObject(scene)); tilemap != nullptr)
+    {
+        return tilemap;
+    }
+    throw Engine::Errors::RuntimeMemoryError("Expected tilemap on stack but got wrong type");
+}
+
+static sf::Vector2i popCell(Engine::Scene &scene)
+{
+    Engine::VectorType cell = scene.popFromStackAsType<Engine::VectorType>("Expected vector as cell");
+    return sf::Vector2i((int32_t)std::floor(cell.x), (int32_t)std::floor(cell.y));
+}
+
+static Engine::TileId popTileId(Engine::Scene &scene)
+{
+    Engine::IntType tile = scene.popFromStackAsType<Engine::IntType>("Expected int as tile id");
+    if (tile < 0 || tile > std::numeric_limits<Engine::TileId>::max())
+    {
+        throw Engine::Errors::RuntimeMemoryError("Tile id " + std::to_string(tile) + " is out of range");
+    }
+    return (Engine::TileId)tile;
+}
+
+void Engine::Standard::Navigation::fromTilemap(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    sf::Vector2i mapSize = tilemap->getMapSize();
+    sf::Vector2f tileSize = tilemap->getTileSize();
+    // grid cells are square, so with rectangular tiles the cell has the width of the tile and tiles block every cell they overlap
+    int32_t rows = (int32_t)std::ceil(tileSize.y * (float)mapSize.y / tileSize.x);
+    scene.createNavigation(tilemap->getPosition(), sf::Vector2i(mapSize.x, rows), tileSize.x);
+    NavigationGrid &navigation = getNavigation(scene);
+    for (int32_t y = 0; y < mapSize.y; y++)
+    {
+        for (int32_t x = 0; x < mapSize.x; x++)
+        {
+            if (tilemap->isCellSolid(sf::Vector2i(x, y)))
+            {
+                sf::Vector2f position = tilemap->getPosition() + sf::Vector2f((float)x * tileSize.x, (float)y * tileSize.y);
+                navigation.setAreaBlocked(sf::FloatRect(position, tileSize), true);
+            }
+        }
+    }
+}
+
+void Engine::Standard::Tilemap::create(Scene &scene)
+{
+    VectorType tileSize = scene.popFromStackAsType<VectorType>("Expected vector as tile size");
+    VectorType mapSize = scene.popFromStackAsType<VectorType>("Expected vector as map size");
+    std::string tileset(scene.popFromStackAsType<StringObject *>("Expected tileset name")->getString());
+    std::string name(scene.popFromStackAsType<StringObject *>("Expected object name")->getString());
+    if (ContentManager::getInstance().getAnimationAsset(tileset) == nullptr)
+    {
+        throw Errors::RuntimeMemoryError("No sprite asset named '" + tileset + "' to use as tileset");
+    }
+    if (tileSize.x <= 0.f || tileSize.y <= 0.f || mapSize.x < 0.f || mapSize.y < 0.f)
+    {
+        throw Errors::RuntimeMemoryError("Tilemap must have positive tile size and non negative amount of tiles");
+    }
+    scene.pushToStack(scene.createObject<TilemapObject>(TypeManager::getInstance().getType("Tilemap"), name, tileset, sf::Vector2i((int32_t)mapSize.x, (int32_t)mapSize.y), tileSize)->getHandle());
+}
+
+void Engine::Standard::Tilemap::getTile(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    scene.pushToStack((IntType)tilemap->getTile(popCell(scene)));
+}
+
+void Engine::Standard::Tilemap::setTile(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    TileId tile = popTileId(scene);
+    tilemap->setTile(popCell(scene), tile);
+}
+
+void Engine::Standard::Tilemap::getTileAtPosition(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    scene.pushToStack((IntType)tilemap->getTile(tilemap->getCell(scene.popFromStackAsType<VectorType>("Expected vector as position"))));
+}
+
+void Engine::Standard::Tilemap::getCellAtPosition(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    sf::Vector2i cell = tilemap->getCell(scene.popFromStackAsType<VectorType>("Expected vector as position"));
+    scene.pushToStack(VectorType((float)cell.x, (float)cell.y));
+}
+
+void Engine::Standard::Tilemap::setTileSolid(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    bool solid = scene.popFromStackAsType<bool>("Expected bool");
+    tilemap->setTileSolid(popTileId(scene), solid);
+}
+
+void Engine::Standard::Tilemap::isAreaSolid(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    VectorType size = scene.popFromStackAsType<VectorType>("Expected vector as area size");
+    VectorType position = scene.popFromStackAsType<VectorType>("Expected vector as area position");
+    scene.pushToStack(tilemap->isAreaSolid(sf::FloatRect(position, size)));
+}
+
+void Engine::Standard::Tilemap::collides(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    scene.pushToStack(tilemap->isAreaSolid(popUpdatedObject(scene)->getBounds()));
+}
+
+void Engine::Standard::Tilemap::moveAndCollide(Scene &scene)
+{
+    TilemapObject *tilemap = popTilemap(scene);
+    VectorType motion = scene.popFromStackAsType<VectorType>("Expected vector as motion");
+    GameObject *obj = popUpdatedObject(scene);
+    sf::Vector2f allowed = tilemap->sweep(obj->getBounds(), motion);
+    obj->setPosition(obj->getPosition() + allowed);
+    scene.pushToStack(allowed);
+}
+
+/// @brief Get particle emitter from the top of the stack
+static Engine::ParticleEmitterObject *popEmitter(Engine::Scene &scene)
+{
+    if (Engine::ParticleEmitterObject *emitter = dynamic_cast<Engine::ParticleEmitterObject *>(popUpdatedObject(scene)); emitter != nullptr)
+    {
+        return emitter;
+    }
+    throw Engine::Errors::RuntimeMemoryError("Expected particle emitter on stack but got wrong type");
+}
+
+void Engine::Standard::Particles::create(Scene &scene)
+{
+    std::string effect(scene.popFromStackAsType<StringObject *>("Expected particle effect name")->getString());
+    std::string name(scene.popFromStackAsType<StringObject *>("Expected object name")->getString());
+    if (ContentManager::getInstance().getParticleAsset(effect) == nullptr)
+    {
+        throw Errors::RuntimeMemoryError("No particle effect asset named '" + effect + "'");
+    }
+    scene.pushToStack(scene.createObject<ParticleEmitterObject>(TypeManager::getInstance().getType("ParticleEmitter"), name, effect)->getHandle());
+}
+
+void Engine::Standard::Particles::emit(Scene &scene)
+{
+    popEmitter(scene)->emit();
+}
+
+void Engine::Standard::Particles::burst(Scene &scene)
+{
+    ParticleEmitterObject *emitter = popEmitter(scene);
+    IntType count = scene.popFromStackAsType<IntType>("Expected int as particle count");
+    if (count < 0)
+    {
+        throw Errors::RuntimeMemoryError("Particle count can not be negative");
+    }
+    emitter->burst((size_t)count);
+}
+
+void Engine::Standard::Particles::stop(Scene &scene)
+{
+    popEmitter(scene)->stop();
+}
+
+void Engine::Standard::Particles::getCount(Scene &scene)
+{
+    scene.pushToStack((IntType)popEmitter(scene)->getParticleCount());
+}
+
+/// @brief Pop method target and delay of a timer and start it
+static void scheduleTimer(Engine::Scene &scene, bool repeating)
+{
+    float delay = popNumber(scene, "Expected number as timer delay");
+    std::string method(scene.popFromStackAsType<Engine::StringObject *>("Expected method name")->getString());
+    Engine::GameObject *obj = popUpdatedObject(scene);
+    if (!std::isfinite(delay))
+    {
+        throw Engine::Errors::RuntimeMemoryError("Timer delay must be a finite number");
+    }
+    if (delay < 0.f)
+    {
+        throw Engine::Errors::RuntimeMemoryError("Timer delay can not be negative");
+    }
+    if (!obj->getType()->hasMethod(method))
+    {
+        throw Engine::Errors::RuntimeMemoryError("Type '" + obj->getType()->getName() + "' has no method named '" + method + "'");
+    }
+    if (repeating && delay <= 0.f)
+    {
+        throw Engine::Errors::RuntimeMemoryError("Timer interval must be greater than zero");
+    }
+    Engine::TimerWheel::TimerId id = scene.getTimers().schedule(delay, repeating ? delay : 0.f, obj->getHandle(), method);
+    scene.pushToStack((Engine::IntType)id);
+}
+
+void Engine::Standard::Timer::callAfter(Scene &scene)
+{
+    scheduleTimer(scene, false);
+}
+
+void Engine::Standard::Timer::callEvery(Scene &scene)
+{
+    scheduleTimer(scene, true);
+}
+
+void Engine::Standard::Timer::cancel(Scene &scene)
+{
+    IntType id = scene.popFromStackAsType<IntType>("Expected int as timer handle");
+    scene.pushToStack(scene.getTimers().cancel((TimerWheel::TimerId)id));
+}
+
+void Engine::Standard::Timer::isActive(Scene &scene)
+{
+    IntType id = scene.popFromStackAsType<IntType>("Expected int as timer handle");
+    scene.pushToStack(scene.getTimers().isActive((TimerWheel::TimerId)id));
+}
+
+void Engine::Standard::Timer::getActiveCount(Scene &scene)
+{
+    scene.pushToStack((IntType)scene.getTimers().getActiveCount());
+}
+
+/// @brief Pop duration and easing of a tween, which every tween expects on top of the stack
+static std::pair<float, Engine::Easing> popTweenTiming(Engine::Scene &scene)
+{
+    float duration = popNumber(scene, "Expected number as tween duration");
+    std::string name(scene.popFromStackAsType<Engine::StringObject *>("Expected easing name")->getString());
+    std::optional<Engine::Easing> easing = Engine::getEasingByName(name);
+    if (!easing.has_value())
+    {
+        throw Engine::Errors::RuntimeMemoryError("Unknown easing '" + name + "'");
+    }
+    if (duration < 0.f)
+    {
+        throw Engine::Errors::RuntimeMemoryError("Tween duration can not be negative");
+    }
+    return {duration, easing.value()};
+}
+
+void Engine::Standard::Tween::move(Scene &scene)
+{
+    auto [duration, easing] = popTweenTiming(scene);
+    VectorType target = scene.popFromStackAsType<VectorType>("Expected vector as target position");
+    GameObject *obj = popUpdatedObject(scene);
+    TweenSystem::TweenId id = scene.getTweens().start(TweenTarget{obj->getHandle(), TweenProperty::Position}, obj->getPosition(), target, duration, easing);
+    scene.pushToStack((IntType)id);
+}
+
+void Engine::Standard::Tween::resize(Scene &scene)
+{
+    auto [duration, easing] = popTweenTiming(scene);
+    VectorType target = scene.popFromStackAsType<VectorType>("Expected vector as target size");
+    GameObject *obj = popUpdatedObject(scene);
+    TweenSystem::TweenId id = scene.getTweens().start(TweenTarget{obj->getHandle(), TweenProperty::Size}, obj->getSize(), target, duration, easing);
+    scene.pushToStack((IntType)id);
+}
+
+void Engine::Standard::Tween::tweenField(Scene &scene)
+{
+    auto [duration, easing] = popTweenTiming(scene);
+    float target = popNumber(scene, "Expected number as target field value");
+    std::string name(scene.popFromStackAsType<StringObject *>("Expected field name")->getString());
+    GameObject *obj = popUpdatedObject(scene);
+    std::optional<Value> current = obj->getFieldValue(name);
+    if (!current.has_value() || (current->index() != ValueType::Float && current->index() != ValueType::Integer))
+    {
+        throw Errors::RuntimeMemoryError("Object has no numeric field named '" + name + "'");
+    }
+    bool isInt = current->index() == ValueType::Integer;
+    float start = isInt ? (float)std::get<IntType>(current.value()) : (float)std::get<FloatType>(current.value());
+    TweenTarget tweenTarget{obj->getHandle(), isInt ? TweenProperty::IntField : TweenProperty::FloatField, scene.getTweens().getFieldIndex(name)};
+    TweenSystem::TweenId id = scene.getTweens().start(tweenTarget, sf::Vector2f(start, 0.f), sf::Vector2f(target, 0.f), duration, easing);
+    scene.pushToStack((IntType)id);
+}
+
+void Engine::Standard::Tween::fontSize(Scene &scene)
+{
+    auto [duration, easing] = popTweenTiming(scene);
+    float target = popNumber(scene, "Expected number as target font size");
+    TextObject *txt = dynamic_cast<TextObject *>(popUpdatedObject(scene));
+    if (txt == nullptr)
+    {
+        throw Errors::RuntimeMemoryError("Expected label on stack but got wrong type");
+    }
+    TweenSystem::TweenId id = scene.getTweens().start(TweenTarget{txt->getHandle(), TweenProperty::FontSize}, sf::Vector2f((float)txt->getFontSize(), 0.f), sf::Vector2f(target, 0.f), duration, easing);
+    scene.pushToStack((IntType)id);
+}
+
+void Engine::Standard::Tween::stop(Scene &scene)
+{
+    IntType id = scene.popFromStackAsType<IntType>("Expected int as tween handle");
+    scene.pushToStack(scene.getTweens().stop((TweenSystem::TweenId)id));
+}
+
+void Engine::Standard::Tween::stopObject(Scene &scene)
+{
+    scene.getTweens().stopObject(popUpdatedObject(scene)->getHandle());
+}
+
+void Engine::Standard::Tween::isActive(Scene &scene)
+{
+    IntType id = scene.popFromStackAsType<IntType>("Expected int as tween handle");
+    scene.pushToStack(scene.getTweens().isActive((TweenSystem::TweenId)id));
+}
+
+void Engine::Standard::Tween::getActiveCount(Scene &scene)
+{
+    scene.pushToStack((IntType)scene.getTweens().getCount());
+}
@@ -41,4 +41,321 @@ namespace Engine::Standard
 
         void setFontSize(Scene &scene);
     }
+
+    /// @brief Mutable strings that can be grown in place without creating a new string for every append
+    namespace StringBuilder
+    {
+        /// @brief Push a new empty builder
+        void create(Scene &scene);
+
+        /// @brief Append string representation of a value to the builder. Expects builder on top of the stack and value below it
+        void write(Scene &scene);
+
+        /// @brief Remove all text from the builder while keeping the allocated memory
+        void clear(Scene &scene);
+
+        /// @brief Push a new string containing current text of the builder, builder can be reused afterwards
+        void build(Scene &scene);
+
+        /// @brief Push amount of characters currently stored in the builder
+        void getLength(Scene &scene);
+    }
+
+    /// @brief Arrays of ints, floats or vectors stored as native values. All methods expect the array on top of the stack and arguments below it
+    namespace TypedArray
+    {
+        void createInt(Scene &scene);
+
+        void createFloat(Scene &scene);
+
+        void createVector(Scene &scene);
+
+        /// @brief Create typed array from a regular array, element type is picked based on the first item
+        void fromArray(Scene &scene);
+
+        void toArray(Scene &scene);
+
+        void fill(Scene &scene);
+
+        void addValue(Scene &scene);
+
+        void scale(Scene &scene);
+
+        void addArray(Scene &scene);
+
+        void mulArray(Scene &scene);
+
+        void sum(Scene &scene);
+
+        void min(Scene &scene);
+
+        void max(Scene &scene);
+
+        void dot(Scene &scene);
+
+        /// @brief Limit every element to the range, expects max value right below the array and min value below it
+        void clamp(Scene &scene);
+    }
+
+    /// @brief Hash maps keyed by ints, strings or objects. All methods expect the map on top of the stack and arguments below it
+    namespace Map
+    {
+        void create(Scene &scene);
+
+        /// @brief Push value stored under the key or nil if key is not present
+        void lookup(Scene &scene);
+
+        /// @brief Store value under the key, expects key right below the map and value below it
+        void insert(Scene &scene);
+
+        void contains(Scene &scene);
+
+        /// @brief Remove key from the map, pushes true if key was present
+        void remove(Scene &scene);
+
+        void clear(Scene &scene);
+
+        /// @brief Push array containing all keys of the map
+        void keys(Scene &scene);
+
+        /// @brief Push array containing all values of the map
+        void values(Scene &scene);
+
+        void getLength(Scene &scene);
+    }
+
+    namespace Memory
+    {
+        /// @brief Push amount of bytes used by managed objects
+        void getLiveBytes(Scene &scene);
+
+        /// @brief Push highest amount of bytes ever used by managed objects
+        void getPeakBytes(Scene &scene);
+
+        /// @brief Push amount of live managed objects
+        void getObjectCount(Scene &scene);
+
+        /// @brief Push map with detailed memory usage numbers
+        void getStats(Scene &scene);
+
+        /// @brief Set budget of managed memory in bytes, zero disables the budget. Going over the budget calls `on_memory_budget_exceeded` of the scene and objects
+        void setBudget(Scene &scene);
+
+        void isOverBudget(Scene &scene);
+
+        /// @brief Set amount of managed bytes allocated before the next collection cycle starts, lower values free garbage sooner at the cost of more frequent work
+        void setCollectionBudget(Scene &scene);
+
+        /// @brief Set max amount of objects freed at a single safe point, lower values make pauses shorter but cycles longer
+        void setCollectionSliceSize(Scene &scene);
+
+        /// @brief Set how many collection cycles pass between tracing passes that free reference cycles, zero disables them
+        void setTraceInterval(Scene &scene);
+
+        /// @brief Set whether local variables are left out of reference counting and scanned as roots at safe points instead, which is the default
+        void setDeferredVariables(Scene &scene);
+
+        void areVariablesDeferred(Scene &scene);
+
+        /// @brief Print memory usage report to the standard output
+        void dump(Scene &scene);
+
+        /// @brief Write json snapshot of all managed objects to the file with the path given on the stack
+        void writeHeapSnapshot(Scene &scene);
+
+        /// @brief Remember current state of the heap to compare against later
+        void markHeap(Scene &scene);
+
+        /// @brief Write json difference between the marked heap and current heap to the file with the path given on the stack
+        void writeHeapDiff(Scene &scene);
+    }
+
+    /// @brief Control over how often objects are updated. Methods working with a single object expect the object on top of the stack and arguments below it,
+    /// methods working with types expect the name of the type instead
+    namespace Updates
+    {
+        void setAlways(Scene &scene);
+
+        /// @brief Update object once every N frames
+        void setInterval(Scene &scene);
+
+        /// @brief Update object only while it's inside the update region extended by the given margin
+        void setRegionMargin(Scene &scene);
+
+        /// @brief Put object to sleep until woken by an event or `wake`
+        void sleep(Scene &scene);
+
+        /// @brief Put object to sleep for the given amount of seconds
+        void sleepFor(Scene &scene);
+
+        void wake(Scene &scene);
+
+        void isSleeping(Scene &scene);
+
+        /// @brief Set update region of the scene, expects position on top of the stack and size below it
+        void setRegion(Scene &scene);
+
+        /// @brief Remove update region, objects using region mode will be updated every frame
+        void clearRegion(Scene &scene);
+
+        void setTypeAlways(Scene &scene);
+
+        void setTypeInterval(Scene &scene);
+
+        void setTypeRegionMargin(Scene &scene);
+
+        /// @brief Push amount of objects that ran their update during the last frame
+        void getUpdatedCount(Scene &scene);
+    }
+
+    namespace Physics
+    {
+        void setGravity(Scene &scene);
+
+        void getGravity(Scene &scene);
+
+        /// @brief Change velocity of the body of the object on top of the stack by the impulse below it divided by the mass of the body
+        void applyImpulse(Scene &scene);
+
+        /// @brief Replace shape of the body of the object on top of the stack with a convex polygon.
+        /// Expects array of vertices below the object, vertices are relative to the position of the object
+        void setPolygon(Scene &scene);
+
+        void isSleeping(Scene &scene);
+
+        void wake(Scene &scene);
+
+        /// @brief Push amount of bodies that were simulated during the last step
+        void getAwakeCount(Scene &scene);
+
+        void getContactCount(Scene &scene);
+    }
+    /// @brief Grid based path finding. Positions are given in world coordinates and paths are arrays of centers of the cells on the way.
+    /// Grid has to be created with `create` before any other method is used
+    namespace Navigation
+    {
+        /// @brief Create grid where every cell is walkable, expects cell size on top of the stack, amount of cells along each axis below it and the position of the top left corner below that
+        void create(Scene &scene);
+
+        /// @brief Change walkability of the cell containing the position, expects bool on top of the stack and the position below it
+        void setBlocked(Scene &scene);
+
+        /// @brief Change walkability of every cell overlapping the area, expects bool on top of the stack, size below it and position below that
+        void setAreaBlocked(Scene &scene);
+
+        void isBlocked(Scene &scene);
+
+        /// @brief Block every cell covered by an object of the type with the given name
+        void blockType(Scene &scene);
+
+        /// @brief Push path found with A*, expects end of the path on top of the stack and start below it. Path is empty if end can't be reached
+        void findPath(Scene &scene);
+
+        /// @brief Same as `find_path` but uses jump point search, which is faster on open maps
+        void findPathJumpPoint(Scene &scene);
+
+        /// @brief Push direction towards the next cell on the shortest path to the target, expects position on top of the stack and target below it.
+        /// Distances to the target are shared by every object going to the same cell
+        void getFlowDirection(Scene &scene);
+
+        /// @brief Search for path on the worker thread and pass it to `on_path_found` of the object once it's ready.
+        /// Expects object on top of the stack, end of the path below it and start below that
+        void requestPath(Scene &scene);
+
+        /// @brief Create grid covering the tilemap on top of the stack with one cell per tile, cells under solid tiles are blocked
+        void fromTilemap(Scene &scene);
+    }
+    /// @brief Access to tiles of tilemap objects. Cells are vectors with whole numbers, every method expects the tilemap on top of the stack
+    namespace Tilemap
+    {
+        /// @brief Create empty tilemap, expects tile size on top of the stack, amount of tiles along each axis below it, name of the tileset sprite below that and object name at the bottom
+        void create(Scene &scene);
+
+        /// @brief Push id of the tile in the cell below the tilemap, empty cells are zero
+        void getTile(Scene &scene);
+
+        /// @brief Change tile, expects tile id below the tilemap and cell below that
+        void setTile(Scene &scene);
+
+        /// @brief Push id of the tile under the world position below the tilemap
+        void getTileAtPosition(Scene &scene);
+
+        /// @brief Push cell that contains the world position below the tilemap
+        void getCellAtPosition(Scene &scene);
+
+        /// @brief Change if objects collide with the tile, expects bool below the tilemap and tile id below that
+        void setTileSolid(Scene &scene);
+
+        /// @brief Check if any solid tile overlaps the area, expects size below the tilemap and position below that
+        void isAreaSolid(Scene &scene);
+
+        /// @brief Check if the object below the tilemap overlaps any solid tile
+        void collides(Scene &scene);
+
+        /// @brief Move object as far as it can go without entering solid tiles, sliding along them. Expects motion below the tilemap and object below that.
+        /// Pushes the movement that was actually done
+        void moveAndCollide(Scene &scene);
+    }
+    /// @brief Particle emitters described by particle effect assets. Every method except `create` expects the emitter on top of the stack
+    namespace Particles
+    {
+        /// @brief Create emitter that is not emitting yet, expects effect asset name on top of the stack and object name below it
+        void create(Scene &scene);
+
+        /// @brief Start spawning particles continuously
+        void emit(Scene &scene);
+
+        /// @brief Spawn the amount of particles given below the emitter at once
+        void burst(Scene &scene);
+
+        /// @brief Stop spawning particles, already spawned particles live out their lifetime
+        void stop(Scene &scene);
+
+        /// @brief Push amount of alive particles
+        void getCount(Scene &scene);
+    }
+    /// @brief Calls of object methods after a delay. Methods are called with no arguments and timers are identified by int handles
+    namespace Timer
+    {
+        /// @brief Call method once after a delay, expects delay in seconds on top of the stack, method name below it and object below that. Pushes timer handle
+        void callAfter(Scene &scene);
+
+        /// @brief Call method repeatedly, expects interval in seconds on top of the stack, method name below it and object below that. Pushes timer handle.
+        /// Calls that were missed during a long frame are skipped
+        void callEvery(Scene &scene);
+
+        /// @brief Stop the timer with the handle on top of the stack, pushes true if timer was still waiting
+        void cancel(Scene &scene);
+
+        void isActive(Scene &scene);
+
+        void getActiveCount(Scene &scene);
+    }
+    /// @brief Animation of object properties from their current value to a target value. Tweens are started with duration in seconds on top of the stack and easing name below it,
+    /// they push an int handle and call `on_tween_finished` of the object with that handle once they reach their end.
+    /// Starting a tween stops the tween that was changing the same property of the same object
+    namespace Tween
+    {
+        /// @brief Tween position, expects target position below easing and object below that
+        void move(Scene &scene);
+
+        /// @brief Tween size, expects target size below easing and object below that
+        void resize(Scene &scene);
+
+        /// @brief Tween numeric field, expects target value below easing, field name below it and object below that. Int fields keep holding ints
+        void tweenField(Scene &scene);
+
+        /// @brief Tween font size of a label, expects target size below easing and label below that
+        void fontSize(Scene &scene);
+
+        /// @brief Stop the tween with the handle on top of the stack without finishing it, pushes true if tween was still running
+        void stop(Scene &scene);
+
+        /// @brief Stop every tween of the object on top of the stack without finishing them
+        void stopObject(Scene &scene);
+
+        void isActive(Scene &scene);
+
+        void getActiveCount(Scene &scene);
+    }
 } // namespace Engine::Standard
@@ -0,0 +1,210 @@
+#include "TimerWheel.hpp"
+#include <cmath>
+#include <algorithm>
+
+Engine::TimerWheel::TimerId Engine::TimerWheel::schedule(float delay, float interval, ObjectHandle object, std::string const &method)
+{
+    uint32_t index;
+    if (m_freeTimers.empty())
+    {
+        index = (uint32_t)m_timers.size();
+        m_timers.emplace_back();
+    }
+    else
+    {
+        index = m_freeTimers.back();
+        m_freeTimers.pop_back();
+    }
+    Timer &timer = m_timers[index];
+    // delays are rounded up so that timers are never called early, and timers with no delay still wait for the next advance
+    timer.expiry = m_now + std::max<uint64_t>(toTicks(delay), 1);
+    timer.interval = interval > 0.f ? std::max<uint64_t>(toTicks(interval), 1) : 0;
+    timer.sequence = m_nextSequence++;
+    timer.target = TimerTarget{object, method};
+    timer.used = true;
+    m_activeCount++;
+    insert(index);
+    return getId(index);
+}
+
+uint64_t Engine::TimerWheel::toTicks(float time)
+{
+    // limits are applied before the cast since casting a value outside of the range is undefined, written so that NaN fails both checks
+    float ticks = std::ceil(time / TickLength);
+    if (!(ticks > 0.f))
+    {
+        return 0;
+    }
+    // times beyond the reach of the wheels are fine, such timers are parked in the outermost wheel until they come closer
+    if (!(ticks < (float)MaxTicks))
+    {
+        return MaxTicks;
+    }
+    return (uint64_t)ticks;
+}
+
+bool Engine::TimerWheel::cancel(TimerId id)
+{
+    if (getTimer(id) == nullptr)
+    {
+        return false;
+    }
+    release((uint32_t)id);
+    return true;
+}
+
+bool Engine::TimerWheel::isActive(TimerId id) const
+{
+    return getTimer(id) != nullptr;
+}
+
+Engine::TimerWheel::Timer *Engine::TimerWheel::getTimer(TimerId id)
+{
+    uint32_t index = (uint32_t)id;
+    if (index >= m_timers.size() || !m_timers[index].used || m_timers[index].generation != (uint32_t)(id >> 32))
+    {
+        return nullptr;
+    }
+    return &m_timers[index];
+}
+
+Engine::TimerWheel::Timer const *Engine::TimerWheel::getTimer(TimerId id) const
+{
+    uint32_t index = (uint32_t)id;
+    if (index >= m_timers.size() || !m_timers[index].used || m_timers[index].generation != (uint32_t)(id >> 32))
+    {
+        return nullptr;
+    }
+    return &m_timers[index];
+}
+
+void Engine::TimerWheel::release(uint32_t index)
+{
+    Timer &timer = m_timers[index];
+    // changing generation makes every slot entry and id of the timer stale
+    timer.generation++;
+    timer.used = false;
+    timer.target.method.clear();
+    m_freeTimers.push_back(index);
+    m_activeCount--;
+}
+
+void Engine::TimerWheel::insert(uint32_t index)
+{
+    Timer const &timer = m_timers[index];
+    // slot of a wheel is picked by the expiry alone, so the timer is found once the current tick reaches the start of that slot.
+    // innermost wheel that can reach the expiry within a single turn is used
+    uint32_t wheel = WheelCount - 1;
+    uint64_t slot = (m_now >> (SlotBits * wheel)) + SlotCount - 1;
+    for (uint32_t i = 0; i < WheelCount; i++)
+    {
+        uint64_t expirySlot = timer.expiry >> (SlotBits * i);
+        if (expirySlot - (m_now >> (SlotBits * i)) < SlotCount)
+        {
+            wheel = i;
+            slot = expirySlot;
+            break;
+        }
+    }
+    // timers further away than all wheels can reach wait in the last slot of the outermost wheel and get placed again once it comes up
+    slot &= SlotCount - 1;
+    m_slots[wheel][slot].push_back(SlotEntry{index, timer.generation});
+    m_occupied[wheel] |= (uint64_t)1 << slot;
+}
+
+void Engine::TimerWheel::cascade(uint32_t wheel)
+{
+    uint64_t slot = (m_now >> (SlotBits * wheel)) & (SlotCount - 1);
+    if ((m_occupied[wheel] & ((uint64_t)1 << slot)) == 0)
+    {
+        return;
+    }
+    // entries are swapped out since timers are placed into other slots while the slot is processed, both vectors keep their capacity
+    m_slotEntries.swap(m_slots[wheel][slot]);
+    m_occupied[wheel] &= ~((uint64_t)1 << slot);
+    for (SlotEntry const &entry : m_slotEntries)
+    {
+        if (m_timers[entry.index].used && m_timers[entry.index].generation == entry.generation)
+        {
+            insert(entry.index);
+        }
+    }
+    m_slotEntries.clear();
+}
+
+void Engine::TimerWheel::expire(std::vector<TimerId> &expired)
+{
+    uint64_t slot = m_now & (SlotCount - 1);
+    if ((m_occupied[0] & ((uint64_t)1 << slot)) == 0)
+    {
+        return;
+    }
+    m_slotEntries.swap(m_slots[0][slot]);
+    m_occupied[0] &= ~((uint64_t)1 << slot);
+    size_t first = expired.size();
+    for (SlotEntry const &entry : m_slotEntries)
+    {
+        if (m_timers[entry.index].used && m_timers[entry.index].generation == entry.generation)
+        {
+            expired.push_back(getId(entry.index));
+        }
+    }
+    m_slotEntries.clear();
+    // cascading can mix the order in which timers were added to the slot
+    std::sort(expired.begin() + first, expired.end(), [this](TimerId a, TimerId b)
+              { return m_timers[(uint32_t)a].sequence < m_timers[(uint32_t)b].sequence; });
+}
+
+void Engine::TimerWheel::advance(float delta, std::vector<TimerId> &expired)
+{
+    expired.clear();
+    m_pendingTime += delta;
+    uint64_t ticks = (uint64_t)(m_pendingTime / TickLength);
+    m_pendingTime -= (double)ticks * TickLength;
+    uint64_t target = m_now + ticks;
+    if (m_activeCount == 0)
+    {
+        m_now = target;
+        return;
+    }
+    while (m_now < target)
+    {
+        m_now++;
+        // outer wheels are cascaded first since their timers can land in the slots of the inner wheels that start on the same tick
+        for (uint32_t wheel = WheelCount - 1; wheel > 0; wheel--)
+        {
+            if ((m_now & (((uint64_t)1 << (SlotBits * wheel)) - 1)) == 0)
+            {
+                cascade(wheel);
+            }
+        }
+        expire(expired);
+    }
+    for (TimerId id : expired)
+    {
+        Timer &timer = m_timers[(uint32_t)id];
+        if (timer.interval == 0)
+        {
+            continue;
+        }
+        // repeating timers are only placed again once time stops moving, so calls that were missed during a long frame are skipped instead of being made all at once
+        timer.expiry += ((target - timer.expiry) / timer.interval + 1) * timer.interval;
+        insert((uint32_t)id);
+    }
+}
+
+std::optional<Engine::TimerTarget> Engine::TimerWheel::fire(TimerId id)
+{
+    Timer *timer = getTimer(id);
+    if (timer == nullptr)
+    {
+        return {};
+    }
+    if (timer->interval != 0)
+    {
+        return timer->target;
+    }
+    TimerTarget target = std::move(timer->target);
+    release((uint32_t)id);
+    return target;
+}
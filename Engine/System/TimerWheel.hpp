@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include "../Object/ObjectHandle.hpp"
+
+namespace Engine
+{
+    /// @brief Method of an object that a timer calls once it expires
+    struct TimerTarget
+    {
+        ObjectHandle object;
+        std::string method;
+    };
+
+    /// @brief Hierarchical timer wheel that calls object methods after a delay.
+    /// Time is split into ticks of one millisecond and timers are put into slots of several wheels, where each wheel has slots 64 times longer than the previous one.
+    /// Timers in the slots of the outer wheels are only moved closer once their slot comes up, so waiting timers cost nothing and advancing time only looks at slots that are due
+    class TimerWheel
+    {
+    public:
+        /// @brief Identifier of a timer made from its index and generation, so that ids of finished timers never match new timers
+        using TimerId = uint64_t;
+
+        explicit TimerWheel() = default;
+
+        /// @brief Start a timer
+        /// @param delay Time until the first call in seconds, timer never expires during the same advance it was created in
+        /// @param interval Time between repeated calls in seconds or 0 if timer should only be called once
+        /// @return Id used to cancel the timer
+        TimerId schedule(float delay, float interval, ObjectHandle object, std::string const &method);
+
+        /// @brief Stop the timer from being called
+        /// @return True if timer was still waiting to be called
+        bool cancel(TimerId id);
+
+        bool isActive(TimerId id) const;
+
+        size_t getActiveCount() const { return m_activeCount; }
+
+        /// @brief Move time forward and collect every timer that expired
+        /// @param expired Receives ids of expired timers in the order they expired. Repeating timers are already rescheduled by the time they are collected
+        void advance(float delta, std::vector<TimerId> &expired);
+
+        /// @brief Get target of the expired timer right before calling it. One time timers are released at this point
+        /// @return Target of the timer or nothing if timer was cancelled after it expired
+        std::optional<TimerTarget> fire(TimerId id);
+
+        static constexpr float TickLength = 0.001f;
+
+    private:
+        static constexpr uint32_t SlotBits = 6;
+        static constexpr uint32_t SlotCount = 1 << SlotBits;
+        static constexpr uint32_t WheelCount = 4;
+        /// @brief Longest time in ticks a timer can wait, far past anything a scene runs for but low enough that adding it to the current tick never overflows
+        static constexpr uint64_t MaxTicks = (uint64_t)1 << 62;
+
+        struct Timer
+        {
+            /// @brief Tick at which the timer expires
+            uint64_t expiry;
+            /// @brief Ticks between calls, 0 for timers that are called once
+            uint64_t interval;
+            /// @brief Order in which timers were created, used to call timers expiring on the same tick in a stable order
+            uint64_t sequence;
+            TimerTarget target;
+            uint32_t generation = 0;
+            bool used = false;
+        };
+
+        /// @brief Reference to a timer stored in a slot. Cancelled timers are not removed from slots, their entries are skipped once the slot comes up
+        struct SlotEntry
+        {
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        /// @brief Convert time in seconds to ticks rounded up and limited to `MaxTicks`
+        static uint64_t toTicks(float time);
+
+        TimerId getId(uint32_t index) const { return ((TimerId)m_timers[index].generation << 32) | index; }
+
+        /// @brief Get timer that the id refers to or null if timer no longer exists
+        Timer *getTimer(TimerId id);
+
+        Timer const *getTimer(TimerId id) const;
+
+        void release(uint32_t index);
+
+        /// @brief Put timer into the slot of the innermost wheel that can hold its expiry relative to the current tick
+        void insert(uint32_t index);
+
+        /// @brief Move timers of the slot of an outer wheel that starts at the current tick into inner wheels
+        void cascade(uint32_t wheel);
+
+        /// @brief Collect timers of the innermost wheel slot of the current tick
+        void expire(std::vector<TimerId> &expired);
+
+        std::vector<Timer> m_timers;
+        std::vector<uint32_t> m_freeTimers;
+        std::array<std::array<std::vector<SlotEntry>, SlotCount>, WheelCount> m_slots;
+        /// @brief Entries of the slot that is being processed
+        std::vector<SlotEntry> m_slotEntries;
+        /// @brief Bit for every slot of each wheel that has any entries
+        std::array<uint64_t, WheelCount> m_occupied = {};
+        /// @brief Amount of ticks passed since the wheel was created
+        uint64_t m_now = 0;
+        /// @brief Time that was not enough to make a full tick
+        double m_pendingTime = 0.0;
+        uint64_t m_nextSequence = 0;
+        size_t m_activeCount = 0;
+    };
+}
@@ -77,6 +77,196 @@ Engine::TypeManager::TypeManager()
                                              {"set_text", Standard::Label::setText},
                                              {"get_text", Standard::Label::getText},
                                              {"set_text_size", Standard::Label::setFontSize}}));
+
+    addType(std::make_unique<ObjectType>("StringBuilder",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"create", Standard::StringBuilder::create},
+                                             {"write", Standard::StringBuilder::write},
+                                             {"clear", Standard::StringBuilder::clear},
+                                             {"build", Standard::StringBuilder::build},
+                                             {"length", Standard::StringBuilder::getLength}}));
+
+    addType(std::make_unique<ObjectType>("TypedArray",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"create_int", Standard::TypedArray::createInt},
+                                             {"create_float", Standard::TypedArray::createFloat},
+                                             {"create_vector", Standard::TypedArray::createVector},
+                                             {"from_array", Standard::TypedArray::fromArray},
+                                             {"to_array", Standard::TypedArray::toArray},
+                                             {"fill", Standard::TypedArray::fill},
+                                             {"add_value", Standard::TypedArray::addValue},
+                                             {"scale", Standard::TypedArray::scale},
+                                             {"add_array", Standard::TypedArray::addArray},
+                                             {"mul_array", Standard::TypedArray::mulArray},
+                                             {"sum", Standard::TypedArray::sum},
+                                             {"min", Standard::TypedArray::min},
+                                             {"max", Standard::TypedArray::max},
+                                             {"dot", Standard::TypedArray::dot},
+                                             {"clamp", Standard::TypedArray::clamp}}));
+
+    addType(std::make_unique<ObjectType>("Map",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"create", Standard::Map::create},
+                                             {"lookup", Standard::Map::lookup},
+                                             {"insert", Standard::Map::insert},
+                                             {"contains", Standard::Map::contains},
+                                             {"remove", Standard::Map::remove},
+                                             {"clear", Standard::Map::clear},
+                                             {"keys", Standard::Map::keys},
+                                             {"values", Standard::Map::values},
+                                             {"length", Standard::Map::getLength}}));
+
+    addType(std::make_unique<ObjectType>("Memory",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"live_bytes", Standard::Memory::getLiveBytes},
+                                             {"peak_bytes", Standard::Memory::getPeakBytes},
+                                             {"object_count", Standard::Memory::getObjectCount},
+                                             {"stats", Standard::Memory::getStats},
+                                             {"set_budget", Standard::Memory::setBudget},
+                                             {"is_over_budget", Standard::Memory::isOverBudget},
+                                             {"set_collection_budget", Standard::Memory::setCollectionBudget},
+                                             {"set_collection_slice_size", Standard::Memory::setCollectionSliceSize},
+                                             {"set_trace_interval", Standard::Memory::setTraceInterval},
+                                             {"set_deferred_variables", Standard::Memory::setDeferredVariables},
+                                             {"are_variables_deferred", Standard::Memory::areVariablesDeferred},
+                                             {"dump", Standard::Memory::dump},
+                                             {"write_heap_snapshot", Standard::Memory::writeHeapSnapshot},
+                                             {"mark_heap", Standard::Memory::markHeap},
+                                             {"write_heap_diff", Standard::Memory::writeHeapDiff}}));
+
+    addType(std::make_unique<ObjectType>("UpdatePolicy",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"set_always", Standard::Updates::setAlways},
+                                             {"set_interval", Standard::Updates::setInterval},
+                                             {"set_region_margin", Standard::Updates::setRegionMargin},
+                                             {"sleep", Standard::Updates::sleep},
+                                             {"sleep_for", Standard::Updates::sleepFor},
+                                             {"wake", Standard::Updates::wake},
+                                             {"is_sleeping", Standard::Updates::isSleeping},
+                                             {"set_region", Standard::Updates::setRegion},
+                                             {"clear_region", Standard::Updates::clearRegion},
+                                             {"set_type_always", Standard::Updates::setTypeAlways},
+                                             {"set_type_interval", Standard::Updates::setTypeInterval},
+                                             {"set_type_region_margin", Standard::Updates::setTypeRegionMargin},
+                                             {"updated_count", Standard::Updates::getUpdatedCount}}));
+
+    addType(std::make_unique<ObjectType>("Physics",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"set_gravity", Standard::Physics::setGravity},
+                                             {"get_gravity", Standard::Physics::getGravity},
+                                             {"apply_impulse", Standard::Physics::applyImpulse},
+                                             {"set_polygon", Standard::Physics::setPolygon},
+                                             {"is_sleeping", Standard::Physics::isSleeping},
+                                             {"wake", Standard::Physics::wake},
+                                             {"awake_count", Standard::Physics::getAwakeCount},
+                                             {"contact_count", Standard::Physics::getContactCount}}));
+
+    addType(std::make_unique<ObjectType>("Navigation",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"create", Standard::Navigation::create},
+                                             {"set_blocked", Standard::Navigation::setBlocked},
+                                             {"set_area_blocked", Standard::Navigation::setAreaBlocked},
+                                             {"is_blocked", Standard::Navigation::isBlocked},
+                                             {"block_type", Standard::Navigation::blockType},
+                                             {"find_path", Standard::Navigation::findPath},
+                                             {"find_path_jps", Standard::Navigation::findPathJumpPoint},
+                                             {"flow_direction", Standard::Navigation::getFlowDirection},
+                                             {"request_path", Standard::Navigation::requestPath},
+                                             {"from_tilemap", Standard::Navigation::fromTilemap}}));
+
+    addType(std::make_unique<ObjectType>("Tilemap",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"create", Standard::Tilemap::create},
+                                             {"get_tile", Standard::Tilemap::getTile},
+                                             {"set_tile", Standard::Tilemap::setTile},
+                                             {"tile_at_position", Standard::Tilemap::getTileAtPosition},
+                                             {"cell_at_position", Standard::Tilemap::getCellAtPosition},
+                                             {"set_tile_solid", Standard::Tilemap::setTileSolid},
+                                             {"is_area_solid", Standard::Tilemap::isAreaSolid},
+                                             {"collides", Standard::Tilemap::collides},
+                                             {"move_and_collide", Standard::Tilemap::moveAndCollide}}));
+
+    addType(std::make_unique<ObjectType>("ParticleEmitter",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"create", Standard::Particles::create},
+                                             {"emit", Standard::Particles::emit},
+                                             {"burst", Standard::Particles::burst},
+                                             {"stop", Standard::Particles::stop},
+                                             {"count", Standard::Particles::getCount}}));
+
+    addType(std::make_unique<ObjectType>("Timer",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"call_after", Standard::Timer::callAfter},
+                                             {"call_every", Standard::Timer::callEvery},
+                                             {"cancel", Standard::Timer::cancel},
+                                             {"is_active", Standard::Timer::isActive},
+                                             {"active_count", Standard::Timer::getActiveCount}}));
+
+    addType(std::make_unique<ObjectType>("Tween",
+                                         nullptr,
+                                         nullptr,
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // fields
+                                         std::unordered_map<std::string, Runnable::CodeConstantValue>(), // constants
+                                         std::unordered_map<std::string, Runnable::RunnableFunction>(),  // methods
+                                         std::unordered_map<std::string, std::function<void(Scene & scene)>>{
+                                             {"move", Standard::Tween::move},
+                                             {"resize", Standard::Tween::resize},
+                                             {"field", Standard::Tween::tweenField},
+                                             {"font_size", Standard::Tween::fontSize},
+                                             {"stop", Standard::Tween::stop},
+                                             {"stop_object", Standard::Tween::stopObject},
+                                             {"is_active", Standard::Tween::isActive},
+                                             {"active_count", Standard::Tween::getActiveCount}}));
 }
 
 Engine::ObjectType const *Engine::TypeManager::getType(std::string const &name) const
@@ -138,11 +328,11 @@ Engine::ObjectType const *Engine::TypeManager::createType(
     std::unordered_map<std::string, std::function<void(Scene &scene)>> const &nativeMethods,
     std::vector<std::string> const &strings)
 {
-    if (doesTypeWithNameExist(name))
+    if (doesTypeWithNameExist(name) || doesStructTypeWithNameExist(name))
     {
         throw TypeError("Multiple type declaration for type '" + name + "'");
     }
-    m_typeDeclarationSourceFiles[name] = sourceFile;
+    // type is created first since it checks its constants, a type that fails the check should not count as declared
     m_types.push_back(std::make_unique<ObjectType>(name,
                                                    sprite,
                                                    parentType,
@@ -151,6 +341,7 @@ Engine::ObjectType const *Engine::TypeManager::createType(
                                                    methods,   // methods
                                                    nativeMethods,
                                                    strings));
+    m_typeDeclarationSourceFiles[name] = sourceFile;
     return m_types.back().get();
 }
 
@@ -159,6 +350,29 @@ void Engine::TypeManager::addType(std::unique_ptr<ObjectType> type)
     m_types.push_back(std::move(type));
 }
 
+Engine::StructType const *Engine::TypeManager::getStructType(std::string const &name) const
+{
+    if (auto it = m_structTypes.find(name); it != m_structTypes.end())
+    {
+        return it->second.get();
+    }
+    return nullptr;
+}
+
+Engine::StructType const *Engine::TypeManager::createStructType(std::string const &name,
+                                                                std::string const &sourceFile,
+                                                                std::vector<std::string> const &fieldNames,
+                                                                std::vector<Runnable::CodeConstantValue> const &defaults,
+                                                                std::vector<std::string> const &strings)
+{
+    if (doesTypeWithNameExist(name) || doesStructTypeWithNameExist(name))
+    {
+        throw TypeError("Multiple type declaration for type '" + name + "'");
+    }
+    m_typeDeclarationSourceFiles[name] = sourceFile;
+    return (m_structTypes[name] = std::make_unique<StructType>(name, fieldNames, defaults, strings)).get();
+}
+
 const char *Engine::TypeError::what() const throw()
 {
     return m_message.c_str();
@@ -4,6 +4,7 @@
 #include <memory>
 #include <map>
 #include "Object/ObjectType.hpp"
+#include "Object/StructType.hpp"
 
 namespace Engine
 {
@@ -55,7 +56,7 @@ namespace Engine
                                            std::unordered_map<std::string, Runnable::RunnableFunction> const &methods,
                                            std::unordered_map<std::string, std::function<void(Scene &scene)>> const &nativeMethods);
 
-        /// @brief Create a new full type or throw `TypeError` if name is already in use
+        /// @brief Create a new full type or throw `TypeError` if name is already in use or constants of the type are invalid
         /// @param name Name of the type
         /// @param sourceFile Name of the file where type was declared. Used to skip recompiling types that were previously declared if same file is loaded twice,
         /// but throwing an error if multiple files have types with the same name
@@ -81,9 +82,31 @@ namespace Engine
         /// @param type 
         void addType(std::unique_ptr<ObjectType> type);
 
+        /// @brief Try getting a struct with given name
+        /// @param name Name of the struct
+        /// @return Pointer to the struct layout or null if no struct with given name exists
+        StructType const *getStructType(std::string const &name) const;
+
+        bool doesStructTypeWithNameExist(std::string const &name) const { return m_structTypes.contains(name); }
+
+        /// @brief Create a new struct or throw `TypeError` if name is already used by a type or a struct
+        /// @param name Name of the struct
+        /// @param sourceFile Name of the file where struct was declared
+        /// @param fieldNames Names of the fields in order of declaration
+        /// @param defaults Default values of the fields
+        /// @param strings Strings that are referenced by the default values
+        /// @return Pointer to the newly created struct layout
+        StructType const *createStructType(std::string const &name,
+                                           std::string const &sourceFile,
+                                           std::vector<std::string> const &fieldNames,
+                                           std::vector<Runnable::CodeConstantValue> const &defaults,
+                                           std::vector<std::string> const &strings = {});
+
     private:
         std::vector<std::unique_ptr<ObjectType>> m_types;
 
+        std::unordered_map<std::string, std::unique_ptr<StructType>> m_structTypes;
+
         /// @brief Contains information about where were types declared initially
         std::map<std::string, std::string> m_typeDeclarationSourceFiles;
     };
@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 #include "Errors.hpp"
 #include "../Engine/Content/ContentManager.hpp"
 #include "../Engine/Execution/Value.hpp"
@@ -81,6 +82,10 @@ void Project::Project::loadAsset(std::string const &path) const
         {
             Engine::ContentManager::getInstance().addFontAsset(fileData.at("name"), loadFontAsset(fileData));
         }
+        else if (fileData.at("type").get<std::string>() == "particles")
+        {
+            Engine::ContentManager::getInstance().addParticleAsset(fileData.at("name"), loadParticleAsset(fileData, path));
+        }
     }
     catch (nlohmann::json::exception e)
     {
@@ -183,6 +188,24 @@ Engine::SceneDescription Project::Project::loadScene(std::string const &path) co
                                                                                             sf::Vector2f(obj.at("position").at("x").get<float>(), obj.at("position").at("y").get<float>()),
                                                                                             startSize, props));
                 }
+                else if (type == "particles")
+                {
+                    std::string name = obj.at("name").get<std::string>();
+                    std::string effect = obj.at("effect").get<std::string>();
+                    if (Engine::ContentManager::getInstance().getParticleAsset(effect) == nullptr)
+                    {
+                        throw Errors::AssetFileError("Error in file '" + path + "': particles '" + name + "' is referencing particle effect '" + effect + "' which doesn't exist");
+                    }
+                    objects.push_back(std::make_unique<Engine::SceneDescriptionParticleEmitterObject>(name,
+                                                                                                      effect,
+                                                                                                      obj.contains("emitting") && obj.at("emitting").get<bool>(),
+                                                                                                      sf::Vector2f(obj.at("position").at("x").get<float>(), obj.at("position").at("y").get<float>()),
+                                                                                                      startSize, props));
+                }
+                else if (type == "tilemap")
+                {
+                    objects.push_back(loadTilemap(obj, props, path));
+                }
                 else
                 {
                     objects.push_back(std::make_unique<Engine::SceneDescriptionObject>(obj.at("name").get<std::string>(),
@@ -192,9 +215,27 @@ Engine::SceneDescription Project::Project::loadScene(std::string const &path) co
                                                                                        props,
                                                                                        spriteOverride));
                 }
+                if (obj.contains("update_policy"))
+                {
+                    objects.back()->setUpdatePolicy(loadUpdatePolicy(obj.at("update_policy"), path));
+                }
             }
         }
-        return Engine::SceneDescription(json.at("code").get<std::string>(), title, std::move(objects));
+        Engine::SceneDescription description(json.at("code").get<std::string>(), title, std::move(objects));
+        if (json.contains("update_policies"))
+        {
+            for (auto const &[typeName, policy] : json.at("update_policies").items())
+            {
+                description.setTypeUpdatePolicy(typeName, loadUpdatePolicy(policy, path));
+            }
+        }
+        if (json.contains("update_region"))
+        {
+            nlohmann::json const &region = json.at("update_region");
+            description.setUpdateRegion(sf::FloatRect(sf::Vector2f(region.at("x").get<float>(), region.at("y").get<float>()),
+                                                      sf::Vector2f(region.at("w").get<float>(), region.at("h").get<float>())));
+        }
+        return description;
     }
     catch (nlohmann::json::exception e)
     {
@@ -243,3 +284,160 @@ std::unique_ptr<Engine::FontAsset> Project::Project::loadFontAsset(nlohmann::jso
 {
     return std::make_unique<Engine::FontAsset>(m_rootFolder + "/" + json.at("file_path").get<std::string>());
 }
+
+/// @brief Read color stored as object with "r", "g", "b" and optional "a" fields
+static sf::Color loadColor(nlohmann::json const &json)
+{
+    return sf::Color(json.at("r").get<uint8_t>(), json.at("g").get<uint8_t>(), json.at("b").get<uint8_t>(), json.contains("a") ? json.at("a").get<uint8_t>() : 255);
+}
+
+/// @brief Read range stored as object with "min" and "max" fields or as a single number used for both
+static std::pair<float, float> loadRange(nlohmann::json const &json)
+{
+    if (json.is_number())
+    {
+        return {json.get<float>(), json.get<float>()};
+    }
+    return {json.at("min").get<float>(), json.at("max").get<float>()};
+}
+
+std::unique_ptr<Engine::ParticleEffectAsset> Project::Project::loadParticleAsset(nlohmann::json const &json, std::string const &path) const
+{
+    Engine::ParticleSettings settings;
+    settings.sprite = json.value("sprite", "");
+    settings.animation = json.value("animation", "");
+    settings.maxParticles = json.value("max_particles", settings.maxParticles);
+    settings.rate = json.value("rate", settings.rate);
+    if (json.contains("lifetime"))
+    {
+        std::tie(settings.minLifetime, settings.maxLifetime) = loadRange(json.at("lifetime"));
+    }
+    if (json.contains("speed"))
+    {
+        std::tie(settings.minSpeed, settings.maxSpeed) = loadRange(json.at("speed"));
+    }
+    settings.direction = json.value("direction", settings.direction);
+    settings.spread = json.value("spread", settings.spread);
+    if (json.contains("gravity"))
+    {
+        settings.gravity = sf::Vector2f(json.at("gravity").at("x").get<float>(), json.at("gravity").at("y").get<float>());
+    }
+    settings.drag = json.value("drag", settings.drag);
+    if (json.contains("size"))
+    {
+        settings.startSize = json.at("size").at("start").get<float>();
+        settings.endSize = json.at("size").at("end").get<float>();
+    }
+    if (json.contains("color"))
+    {
+        settings.startColor = loadColor(json.at("color").at("start"));
+        settings.endColor = loadColor(json.at("color").at("end"));
+    }
+    if (settings.minLifetime > settings.maxLifetime || settings.minSpeed > settings.maxSpeed || settings.spread < 0.f || settings.rate < 0.f || settings.drag < 0.f)
+    {
+        throw Errors::AssetFileError("Error in file '" + path + "': particle ranges must have min not larger than max and rate, spread and drag can not be negative");
+    }
+    return std::make_unique<Engine::ParticleEffectAsset>(path, settings);
+}
+
+Engine::UpdatePolicy Project::Project::loadUpdatePolicy(nlohmann::json const &json, std::string const &path) const
+{
+    Engine::UpdatePolicy policy;
+    if (json.contains("mode"))
+    {
+        std::optional<Engine::UpdateMode> mode = Engine::getUpdateModeByName(json.at("mode").get<std::string>());
+        if (!mode.has_value())
+        {
+            throw Errors::AssetFileError("Error in file '" + path + "': unknown update mode '" + json.at("mode").get<std::string>() + "'");
+        }
+        policy.mode = mode.value();
+    }
+    if (json.contains("interval") && json.contains("margin"))
+    {
+        // each setting belongs to a different mode, so having both is most likely a mistake
+        throw Errors::AssetFileError("Error in file '" + path + "': update policy can not have both 'interval' and 'margin'");
+    }
+    if (json.contains("interval"))
+    {
+        policy.interval = std::max(1u, json.at("interval").get<uint32_t>());
+    }
+    if (json.contains("margin"))
+    {
+        policy.margin = json.at("margin").get<float>();
+    }
+    if (json.contains("asleep"))
+    {
+        policy.startAsleep = json.at("asleep").get<bool>();
+    }
+    return policy;
+}
+
+std::unique_ptr<Engine::SceneDescriptionTilemapObject> Project::Project::loadTilemap(nlohmann::json const &json,
+                                                                                     std::map<std::string, Engine::SceneDescriptionPropertyValue> const &props,
+                                                                                     std::string const &path) const
+{
+    std::string name = json.at("name").get<std::string>();
+    std::string tileset = json.at("tileset").get<std::string>();
+    if (Engine::ContentManager::getInstance().getAnimationAsset(tileset) == nullptr)
+    {
+        throw Errors::AssetFileError("Error in file '" + path + "': tilemap '" + name + "' is referencing asset '" + tileset + "' which doesn't exist");
+    }
+    sf::Vector2i mapSize(json.at("columns").get<int32_t>(), json.at("rows").get<int32_t>());
+    sf::Vector2f tileSize(json.at("tile_size").at("x").get<float>(), json.at("tile_size").at("y").get<float>());
+    if (mapSize.x < 0 || mapSize.y < 0 || tileSize.x <= 0.f || tileSize.y <= 0.f)
+    {
+        throw Errors::AssetFileError("Error in file '" + path + "': tilemap '" + name + "' must have positive tile size and non negative amount of tiles");
+    }
+    size_t tileCount = (size_t)mapSize.x * mapSize.y;
+    std::vector<uint16_t> tiles;
+    tiles.reserve(tileCount);
+    nlohmann::json const &data = json.at("tiles");
+    if (json.contains("encoding") && json.at("encoding").get<std::string>() == "rle")
+    {
+        if (data.size() % 2 != 0)
+        {
+            throw Errors::AssetFileError("Error in file '" + path + "': tiles of tilemap '" + name + "' must be pairs of count and tile id");
+        }
+        for (size_t i = 0; i < data.size(); i += 2)
+        {
+            size_t count = data.at(i).get<size_t>();
+            if (count > tileCount - tiles.size())
+            {
+                throw Errors::AssetFileError("Error in file '" + path + "': tilemap '" + name + "' has more tiles than fit in the map");
+            }
+            tiles.insert(tiles.end(), count, data.at(i + 1).get<uint16_t>());
+        }
+    }
+    else if (json.contains("encoding") && json.at("encoding").get<std::string>() != "array")
+    {
+        throw Errors::AssetFileError("Error in file '" + path + "': unknown tile encoding '" + json.at("encoding").get<std::string>() + "'");
+    }
+    else
+    {
+        if (data.size() > tileCount)
+        {
+            throw Errors::AssetFileError("Error in file '" + path + "': tilemap '" + name + "' has more tiles than fit in the map");
+        }
+        for (nlohmann::json const &tile : data)
+        {
+            tiles.push_back(tile.get<uint16_t>());
+        }
+    }
+
+    std::vector<std::pair<uint16_t, bool>> solidTiles;
+    if (json.contains("passable_tiles"))
+    {
+        for (nlohmann::json const &tile : json.at("passable_tiles"))
+        {
+            solidTiles.emplace_back(tile.get<uint16_t>(), false);
+        }
+    }
+    return std::make_unique<Engine::SceneDescriptionTilemapObject>(name,
+                                                                   tileset,
+                                                                   mapSize,
+                                                                   tileSize,
+                                                                   tiles,
+                                                                   solidTiles,
+                                                                   sf::Vector2f(json.at("position").at("x").get<float>(), json.at("position").at("y").get<float>()),
+                                                                   props);
+}
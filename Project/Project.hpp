@@ -38,6 +38,22 @@ namespace Project
 
         std::unique_ptr<Engine::FontAsset> loadFontAsset(nlohmann::json const& json) const;
 
+        /// @param path Path to the asset file for error messages
+        std::unique_ptr<Engine::ParticleEffectAsset> loadParticleAsset(nlohmann::json const &json, std::string const &path) const;
+
+        /// @brief Load update policy of a type or an object from the scene file
+        /// @param json Policy data
+        /// @param path Path to the scene file for error messages
+        Engine::UpdatePolicy loadUpdatePolicy(nlohmann::json const &json, std::string const &path) const;
+
+        /// @brief Load tilemap object from the scene file. Tiles are either stored as plain array row by row
+        /// or, if encoding is set to "rle", as pairs of repeat count and tile id which keeps large empty areas small
+        /// @param json Object data
+        /// @param path Path to the scene file for error messages
+        std::unique_ptr<Engine::SceneDescriptionTilemapObject> loadTilemap(nlohmann::json const &json,
+                                                                           std::map<std::string, Engine::SceneDescriptionPropertyValue> const &props,
+                                                                           std::string const &path) const;
+
     private:
         std::string m_name;
         std::string m_mainScenePath;
@@ -126,6 +126,7 @@ int runByPath(std::string const &path)
                     scene.draw(window);
                     window.display();
                 }
+                scene.getMemoryReport().print(std::cout);
             }
             catch (Code::Errors::ParsingError e)
             {